@@ -20,6 +20,8 @@
 #include "src/Config/DEV_Config.h"
 #include "src/Config/WiFiConfig.h"
 #include "src/Config/ImageDownloader.h"
+#include "src/Config/MemProbe.h"
+#include "src/Config/Telemetry.h"
 #include "src/GUI/GUI_Paint.h"
 #include "src/Fonts/fonts.h"
 #include "src/e-Paper/EPD_7in3e.h"
@@ -41,47 +43,62 @@ void setup() {
   // Initialize serial for debugging
   Serial.begin(115200);
   delay(100);
-  
-  Serial.println("\n\nE-Paper WiFi Display Starting...");
-  Serial.println("================================");
-  Serial.printf("Free heap: %d bytes\n", ESP.getFreeHeap());
+  // Log lines are buffered in RTC memory and printed just before deep sleep
+  Log_Begin();
+  // Heap and stack watermarks at each phase boundary, uploaded with telemetry
+  MemProbe_Begin();
+
+  LOG_I("E-Paper WiFi Display Starting...");
+  LOG_I("Free heap: %d bytes", ESP.getFreeHeap());
 
   // Print wakeup cause to aid troubleshooting
   esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
-  Serial.printf("Wakeup cause: %d (0=undef, 2=timer)\n", (int)cause);
+  LOG_I("Wakeup cause: %d (0=undef, 2=timer)", (int)cause);
 
   // Initialize SPIFFS for configuration storage
   if (!initSPIFFS()) {
-    Serial.println("ERROR: Failed to initialize SPIFFS");
+    LOG_E("ERROR: Failed to initialize SPIFFS");
     displayError("SPIFFS Init Failed");
     delay(5000);
     ESP.restart();
   }
 
-  Serial.println("SPIFFS initialized");
+  LOG_I("SPIFFS initialized");
+  MemProbe_Mark("spiffs");
   delay(1000); // Give system time to settle
 
   // Try to connect to saved WiFi
-  Serial.println("\nAttempting WiFi connection...");
+  LOG_I("Attempting WiFi connection...");
   if (connectToWiFi()) {
     // WiFi connected successfully
-    Serial.println("WiFi connection successful!");
+    LOG_I("WiFi connection successful!");
+    MemProbe_Mark("wifi");
     
-    // Load server URL
-    char serverUrl[SERVER_URL_LENGTH] = {0};
-    if (!loadServerUrl(serverUrl)) {
-      Serial.println("No server URL configured. Using default.");
-      strcpy(serverUrl, DEFAULT_SERVER_URL);
+    // Load server URLs (one, or several for failover)
+    static char serverUrls[MAX_SERVER_URLS][SERVER_URL_LENGTH];
+    uint8_t serverCount = loadServerUrls(serverUrls, MAX_SERVER_URLS);
+    if (serverCount == 0) {
+      LOG_E("No server URL configured. Using default.");
+      strcpy(serverUrls[0], DEFAULT_SERVER_URL);
+      serverCount = 1;
     }
 
-    Serial.printf("Server URL: %s\n", serverUrl);
-    Serial.printf("Free heap before download: %d bytes\n", ESP.getFreeHeap());
+    const char* serverList[MAX_SERVER_URLS];
+    for (uint8_t i = 0; i < serverCount; i++) {
+      serverList[i] = serverUrls[i];
+      LOG_I("Server URL %u: %s", i + 1, serverUrls[i]);
+    }
+    LOG_I("Free heap before download: %d bytes", ESP.getFreeHeap());
 
     // Download and display image
-    if (downloadAndDisplayImage(serverUrl)) {
-      Serial.println("Image display successful!");
+    const bool displayed = downloadAndDisplayImage(serverList, serverCount);
+    MemProbe_Mark("download");
+    if (displayed) {
+      LOG_I("Image display successful!");
+      // This wake's log (and any left over from failed wakes) to the server
+      Telemetry_Upload(getServingServerUrl());
     } else {
-      Serial.println("Image download failed. Displaying error message.");
+      LOG_E("Image download failed. Displaying error message.");
       // Note: cleanupDisplay() is handled in downloadAndDisplayImage if display was initialized
       delay(1000);
       displayError("Image Download Failed");
@@ -89,13 +106,13 @@ void setup() {
     }
   } else {
     // WiFi connection failed or no credentials - show captive portal
-    Serial.println("Starting captive portal for WiFi setup...");
+    LOG_I("Starting captive portal for WiFi setup...");
     handleCaptivePortal();
     // After portal setup, the device will restart
   }
 
   // Go to sleep to save power
-  Serial.println("\nEntering deep sleep mode...");
+  LOG_I("Entering deep sleep mode...");
   goToSleep();
 }
 
@@ -112,8 +129,8 @@ void loop() {
  * Blocks until device is configured or timeout occurs
  */
 void handleCaptivePortal() {
-  Serial.println("Captive portal active. Waiting for WiFi configuration...");
-  Serial.println("Connect to 'E-Paper Setup' network and open http://192.168.1.4");
+  LOG_I("Captive portal active. Waiting for WiFi configuration...");
+  LOG_I("Connect to 'E-Paper Setup' network and open http://192.168.1.4");
   
   // Portal is started in connectToWiFi() when no credentials exist
   // Keep processing requests
@@ -125,22 +142,23 @@ void handleCaptivePortal() {
     // Print status every 30 seconds
     if (millis() - lastPrint > 30000) {
       unsigned long remaining = (portalTimeout - (millis() - startTime)) / 1000;
-      Serial.printf("Waiting for configuration... %lu seconds remaining\n", remaining);
+      LOG_I("Waiting for configuration... %lu seconds remaining", remaining);
       lastPrint = millis();
     }
 
     // Process portal requests
     processCaptivePortal();
+    Log_FlushTo(Serial);
     delay(100);
 
     // If somehow connected, exit
     if (isWiFiConnected()) {
-      Serial.println("WiFi connected via portal!");
+      LOG_I("WiFi connected via portal!");
       return;
     }
   }
 
-  Serial.println("Captive portal timeout. Restarting...");
+  LOG_I("Captive portal timeout. Restarting...");
   delay(2000);
   ESP.restart();
 }
@@ -149,24 +167,27 @@ void handleCaptivePortal() {
  * Display error message on e-paper
  */
 void displayError(const char* message) {
-  Serial.printf("Displaying error: %s\n", message);
+  LOG_E("Displaying error: %s", message);
 
   // Initialize display module if needed
-  Serial.println("Initializing display module...");
+  LOG_I("Initializing display module...");
   if (DEV_Module_Init() != 0) {
-    Serial.println("Failed to initialize display module - skipping error display");
+    LOG_E("Failed to initialize display module - skipping error display");
     return;
   }
 
   // Initialize EPD
-  Serial.println("Initializing e-Paper display...");
-  EPD_7IN3E_Init();
+  LOG_I("Initializing e-Paper display...");
+  initDisplay();
   delay(500);
 
-  // Low-RAM boards (ESP32-WROOM-32 without PSRAM) often can't allocate a full
-  // 192KB framebuffer for text rendering. Indicate error with a solid RED fill.
-  Serial.println("Clearing display to RED to indicate error...");
-  EPD_7IN3E_Clear(EPD_7IN3E_RED);
+  // With PSRAM the message is rendered into a full frame; low-RAM boards
+  // (ESP32-WROOM-32 without PSRAM) render it in 16KB bands instead. Only if
+  // not even a band fits is the error shown as a solid RED fill.
+  if (!displayMessage(message, EPD_7IN3E_RED)) {
+    LOG_E("Clearing display to RED to indicate error...");
+    clearDisplay(EPD_7IN3E_RED);
+  }
   delay(1000);
 }
 
@@ -176,21 +197,24 @@ void displayError(const char* message) {
  */
 void goToSleep() {
   // Shutdown display to save power
-  Serial.println("Shutting down e-Paper display...");
-  EPD_7IN3E_Sleep();
+  LOG_I("Shutting down e-Paper display...");
+  sleepDisplay();
   delay(500);
 
   // Disable WiFi to save power
   WiFi.disconnect(true); // true = turn off radio
   WiFi.mode(WIFI_OFF);
 
-  Serial.printf("Going to deep sleep for %d seconds...\n", SLEEP_DURATION_SECONDS);
+  // The server may ask for a different interval with the frame
+  const uint32_t sleepSeconds = getNextWakeSeconds() > 0 ? getNextWakeSeconds() : SLEEP_DURATION_SECONDS;
+  LOG_I("Going to deep sleep for %u seconds...", sleepSeconds);
+  Log_FlushTo(Serial);
   Serial.flush();
 
   // Configure timer wakeup explicitly, then enter deep sleep
   // Note: Using esp_sleep_enable_timer_wakeup + esp_deep_sleep_start()
   // is more robust across core/IDF versions than esp_deep_sleep(timeout).
-  esp_sleep_enable_timer_wakeup((uint64_t)SLEEP_DURATION_SECONDS * 1000000ULL);
+  esp_sleep_enable_timer_wakeup((uint64_t)sleepSeconds * 1000000ULL);
   esp_deep_sleep_start();
 
   // Code after this line won't execute until wake-up
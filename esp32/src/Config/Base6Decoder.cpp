@@ -0,0 +1,113 @@
+#include "FrameDecoder.h"
+#include "Debug.h"
+
+// Bytes read from the network per pass; even so pairs never straddle reads
+#define BASE6_CHUNK 1026
+
+// Base-6 digit -> panel color: 0 black, 1 white, 2 yellow, 3 red, 4 blue, 5 green.
+// Each entry holds the three pixels of one byte value (d0*36 + d1*6 + d2,
+// d0 = leftmost) as three color nibbles, d0 in bits 11..8.
+static const uint16_t kBase6Expand[216] = {
+  0x000, 0x001, 0x002, 0x003, 0x005, 0x006, 0x010, 0x011, 0x012, 0x013, 0x015, 0x016,
+  0x020, 0x021, 0x022, 0x023, 0x025, 0x026, 0x030, 0x031, 0x032, 0x033, 0x035, 0x036,
+  0x050, 0x051, 0x052, 0x053, 0x055, 0x056, 0x060, 0x061, 0x062, 0x063, 0x065, 0x066,
+  0x100, 0x101, 0x102, 0x103, 0x105, 0x106, 0x110, 0x111, 0x112, 0x113, 0x115, 0x116,
+  0x120, 0x121, 0x122, 0x123, 0x125, 0x126, 0x130, 0x131, 0x132, 0x133, 0x135, 0x136,
+  0x150, 0x151, 0x152, 0x153, 0x155, 0x156, 0x160, 0x161, 0x162, 0x163, 0x165, 0x166,
+  0x200, 0x201, 0x202, 0x203, 0x205, 0x206, 0x210, 0x211, 0x212, 0x213, 0x215, 0x216,
+  0x220, 0x221, 0x222, 0x223, 0x225, 0x226, 0x230, 0x231, 0x232, 0x233, 0x235, 0x236,
+  0x250, 0x251, 0x252, 0x253, 0x255, 0x256, 0x260, 0x261, 0x262, 0x263, 0x265, 0x266,
+  0x300, 0x301, 0x302, 0x303, 0x305, 0x306, 0x310, 0x311, 0x312, 0x313, 0x315, 0x316,
+  0x320, 0x321, 0x322, 0x323, 0x325, 0x326, 0x330, 0x331, 0x332, 0x333, 0x335, 0x336,
+  0x350, 0x351, 0x352, 0x353, 0x355, 0x356, 0x360, 0x361, 0x362, 0x363, 0x365, 0x366,
+  0x500, 0x501, 0x502, 0x503, 0x505, 0x506, 0x510, 0x511, 0x512, 0x513, 0x515, 0x516,
+  0x520, 0x521, 0x522, 0x523, 0x525, 0x526, 0x530, 0x531, 0x532, 0x533, 0x535, 0x536,
+  0x550, 0x551, 0x552, 0x553, 0x555, 0x556, 0x560, 0x561, 0x562, 0x563, 0x565, 0x566,
+  0x600, 0x601, 0x602, 0x603, 0x605, 0x606, 0x610, 0x611, 0x612, 0x613, 0x615, 0x616,
+  0x620, 0x621, 0x622, 0x623, 0x625, 0x626, 0x630, 0x631, 0x632, 0x633, 0x635, 0x636,
+  0x650, 0x651, 0x652, 0x653, 0x655, 0x656, 0x660, 0x661, 0x662, 0x663, 0x665, 0x666,
+};
+
+bool Base6Decoder_Decode(Stream& stream, UWORD width, UWORD height, FrameRowWriter writeRow) {
+  const uint32_t pixels = (uint32_t)width * height;
+  if (pixels % 6 != 0 || width % 2 != 0) {
+    // Byte pairs expand to whole output bytes only for multiples of 6 pixels
+    LOG_E("Base6: unsupported size %ux%u", width, height);
+    return false;
+  }
+
+  const uint32_t rowBytes = width / 2;
+  uint8_t* in = (uint8_t*)malloc(BASE6_CHUNK);
+  UBYTE* out = (UBYTE*)malloc(BASE6_CHUNK / 2 * 3);
+  UBYTE* row = (UBYTE*)malloc(rowBytes);
+  if (!in || !out || !row) {
+    LOG_E("Base6: out of memory");
+    free(in);
+    free(out);
+    free(row);
+    return false;
+  }
+
+  const uint32_t start = millis();
+  uint32_t expandUs = 0;
+  uint32_t left = pixels / 3;
+  uint32_t rowFill = 0;
+  UWORD rows = 0;
+  bool ok = true;
+
+  while (left > 0 && ok) {
+    const uint32_t want = left < BASE6_CHUNK ? left : BASE6_CHUNK;
+    if (stream.readBytes((char*)in, want) != want) {
+      LOG_E("Base6: stream ended with %u bytes left", left);
+      ok = false;
+      break;
+    }
+    left -= want;
+
+    // Two bytes = six pixels = three packed output bytes
+    const uint32_t t0 = micros();
+    UBYTE* o = out;
+    for (uint32_t i = 0; i < want; i += 2) {
+      if (in[i] >= 216 || in[i + 1] >= 216) {
+        LOG_E("Base6: invalid code");
+        ok = false;
+        break;
+      }
+      const uint16_t a = kBase6Expand[in[i]];
+      const uint16_t b = kBase6Expand[in[i + 1]];
+      *o++ = (UBYTE)(a >> 4);
+      *o++ = (UBYTE)(((a & 0x0F) << 4) | (b >> 8));
+      *o++ = (UBYTE)b;
+    }
+    expandUs += micros() - t0;
+    if (!ok) {
+      break;
+    }
+
+    // Pixel triplets run across row ends; cut the packed bytes into rows
+    const UBYTE* p = out;
+    uint32_t n = (uint32_t)(o - out);
+    while (n > 0) {
+      const uint32_t take = (rowBytes - rowFill) < n ? (rowBytes - rowFill) : n;
+      memcpy(row + rowFill, p, take);
+      rowFill += take;
+      p += take;
+      n -= take;
+      if (rowFill == rowBytes) {
+        writeRow(row);
+        rowFill = 0;
+        rows++;
+      }
+    }
+    delay(0);
+  }
+
+  ok = ok && rows == height;
+  LOG_I("Base6: %u bytes (raw frame %u) in %u ms, expand %u ms",
+        pixels / 3, rowBytes * height, (unsigned)(millis() - start), expandUs / 1000);
+
+  free(in);
+  free(out);
+  free(row);
+  return ok;
+}
@@ -28,6 +28,34 @@
 #
 ******************************************************************************/
 #include "DEV_Config.h"
+#include "Debug.h"
+#include <driver/spi_master.h>
+
+// Whether the hardware SPI bus is claimed (begin + beginTransaction). The
+// transaction holds the bus lock, so it must be released before the pins are
+// handed to the bit-banged read path and must not be taken twice.
+static bool DEV_SPI_Active = false;
+
+static void DEV_SPI_Begin(void)
+{
+    if (DEV_SPI_Active) {
+        return;
+    }
+    // Explicitly bind SPI pins for ESP32-class MCUs
+    SPI.begin(EPD_SCK_PIN, -1, EPD_MOSI_PIN, EPD_CS_PIN);
+    SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));
+    DEV_SPI_Active = true;
+}
+
+static void DEV_SPI_End(void)
+{
+    if (!DEV_SPI_Active) {
+        return;
+    }
+    SPI.endTransaction();
+    SPI.end();
+    DEV_SPI_Active = false;
+}
 
 void GPIO_Config(void)
 {
@@ -38,11 +66,13 @@ void GPIO_Config(void)
     pinMode(EPD_PWR_PIN  , OUTPUT);
     #endif
     pinMode(EPD_CS_PIN , OUTPUT);
+    pinMode(EPD_CS_S_PIN , OUTPUT);
 
     #ifdef EPD_PWR_PIN
     digitalWrite(EPD_PWR_PIN , HIGH);
     #endif
     digitalWrite(EPD_CS_PIN , HIGH);
+    digitalWrite(EPD_CS_S_PIN , HIGH);
 }
 
 void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode)
@@ -67,9 +97,7 @@ UBYTE DEV_Module_Init(void)
 	Serial.begin(115200);
 
 	// spi
-    // Explicitly bind SPI pins for ESP32-class MCUs
-    SPI.begin(EPD_SCK_PIN, -1, EPD_MOSI_PIN, EPD_CS_PIN);
-    SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));
+    DEV_SPI_Begin();
 
 	return 0;
 }
@@ -77,16 +105,16 @@ UBYTE DEV_Module_Init(void)
 
 void DEV_GPIO_Init(void)
 {
-    SPI.end(); 
+    DEV_SPI_End();
     pinMode(EPD_SCK_PIN, OUTPUT);
     pinMode(EPD_MOSI_PIN, OUTPUT);
+    digitalWrite(EPD_SCK_PIN, GPIO_PIN_RESET);
 }
 
 void DEV_SPI_Init(void)
 {
     // Ensure SPI uses the configured pins
-    SPI.begin(EPD_SCK_PIN, -1, EPD_MOSI_PIN, EPD_CS_PIN);
-    SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));
+    DEV_SPI_Begin();
 }
 
 
@@ -105,6 +133,108 @@ void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
         DEV_SPI_WriteByte(pData[i]);
 }
 
+/******************************************************************************
+function:
+			Queued DMA writes for large transfers
+info:
+    The Arduino SPI object is released and the same bus (VSPI) is driven by
+    the IDF spi_master driver instead, so buffers are sent by DMA without a
+    per-byte loop. Call with CS high; the bus is not usable through
+    DEV_SPI_WriteByte until DEV_SPI_DMA_End().
+    Transfers complete in queue order. DEV_SPI_DMA_WaitOne() returns the
+    user pointer of the oldest finished one, so the owner of a buffer knows
+    when it may be released.
+******************************************************************************/
+static spi_device_handle_t DEV_SPI_DMA_Dev = NULL;
+static spi_transaction_t DEV_SPI_DMA_Trans[DEV_SPI_DMA_QUEUE];
+static UBYTE DEV_SPI_DMA_Head = 0;
+static UBYTE DEV_SPI_DMA_Pending = 0;
+
+bool DEV_SPI_DMA_Begin(void)
+{
+    DEV_SPI_End();
+
+    spi_bus_config_t bus;
+    memset(&bus, 0, sizeof(bus));
+    bus.mosi_io_num = EPD_MOSI_PIN;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = EPD_SCK_PIN;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = DEV_SPI_DMA_MAX_LEN;
+    if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+        LOG_E("SPI DMA bus init failed");
+        DEV_SPI_Begin();
+        return false;
+    }
+
+    spi_device_interface_config_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.clock_speed_hz = 4000000;
+    dev.mode = 0;
+    dev.spics_io_num = -1;    // CS stays under manual control
+    dev.queue_size = DEV_SPI_DMA_QUEUE;
+    if (spi_bus_add_device(SPI3_HOST, &dev, &DEV_SPI_DMA_Dev) != ESP_OK) {
+        LOG_E("SPI DMA device add failed");
+        spi_bus_free(SPI3_HOST);
+        DEV_SPI_Begin();
+        return false;
+    }
+
+    DEV_SPI_DMA_Head = 0;
+    DEV_SPI_DMA_Pending = 0;
+    return true;
+}
+
+bool DEV_SPI_DMA_Queue(const UBYTE *pData, UDOUBLE len, void *user)
+{
+    if (len == 0 || len > DEV_SPI_DMA_MAX_LEN || DEV_SPI_DMA_Pending >= DEV_SPI_DMA_QUEUE) {
+        return false;
+    }
+
+    spi_transaction_t *t = &DEV_SPI_DMA_Trans[DEV_SPI_DMA_Head];
+    memset(t, 0, sizeof(*t));
+    t->length = len * 8;
+    t->tx_buffer = pData;
+    t->user = user;
+    if (spi_device_queue_trans(DEV_SPI_DMA_Dev, t, portMAX_DELAY) != ESP_OK) {
+        return false;
+    }
+
+    DEV_SPI_DMA_Head = (DEV_SPI_DMA_Head + 1) % DEV_SPI_DMA_QUEUE;
+    DEV_SPI_DMA_Pending++;
+    return true;
+}
+
+UBYTE DEV_SPI_DMA_InFlight(void)
+{
+    return DEV_SPI_DMA_Pending;
+}
+
+void *DEV_SPI_DMA_WaitOne(void)
+{
+    spi_transaction_t *done = NULL;
+    if (DEV_SPI_DMA_Pending == 0 ||
+        spi_device_get_trans_result(DEV_SPI_DMA_Dev, &done, portMAX_DELAY) != ESP_OK) {
+        return NULL;
+    }
+    DEV_SPI_DMA_Pending--;
+    return done->user;
+}
+
+void DEV_SPI_DMA_End(void)
+{
+    while (DEV_SPI_DMA_Pending > 0) {
+        DEV_SPI_DMA_WaitOne();
+    }
+    if (DEV_SPI_DMA_Dev) {
+        spi_bus_remove_device(DEV_SPI_DMA_Dev);
+        DEV_SPI_DMA_Dev = NULL;
+        spi_bus_free(SPI3_HOST);
+    }
+    DEV_SPI_Begin();
+}
+
 void DEV_SPI_SendByte(UBYTE data)
 {
     GPIO_Mode(EPD_MOSI_PIN, OUTPUT);
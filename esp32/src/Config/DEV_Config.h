@@ -33,7 +33,9 @@
 #include <Arduino.h>
 #include <stdint.h>
 #include <stdio.h>
+#ifndef DEV_LINUX
 #include <SPI.h>
+#endif
 
 /**
  * data
@@ -44,22 +46,44 @@
 
 /**
  * GPIO config
- * Lolin32 (ESP32-WROOM-32) Pin Configuration
 **/
+#ifdef DEV_LINUX
+// Raspberry Pi with the Waveshare e-Paper HAT, BCM numbering (pi/ client).
+// SCK/MOSI/CS belong to spidev0.0; see pi/DEV_Config_Linux.cpp.
+#define EPD_SCK_PIN     11
+#define EPD_MOSI_PIN    10
+#define EPD_CS_PIN      8
+#define EPD_DC_PIN      25
+#define EPD_RST_PIN     17
+#define EPD_BUSY_PIN    24
+#define EPD_CS_S_PIN    7
+#define EPD_PWR_PIN     18
+#else
+// Lolin32 (ESP32-WROOM-32) Pin Configuration
 #define EPD_SCK_PIN     18  // VSPI Clock
 #define EPD_MOSI_PIN    23  // VSPI MOSI
 #define EPD_CS_PIN      5   // Chip Select
 #define EPD_DC_PIN      17  // Data/Command
 #define EPD_RST_PIN     16  // Reset
 #define EPD_BUSY_PIN    15  // Busy status
+#define EPD_CS_S_PIN    4   // Second chip select (13.3" dual-controller panel only)
 // Optional power-enable pin: most Waveshare SPI e-Paper modules
 // do not expose a controllable power pin; leave undefined unless
 // your driver board documents a PWR/EN pin.
 // #define EPD_PWR_PIN     11  // Power enable (optional)
+#endif
 
 #define GPIO_PIN_SET   1
 #define GPIO_PIN_RESET 0
 
+#ifdef DEV_LINUX
+/**
+ * GPIO read and write, delay x ms
+**/
+void DEV_Digital_Write(UWORD Pin, UBYTE Value);
+UBYTE DEV_Digital_Read(UWORD Pin);
+void DEV_Delay_ms(UDOUBLE xms);
+#else
 /**
  * GPIO read and write
 **/
@@ -70,6 +94,7 @@
  * delay x ms
 **/
 #define DEV_Delay_ms(__xms) delay(__xms)
+#endif
 
 /*------------------------------------------------------------------------------------------------------*/
 UBYTE DEV_Module_Init(void);
@@ -82,4 +107,13 @@ void DEV_SPI_SendByte(UBYTE data);
 UBYTE DEV_SPI_ReadByte();
 void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len);
 void DEV_Module_Exit(void);
+
+// DMA write queue (see DEV_Config.cpp)
+#define DEV_SPI_DMA_QUEUE    8      // transfers in flight
+#define DEV_SPI_DMA_MAX_LEN  4092   // bytes per transfer
+bool DEV_SPI_DMA_Begin(void);
+bool DEV_SPI_DMA_Queue(const UBYTE *pData, UDOUBLE len, void *user);
+UBYTE DEV_SPI_DMA_InFlight(void);
+void *DEV_SPI_DMA_WaitOne(void);
+void DEV_SPI_DMA_End(void);
 #endif
@@ -6,22 +6,61 @@
 *   Image scanning
 *      Please use progressive scanning to generate images or fonts
 *----------------
-* |	This version:   V1.0
+* |	This version:   V1.1
 * | Date        :   2018-01-11
 * | Info        :   Basic version
+* |               Leveled LOG_x() macros buffered in RTC memory (Log.h)
 *
 ******************************************************************************/
 #ifndef __DEBUG_H
 #define __DEBUG_H
 
 #include <Wire.h>
+#include "Log.h"
 
-#define USE_DEBUG 1
-#if USE_DEBUG
-	#define Debug(__info) Serial.print(__info)
+/**
+ * Log levels. Calls above LOG_LEVEL compile to nothing, arguments
+ * included (they are still type-checked, and count as used). The rest
+ * are formatted into the RTC log ring (Log.h) instead of being written
+ * to the UART while the device is awake.
+ */
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+	#define LOG_E(...) Log_Write(LOG_LEVEL_ERROR, __VA_ARGS__)
 #else
-	#define Debug(__info)  
+	#define LOG_E(...) do { if (0) Log_Write(LOG_LEVEL_ERROR, __VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+	#define LOG_W(...) Log_Write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+	#define LOG_W(...) do { if (0) Log_Write(LOG_LEVEL_WARN, __VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+	#define LOG_I(...) Log_Write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+	#define LOG_I(...) do { if (0) Log_Write(LOG_LEVEL_INFO, __VA_ARGS__); } while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+	#define LOG_D(...) Log_Write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+	#define LOG_D(...) do { if (0) Log_Write(LOG_LEVEL_DEBUG, __VA_ARGS__); } while (0)
 #endif
 
+// Waveshare driver traces, now at debug level
+#define USE_DEBUG (LOG_LEVEL >= LOG_LEVEL_DEBUG)
+#if USE_DEBUG
+	#define Debug(__info) Log_Write(LOG_LEVEL_DEBUG, "%s", __info)
+#else
+	#define Debug(__info)
 #endif
 
+#endif
@@ -0,0 +1,66 @@
+#include "FrameBuffer.h"
+#include "Debug.h"
+
+static UBYTE* frameBuffer = NULL;
+static UDOUBLE frameBufferSize = 0;
+
+bool FrameBuffer_Init(UDOUBLE bytes) {
+  if (frameBuffer && frameBufferSize >= bytes) {
+    return true;
+  }
+  FrameBuffer_Free();
+
+  // Internal heap is never used here: a 192 KB block does not fit next to
+  // the WiFi stack on WROOM boards, and trying just fragments the heap.
+  if (!psramFound()) {
+    LOG_W("No PSRAM: streaming frames to the display");
+    return false;
+  }
+
+  frameBuffer = (UBYTE*)ps_malloc(bytes);
+  if (!frameBuffer) {
+    LOG_E("PSRAM allocation of %u bytes failed: streaming frames", bytes);
+    return false;
+  }
+
+  frameBufferSize = bytes;
+  LOG_I("PSRAM frame buffer: %u bytes (free PSRAM %u)", bytes, ESP.getFreePsram());
+  return true;
+}
+
+UBYTE* FrameBuffer_Get(void) {
+  return frameBuffer;
+}
+
+UDOUBLE FrameBuffer_Size(void) {
+  return frameBufferSize;
+}
+
+bool FrameBuffer_ReadStream(Stream& stream, UDOUBLE len) {
+  if (!frameBuffer || len > frameBufferSize) {
+    return false;
+  }
+
+  const uint32_t start = millis();
+  UDOUBLE got = 0;
+  while (got < len) {
+    const size_t n = stream.readBytes((char*)frameBuffer + got, len - got);
+    if (n == 0) {
+      // readBytes() already waited for the stream timeout
+      LOG_E("Frame download stalled at %u of %u bytes", got, len);
+      return false;
+    }
+    got += n;
+  }
+
+  LOG_I("Frame downloaded to PSRAM in %u ms", (unsigned)(millis() - start));
+  return true;
+}
+
+void FrameBuffer_Free(void) {
+  if (frameBuffer) {
+    free(frameBuffer);
+  }
+  frameBuffer = NULL;
+  frameBufferSize = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef _FRAME_BUFFER_H_
+#define _FRAME_BUFFER_H_
+
+#include <Arduino.h>
+#include "DEV_Config.h"
+
+/**
+ * Optional full-frame buffer in PSRAM.
+ *
+ * WROVER-class boards have 4-8 MB of PSRAM, enough to hold a whole packed
+ * 4bpp frame (192 KB for 7.3", 960 KB for 13.3"). With it the frame is
+ * downloaded in full before the panel is woken, so a download cut short
+ * leaves the panel untouched and the next server can be tried, and messages
+ * are drawn in place. Boards without PSRAM get false from FrameBuffer_Init()
+ * and keep streaming straight to the panel. PSRAM does not survive deep
+ * sleep, so nothing is kept across wakes: the buffer holds the frame of
+ * the current wake only, and cannot re-display an earlier one.
+ */
+
+/**
+ * Allocate a frame of the given size in PSRAM (once; later calls reuse it)
+ * @return true if a buffer is available, false on boards without PSRAM
+ */
+bool FrameBuffer_Init(UDOUBLE bytes);
+
+/**
+ * @return the frame buffer, or NULL when running in streaming mode
+ */
+UBYTE* FrameBuffer_Get(void);
+
+/**
+ * @return size of the allocated buffer in bytes, 0 in streaming mode
+ */
+UDOUBLE FrameBuffer_Size(void);
+
+/**
+ * Fill the buffer from a stream, e.g. the HTTP response body
+ * @return true if exactly len bytes were read into the buffer
+ */
+bool FrameBuffer_ReadStream(Stream& stream, UDOUBLE len);
+
+/**
+ * Release the buffer and return to streaming mode
+ */
+void FrameBuffer_Free(void);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef _FRAME_DECODER_H_
+#define _FRAME_DECODER_H_
+
+#include <Arduino.h>
+#include "DEV_Config.h"
+
+/**
+ * Decoders for compressed frame transports.
+ *
+ * Each decoder reads its format from a stream and produces the panel's
+ * packed 4bpp rows (width/2 bytes, high nibble = left pixel) top-down, one
+ * row at a time, into a FrameRowWriter. Only a band of rows is ever held in
+ * RAM, so they run on boards without PSRAM.
+ */
+typedef void (*FrameRowWriter)(const UBYTE* row);
+
+/**
+ * Decode a baseline JPEG with the ROM TJpgDec in MCU-row bands and dither
+ * each band to the six panel colors (serpentine Floyd-Steinberg with a
+ * two-row integer error buffer).
+ *
+ * @param stream  JPEG data of exactly width x height pixels
+ * @param writeRow Receives each packed row
+ * @return true if all rows were decoded and written
+ */
+bool JpegDecoder_Decode(Stream& stream, UWORD width, UWORD height, FrameRowWriter writeRow);
+
+/**
+ * Expand the base-6 tri-pixel transport: each byte is three pixels as
+ * d0*36 + d1*6 + d2 (d0 = leftmost), digits 0..5 = black, white, yellow,
+ * red, blue, green, row-major across row ends. (width*height)/3 bytes.
+ *
+ * @param stream  Exactly (width*height)/3 bytes; width*height must be a multiple of 6
+ * @param writeRow Receives each packed row
+ * @return true if all rows were expanded and written
+ */
+bool Base6Decoder_Decode(Stream& stream, UWORD width, UWORD height, FrameRowWriter writeRow);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef _FRAME_PROTOCOL_H_
+#define _FRAME_PROTOCOL_H_
+
+#include <stdint.h>
+
+/**
+ * Binary frame protocol over a raw TCP connection (see FRAME_TCP_PORT).
+ *
+ * One exchange per connection: the device sends a fixed request, the server
+ * answers with a fixed header, `caption length` caption bytes and `length`
+ * payload bytes, and closes.
+ * All integers are little-endian. Keep in sync with the TCP listener in
+ * server/server/server.js.
+ *
+ * Request (FRAME_PROTO_REQUEST_SIZE bytes):
+ *   0  magic "EPF1"
+ *   4  u8  protocol version
+ *   5  u8  panel (FRAME_PROTO_PANEL_*)
+ *   6  u8[6] device id (factory MAC)
+ *   12 u16 capabilities, bit n set = format code n can be decoded
+ *   14 u8  preferred format code
+ *   15 i8  panel temperature in C, FRAME_PROTO_TEMP_UNKNOWN if not read
+ *   16 u8[8] digest of the frame currently on the panel, zero if none
+ *   24 u32 duration of the last refresh in ms, 0 if none
+ *   28 u8  last refresh mode (FRAME_PROTO_REFRESH_*)
+ *   29 u8  rank of this server in the device's failover order, 0 = first
+ *   30 u8[2] reserved, zero
+ *
+ * Response header (FRAME_PROTO_RESPONSE_SIZE bytes):
+ *   0  magic "EPF1"
+ *   4  u8  status (FRAME_PROTO_STATUS_*)
+ *   5  u8  format code of the payload
+ *   6  u8  refresh mode to use (FRAME_PROTO_REFRESH_*)
+ *   7  u8  caption length, 0 = none (at most FRAME_PROTO_CAPTION_MAX)
+ *   8  u32 payload length in bytes
+ *   12 u8[8] digest of the payload's frame
+ *   20 u32 seconds until the next wake, 0 = device default
+ *
+ * Caption: printable ASCII the device draws in a strip along the bottom of
+ * the frame, as X-Overlay-Text does over HTTP. The digest covers it, so a
+ * new caption on the same picture is a new frame. Version 1 requests get no
+ * caption.
+ */
+#define FRAME_PROTO_MAGIC          "EPF1"
+#define FRAME_PROTO_VERSION        2
+#define FRAME_PROTO_REQUEST_SIZE   32
+#define FRAME_PROTO_RESPONSE_SIZE  24
+#define FRAME_PROTO_DIGEST_SIZE    8
+#define FRAME_PROTO_CAPTION_MAX    64
+
+#define FRAME_PROTO_PANEL_7IN3E    0
+#define FRAME_PROTO_PANEL_13IN3E   1
+
+#define FRAME_PROTO_FORMAT_PACKED  0
+#define FRAME_PROTO_FORMAT_JPEG    1
+#define FRAME_PROTO_FORMAT_PNG     2
+#define FRAME_PROTO_FORMAT_BASE6   3
+
+#define FRAME_PROTO_REFRESH_NORMAL 0
+#define FRAME_PROTO_REFRESH_FAST   1
+
+#define FRAME_PROTO_STATUS_FRAME     0  // payload follows
+#define FRAME_PROTO_STATUS_UNCHANGED 1  // digest matched, no payload
+#define FRAME_PROTO_STATUS_ERROR     2  // no payload
+
+#define FRAME_PROTO_TEMP_UNKNOWN   (-128)
+
+#endif
@@ -1,8 +1,68 @@
 #include "ImageDownloader.h"
 #include "DEV_Config.h"
+#include "Debug.h"
+#include "FrameBuffer.h"
+#include "FrameDecoder.h"
+#include "FrameProtocol.h"
+#include "MemProbe.h"
+#include "NetconnClient.h"
+#include "TlsSessionClient.h"
+#include "ServerRanking.h"
 #include "../GUI/GUI_Paint.h"
+#include "../GUI/GUI_DisplayList.h"
 #include "../Fonts/fonts.h"
 #include "../e-Paper/EPD_7in3e.h"
+#include "../e-Paper/EPD_13in3e.h"
+#include <esp32/rom/miniz.h>
+
+#ifdef EPD_USE_13IN3E
+#define FRAME_PANEL   "13in3e"
+#define FRAME_WIDTH   EPD_13IN3E_WIDTH
+#define FRAME_HEIGHT  EPD_13IN3E_HEIGHT
+#else
+#define FRAME_PANEL   "7in3e"
+#define FRAME_WIDTH   EPD_7IN3E_WIDTH
+#define FRAME_HEIGHT  EPD_7IN3E_HEIGHT
+#endif
+
+// Rows per band when a message is drawn without a PSRAM frame: 40 rows of
+// the 7.3" panel are 16KB. Halved until the allocation succeeds.
+#define MESSAGE_BAND_ROWS 40
+#define MESSAGE_MAX_CMDS  8
+
+// Refresh statistics of the previous wake, reported to the server with the
+// next frame request so it can compare normal and fast refresh times.
+RTC_DATA_ATTR static uint32_t lastRefreshMs = 0;
+RTC_DATA_ATTR static bool lastRefreshFast = false;
+
+// Digest of the frame on the panel, sent with the next binary TCP request so
+// the server can answer "unchanged" instead of resending it.
+RTC_DATA_ATTR static uint8_t lastDigest[FRAME_PROTO_DIGEST_SIZE] = {0};
+
+// Next wake requested by the server with the current frame, 0 = default
+static uint32_t nextWakeSeconds = 0;
+
+// Server that delivered the current frame
+static const char* servingServerUrl = NULL;
+
+// Panel initialized and not in deep sleep
+static bool panelAwake = false;
+
+// Caption strip drawn over downloaded frames as their rows are sent, from
+// X-Overlay-Text or the binary protocol's caption, if any.
+#define CAPTION_MAX_CHARS   48
+#define CAPTION_STRIP_ROWS  40
+static PAINT_CMD captionCmds[2];
+static PAINT_LIST captionOverlay = {captionCmds, 0, 2, 0};
+static char captionText[CAPTION_MAX_CHARS + 1];
+static UWORD panelRow = 0;
+
+#if defined(FRAME_TCP_PORT) && defined(FRAME_CAPTION_WINDOW) && !defined(EPD_USE_13IN3E)
+#define CAPTION_WINDOW
+// Caption on the panel, kept with lastDigest to tell whether an "unchanged"
+// frame needs its caption strip redrawn
+RTC_DATA_ATTR static char panelCaption[CAPTION_MAX_CHARS + 1] = "";
+#endif
 
 static uint16_t readLe16(const uint8_t* p) {
   return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
@@ -12,7 +72,7 @@ static uint32_t readLe32(const uint8_t* p) {
   return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
 }
 
-static bool readExact(WiFiClient* stream, uint8_t* out, size_t len, uint32_t timeoutMs = 15000) {
+static bool readExact(Stream* stream, uint8_t* out, size_t len, uint32_t timeoutMs = 15000) {
   size_t got = 0;
   uint32_t lastProgress = millis();
 
@@ -33,7 +93,7 @@ static bool readExact(WiFiClient* stream, uint8_t* out, size_t len, uint32_t tim
   return true;
 }
 
-static bool skipExact(WiFiClient* stream, size_t len, uint32_t timeoutMs = 15000) {
+static bool skipExact(Stream* stream, size_t len, uint32_t timeoutMs = 15000) {
   uint8_t scratch[64];
   size_t remaining = len;
   while (remaining > 0) {
@@ -122,13 +182,13 @@ static UBYTE mapRgbToEpdColor(uint8_t r, uint8_t g, uint8_t b) {
  */
 uint32_t parseBmpHeader(uint8_t* header, uint32_t headerSize) {
   if (headerSize < 54) {
-    Serial.println("BMP header too small");
+    LOG_E("BMP header too small");
     return 0;
   }
 
   // Check BMP signature
   if (header[0] != 'B' || header[1] != 'M') {
-    Serial.println("Invalid BMP signature");
+    LOG_E("Invalid BMP signature");
     return 0;
   }
 
@@ -142,25 +202,122 @@ uint32_t parseBmpHeader(uint8_t* header, uint32_t headerSize) {
   // Get bits per pixel (at offset 28)
   uint16_t bitsPerPixel = readLe16(header + 28);
 
-  Serial.printf("BMP: %d x %d, %d bits/pixel, pixel data at offset %d\n", 
-                width, height, bitsPerPixel, pixelDataOffset);
+  LOG_I("BMP: %d x %d, %d bits/pixel, pixel data at offset %d", 
+        width, height, bitsPerPixel, pixelDataOffset);
 
   // Verify it's 24-bit BMP
   if (bitsPerPixel != 24) {
-    Serial.println("Only 24-bit BMP is supported");
+    LOG_E("Only 24-bit BMP is supported");
     return 0;
   }
 
   // Verify dimensions match display
   if (width != EPD_7IN3E_WIDTH || abs(height) != EPD_7IN3E_HEIGHT) {
-    Serial.printf("BMP dimensions mismatch: expected %d x %d\n", 
-                  EPD_7IN3E_WIDTH, EPD_7IN3E_HEIGHT);
+    LOG_E("BMP dimensions mismatch: expected %d x %d", 
+          EPD_7IN3E_WIDTH, EPD_7IN3E_HEIGHT);
     return 0;
   }
 
   return pixelDataOffset;
 }
 
+/**
+ * Send a full packed 4bpp frame from RAM to the selected panel and refresh
+ */
+static void showFrame(const UBYTE* frame) {
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_Display(frame);
+#else
+  EPD_7IN3E_Display((UBYTE*)frame);
+#endif
+}
+
+static bool hasFrameOverlay() {
+  return captionOverlay.Count > 0;
+}
+
+/**
+ * Draw the caption into rows of a frame on their way to the panel
+ * (EPD_ROW_FILTER); only primitives reaching these rows are drawn
+ */
+static void drawOverlayRows(UBYTE* rows, UWORD ystart, UWORD count, void* user) {
+  // Its own PAINT, so the stream never disturbs what the global Paint holds
+  static PAINT overlayPaint;
+  Paint_NewImage(overlayPaint, rows, FRAME_WIDTH, FRAME_HEIGHT, 0, EPD_7IN3E_WHITE);
+  Paint_SetScale(overlayPaint, 7);
+  Paint_DrawListOnto(overlayPaint, &captionOverlay, rows, ystart, count);
+}
+
+/**
+ * Caption strip along the bottom of the frame; empty text removes it.
+ * The fonts only cover printable ASCII; anything else becomes '?'.
+ */
+static void setCaption(const char* src) {
+  captionOverlay.Count = 0;
+  if (src[0] == '\0') {
+    return;
+  }
+  const size_t maxChars = (FRAME_WIDTH - 20) / Font24.Width;
+  size_t n = 0;
+  for (; src[n] != '\0' && n < maxChars && n < CAPTION_MAX_CHARS; n++) {
+    captionText[n] = (src[n] >= ' ' && src[n] <= '~') ? src[n] : '?';
+  }
+  captionText[n] = '\0';
+
+  Paint_ListInit(&captionOverlay, captionCmds, 2);
+  Paint_ListClearWindows(&captionOverlay, 0, FRAME_HEIGHT - CAPTION_STRIP_ROWS, FRAME_WIDTH, FRAME_HEIGHT,
+                         EPD_7IN3E_WHITE);
+  Paint_ListString_EN(&captionOverlay, 10, FRAME_HEIGHT - CAPTION_STRIP_ROWS + (CAPTION_STRIP_ROWS - Font24.Height) / 2,
+                      captionText, &Font24, EPD_7IN3E_BLACK, EPD_7IN3E_WHITE);
+  LOG_I("Caption: %s", captionText);
+}
+
+/**
+ * Row-by-row frame output for the decoders (see FrameDecoder.h)
+ */
+static void beginPanelFrame() {
+  panelRow = 0;
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_BeginFrame();
+#else
+  EPD_7IN3E_BeginFrame();
+#endif
+}
+
+static void writePanelRow(const UBYTE* row) {
+  // Decoders may still need their row, so the overlay goes onto a copy
+  static UBYTE overlaid[FRAME_WIDTH / 2];
+  if (hasFrameOverlay()) {
+    memcpy(overlaid, row, sizeof(overlaid));
+    drawOverlayRows(overlaid, panelRow, 1, NULL);
+    row = overlaid;
+  }
+  panelRow++;
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_WriteRow(row);
+#else
+  EPD_7IN3E_WriteFrame(row, FRAME_WIDTH / 2);
+#endif
+}
+
+static void endPanelFrame() {
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_EndFrame();
+#else
+  EPD_7IN3E_EndFrame();
+#endif
+}
+
+/**
+ * Leave the data phase of a frame that failed, without a refresh. The
+ * 13.3" driver already deselects both controllers after every row.
+ */
+static void abortPanelFrame() {
+#ifndef EPD_USE_13IN3E
+  EPD_7IN3E_AbortFrame();
+#endif
+}
+
 /**
  * Process BMP pixel data (BGR format) to e-paper color format
  * BMP stores data bottom-up, so we read in reverse
@@ -180,106 +337,1024 @@ void processBmpPixel(uint8_t b, uint8_t g, uint8_t r,
   }
 }
 
+static uint32_t readBe32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+// Indexed PNG decoder state. IDAT payload is inflated with the ROM tinfl into
+// a 32 KB circular window and cut into scanlines as it comes out, so only
+// two scanlines of the image are held in RAM.
+struct PngDecoder {
+  Stream* stream;
+  uint32_t idatLeft;    // payload bytes left in the current IDAT chunk
+  bool idatEnd;         // a non-IDAT chunk followed; no more image data
+  uint8_t bitDepth;     // 4 or 8
+  uint32_t lineBytes;   // scanline bytes without the filter byte
+  uint8_t* cur;         // scanline being assembled
+  uint8_t* prev;        // previous unfiltered scanline (zeros for row 0)
+  uint32_t linePos;     // bytes of the current scanline received, filter byte included
+  uint8_t filter;
+  UBYTE* out;           // packed 4bpp panel row
+  UWORD rows;
+  UBYTE lut[256];       // palette index -> EPD_7IN3E_* color
+  UBYTE pairLut[256];   // 4-bit: two indices per byte -> packed panel byte
+  uint32_t writeUs;
+};
+
 /**
- * Download and display image from server
+ * Read up to len bytes of image data, following consecutive IDAT chunks
  */
-bool downloadAndDisplayImage(const char* serverUrl) {
-  bool displayInitialized = false;
-  
-  if (!serverUrl || strlen(serverUrl) == 0) {
-    Serial.println("Invalid server URL");
+static size_t pngReadIdat(PngDecoder* png, uint8_t* out, size_t len) {
+  while (png->idatLeft == 0) {
+    if (png->idatEnd) {
+      return 0;
+    }
+    // CRC of the finished chunk, then the next chunk's length and type
+    uint8_t hdr[12];
+    if (!readExact(png->stream, hdr, sizeof(hdr))) {
+      return 0;
+    }
+    if (memcmp(hdr + 8, "IDAT", 4) != 0) {
+      png->idatEnd = true;
+      return 0;
+    }
+    png->idatLeft = readBe32(hdr + 4);
+  }
+
+  const size_t n = len < png->idatLeft ? len : png->idatLeft;
+  if (!readExact(png->stream, out, n)) {
+    return 0;
+  }
+  png->idatLeft -= n;
+  return n;
+}
+
+static inline uint8_t pngPaeth(uint8_t a, uint8_t b, uint8_t c) {
+  const int p = (int)a + b - c;
+  const int pa = abs(p - a);
+  const int pb = abs(p - b);
+  const int pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return a;
+  return (pb <= pc) ? b : c;
+}
+
+/**
+ * Undo the PNG filter of png->cur (1 byte per pixel step for indexed images),
+ * remap it to panel colors and write the row
+ */
+static bool pngFinishLine(PngDecoder* png, FrameRowWriter writeRow) {
+  uint8_t* cur = png->cur;
+  const uint8_t* prev = png->prev;
+  const uint32_t n = png->lineBytes;
+
+  switch (png->filter) {
+    case 0:
+      break;
+    case 1:
+      for (uint32_t i = 1; i < n; i++) cur[i] += cur[i - 1];
+      break;
+    case 2:
+      for (uint32_t i = 0; i < n; i++) cur[i] += prev[i];
+      break;
+    case 3:
+      cur[0] += prev[0] >> 1;
+      for (uint32_t i = 1; i < n; i++) cur[i] += (uint8_t)(((uint32_t)cur[i - 1] + prev[i]) >> 1);
+      break;
+    case 4:
+      cur[0] += prev[0];
+      for (uint32_t i = 1; i < n; i++) cur[i] += pngPaeth(cur[i - 1], prev[i], prev[i - 1]);
+      break;
+    default:
+      LOG_E("PNG: bad filter type %u", png->filter);
+      return false;
+  }
+
+  if (png->bitDepth == 4) {
+    for (uint32_t i = 0; i < n; i++) png->out[i] = png->pairLut[cur[i]];
+  } else {
+    for (uint32_t i = 0; i + 1 < n; i += 2) {
+      png->out[i >> 1] = (UBYTE)((png->lut[cur[i]] << 4) | png->lut[cur[i + 1]]);
+    }
+  }
+
+  const uint32_t t0 = micros();
+  writeRow(png->out);
+  png->writeUs += micros() - t0;
+  png->rows++;
+
+  png->prev = cur;
+  png->cur = (uint8_t*)prev;
+  png->linePos = 0;
+  return true;
+}
+
+/**
+ * Cut inflated bytes into scanlines
+ */
+static bool pngConsume(PngDecoder* png, const uint8_t* data, size_t len, UWORD height, FrameRowWriter writeRow) {
+  while (len > 0) {
+    if (png->rows >= height) {
+      return true; // trailing bytes past the last row are ignored
+    }
+    if (png->linePos == 0) {
+      png->filter = *data++;
+      len--;
+      png->linePos = 1;
+      continue;
+    }
+
+    const uint32_t want = png->lineBytes + 1 - png->linePos;
+    const size_t take = len < want ? len : want;
+    memcpy(png->cur + png->linePos - 1, data, take);
+    png->linePos += take;
+    data += take;
+    len -= take;
+
+    if (png->linePos == png->lineBytes + 1 && !pngFinishLine(png, writeRow)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Stream a non-interlaced 4-bit or 8-bit indexed PNG to the panel.
+ * Chunks before the first IDAT are parsed for IHDR and PLTE; everything after
+ * the image data is left unread.
+ */
+static bool decodeIndexedPng(Stream* stream, UWORD width, UWORD height, FrameRowWriter writeRow) {
+  static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+  const uint32_t start = millis();
+
+  PngDecoder png;
+  memset(&png, 0, sizeof(png));
+  png.stream = stream;
+
+  uint8_t buf[16];
+  if (!readExact(stream, buf, 8) || memcmp(buf, kSignature, 8) != 0) {
+    LOG_E("PNG: bad signature");
+    return false;
+  }
+
+  uint32_t inBytes = 8;
+  bool haveHeader = false;
+  bool havePalette = false;
+  while (true) {
+    if (!readExact(stream, buf, 8)) {
+      LOG_E("PNG: truncated before image data");
+      return false;
+    }
+    const uint32_t len = readBe32(buf);
+    inBytes += 12;
+
+    if (memcmp(buf + 4, "IDAT", 4) == 0) {
+      png.idatLeft = len; // payload is counted as it is inflated
+      break;
+    }
+    inBytes += len;
+
+    if (memcmp(buf + 4, "IHDR", 4) == 0 && len == 13) {
+      uint8_t ihdr[13];
+      if (!readExact(stream, ihdr, sizeof(ihdr)) || !skipExact(stream, 4)) {
+        return false;
+      }
+      const uint32_t w = readBe32(ihdr);
+      const uint32_t h = readBe32(ihdr + 4);
+      png.bitDepth = ihdr[8];
+      if (w != width || h != height || ihdr[9] != 3 || ihdr[12] != 0 ||
+          (png.bitDepth != 4 && png.bitDepth != 8)) {
+        LOG_E("PNG: unsupported %ux%u depth %u type %u interlace %u",
+              w, h, ihdr[8], ihdr[9], ihdr[12]);
+        return false;
+      }
+      png.lineBytes = (width * png.bitDepth + 7) / 8;
+      haveHeader = true;
+    } else if (memcmp(buf + 4, "PLTE", 4) == 0 && len <= 768 && len % 3 == 0) {
+      // Map each palette entry once; pixels then only need a table lookup.
+      memset(png.lut, EPD_7IN3E_WHITE, sizeof(png.lut));
+      for (uint32_t i = 0; i < len / 3; i++) {
+        uint8_t rgb[3];
+        if (!readExact(stream, rgb, 3)) {
+          return false;
+        }
+        png.lut[i] = mapRgbToEpdColor(rgb[0], rgb[1], rgb[2]);
+      }
+      if (!skipExact(stream, 4)) {
+        return false;
+      }
+      havePalette = true;
+    } else if (!skipExact(stream, len + 4)) {
+      return false;
+    }
+  }
+
+  if (!haveHeader || !havePalette) {
+    LOG_E("PNG: missing IHDR or PLTE");
     return false;
   }
+  for (int b = 0; b < 256; b++) {
+    png.pairLut[b] = (UBYTE)((png.lut[b >> 4] << 4) | png.lut[b & 0x0F]);
+  }
+
+  // ~11 KB inflate state plus the 32 KB window; both freed before the refresh
+  tinfl_decompressor* inflator = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+  uint8_t* dict = (uint8_t*)malloc(TINFL_LZ_DICT_SIZE);
+  uint8_t* lines = (uint8_t*)calloc(png.lineBytes * 2, 1);
+  png.out = (UBYTE*)malloc(width / 2);
+  uint8_t* in = (uint8_t*)malloc(1024);
+
+  bool ok = false;
+  if (inflator && dict && lines && png.out && in) {
+    png.cur = lines;
+    png.prev = lines + png.lineBytes;
+    tinfl_init(inflator);
+
+    size_t dictOfs = 0;
+    size_t inAvail = 0;
+    const uint8_t* inPtr = in;
+    tinfl_status status = TINFL_STATUS_NEEDS_MORE_INPUT;
+    while (true) {
+      if (inAvail == 0 && status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+        inAvail = pngReadIdat(&png, in, 1024);
+        inPtr = in;
+        inBytes += inAvail;
+        if (inAvail == 0) {
+          LOG_E("PNG: image data ended early");
+          break;
+        }
+        delay(0);
+      }
+
+      size_t inSize = inAvail;
+      size_t outSize = TINFL_LZ_DICT_SIZE - dictOfs;
+      const mz_uint32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER |
+                              ((png.idatLeft > 0 || !png.idatEnd) ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+      status = tinfl_decompress(inflator, inPtr, &inSize, dict, dict + dictOfs, &outSize, flags);
+      inPtr += inSize;
+      inAvail -= inSize;
+
+      if (!pngConsume(&png, dict + dictOfs, outSize, height, writeRow)) {
+        break;
+      }
+      dictOfs = (dictOfs + outSize) & (TINFL_LZ_DICT_SIZE - 1);
 
+      if (status == TINFL_STATUS_DONE || png.rows >= height) {
+        ok = (png.rows == height);
+        break;
+      }
+      if (status < 0) {
+        LOG_E("PNG: inflate error %d", (int)status);
+        break;
+      }
+    }
+  } else {
+    LOG_E("PNG: out of memory for decoder");
+  }
+
+  const uint32_t totalMs = millis() - start;
+  LOG_I("PNG: %u bytes (raw frame %u), %u rows in %u ms, panel write %u ms",
+        inBytes, (uint32_t)(width / 2) * height, png.rows, totalMs, png.writeUs / 1000);
+
+  free(in);
+  free(png.out);
+  free(lines);
+  free(dict);
+  free(inflator);
+  return ok;
+}
+
+/**
+ * Stream a packed frame body to the panel
+ */
+template <class Client>
+static bool streamPackedFrame(Client& client, Stream* stream, uint32_t len) {
+  const EPD_ROW_FILTER filter = hasFrameOverlay() ? drawOverlayRows : NULL;
+#ifdef EPD_USE_13IN3E
+  return EPD_13IN3E_DisplayStream(*stream, len, filter, NULL);
+#else
+  return EPD_7IN3E_DisplayStream(*stream, len, filter, NULL);
+#endif
+}
+
+#if defined(FRAME_RECEIVE_NETCONN) && !defined(EPD_USE_13IN3E)
+/**
+ * netconn: received pbufs go to SPI DMA as they are, no intermediate buffers
+ */
+static bool streamPackedFrame(NetconnClient& client, Stream* stream, uint32_t len) {
+  // pbufs go to DMA untouched; an overlay needs the rows in a buffer
+  if (hasFrameOverlay()) {
+    return EPD_7IN3E_DisplayStream(*stream, len, drawOverlayRows, NULL);
+  }
+  EPD_7IN3E_BeginFrame();
+  if (!client.writeBodyToPanel(len)) {
+    EPD_7IN3E_AbortFrame();
+    return false;
+  }
+  EPD_7IN3E_EndFrame();
+  return true;
+}
+#endif
+
+// Outcome of one server attempt. Only FETCH_UNREACHABLE leaves the panel
+// untouched, so only then is the next server tried.
+enum FetchResult {
+  FETCH_OK,
+  FETCH_UNREACHABLE,  // no connection or no usable response
+  FETCH_FAILED        // failed while the frame was being displayed
+};
+
+/**
+ * Display a frame response once its headers are read: pick the waveform
+ * and clear, then decode or stream the body into the panel, refresh and
+ * put the panel to sleep. Client is HTTPClient or any class with the same
+ * getStreamPtr()/end() members.
+ *
+ * Returns FETCH_UNREACHABLE when the body is rejected before the panel is
+ * touched (wrong size, PSRAM download cut short), so the caller can still
+ * try the next server.
+ */
+template <class Client>
+static FetchResult displayFrameBody(Client& http, const String& fmt, bool fastRefresh, int totalSize,
+                             int panelTemp, bool panelTempValid) {
+  // Compressed transports are decoded row by row straight into the panel;
+  // anything else is the raw packed frame.
+  const bool jpegFrame = fmt.equalsIgnoreCase("jpeg");
+  const bool pngFrame = fmt.equalsIgnoreCase("png");
+  const bool base6Frame = fmt.equalsIgnoreCase("base6x3");
+  const bool decodedFrame = jpegFrame || pngFrame || base6Frame;
+
+  const uint32_t expectedLen = (uint32_t)(FRAME_WIDTH / 2) * (uint32_t)FRAME_HEIGHT; // 192000 or 960000
+  if (!decodedFrame && totalSize > 0 && (uint32_t)totalSize != expectedLen) {
+    LOG_E("Unexpected frame size: got %d, expected %u", totalSize, expectedLen);
+    http.end();
+    return FETCH_UNREACHABLE;
+  }
+
+  Stream* stream = http.getStreamPtr();
+  const uint32_t lenToRead = (totalSize > 0) ? (uint32_t)totalSize : expectedLen;
+
+  // With PSRAM the whole frame is downloaded first and the connection is
+  // released before the clear and the refresh instead of being held open
+  // across them. Without PSRAM, stream straight into the panel as before.
+  bool buffered = false;
+  if (!decodedFrame && lenToRead == expectedLen && FrameBuffer_Init(expectedLen)) {
+    buffered = FrameBuffer_ReadStream(*stream, lenToRead);
+    http.end();
+    if (!buffered) {
+      LOG_E("Failed while downloading frame");
+      return FETCH_UNREACHABLE;
+    }
+  }
+
+  // The panel has slept since its temperature was read; wake it with the
+  // waveform this frame asked for.
+  LOG_I("Initializing e-Paper display...");
+  initDisplay(fastRefresh);
+
+  // Anti-ghost clear before drawing. It costs a full extra refresh, so only
+  // spend it where it pays off: cold panels retain visibly more of the
+  // previous image. Never in fast mode, and always if the reading failed.
+  const bool clearFirst = !fastRefresh &&
+                          (!panelTempValid || panelTemp < ANTI_GHOST_CLEAR_BELOW_C);
+  if (clearFirst) {
+    clearDisplay(EPD_7IN3E_WHITE);
+    delay(500);
+  }
+
+  bool ok = true;
+  if (buffered && hasFrameOverlay()) {
+    // Overlaid row by row, so the buffer keeps the frame as downloaded
+    LOG_I("Displaying frame from PSRAM with overlay...");
+    beginPanelFrame();
+    for (UWORD y = 0; y < FRAME_HEIGHT; y++) {
+      writePanelRow(FrameBuffer_Get() + (uint32_t)y * (FRAME_WIDTH / 2));
+    }
+    endPanelFrame();
+  } else if (buffered) {
+    LOG_I("Displaying frame from PSRAM...");
+    showFrame(FrameBuffer_Get());
+  } else if (decodedFrame) {
+    LOG_I("Decoding %s frame to e-Paper...", fmt.c_str());
+    beginPanelFrame();
+    if (jpegFrame) {
+      ok = JpegDecoder_Decode(*stream, FRAME_WIDTH, FRAME_HEIGHT, writePanelRow);
+    } else if (pngFrame) {
+      ok = decodeIndexedPng(stream, FRAME_WIDTH, FRAME_HEIGHT, writePanelRow);
+    } else {
+      ok = Base6Decoder_Decode(*stream, FRAME_WIDTH, FRAME_HEIGHT, writePanelRow);
+    }
+    if (ok) {
+      endPanelFrame();
+    } else {
+      abortPanelFrame();
+    }
+    http.end();
+  } else {
+    LOG_I("Streaming frame to e-Paper...");
+    ok = streamPackedFrame(http, stream, lenToRead);
+    http.end();
+  }
+  MemProbe_Mark("frame-rx");
+
+  if (!ok) {
+    LOG_E("Failed while streaming frame to display");
+    sleepDisplay();
+    return FETCH_FAILED;
+  }
+
+#ifdef EPD_USE_13IN3E
+  lastRefreshMs = EPD_13IN3E_GetLastRefreshMs();
+#else
+  lastRefreshMs = EPD_7IN3E_GetLastRefreshMs();
+#endif
+  lastRefreshFast = fastRefresh;
+  LOG_I("Frame refresh (%s) took %u ms", fastRefresh ? "fast" : "normal", lastRefreshMs);
+
+  delay(2000);
+  sleepDisplay();
+  delay(500);
+  MemProbe_Mark("refresh");
+
+  LOG_I("Image display complete");
+  return FETCH_OK;
+}
+
+/**
+ * The server picks the waveform per frame, e.g. fast for frequently
+ * changing dashboards and normal for photos. The fast waveform is only
+ * tuned for room temperature, so fall back to normal outside that range,
+ * and on the 13.3", whose driver has none.
+ */
+static bool chooseFastRefresh(bool requested, int panelTemp, bool panelTempValid) {
+#ifdef EPD_USE_13IN3E
+  if (requested) {
+    LOG_W("Fast refresh requested but the 13.3\" panel has no fast waveform");
+    requested = false;
+  }
+#endif
+  bool fastRefresh = requested;
+  if (fastRefresh && (!panelTempValid ||
+                      panelTemp < FAST_REFRESH_MIN_TEMP_C ||
+                      panelTemp > FAST_REFRESH_MAX_TEMP_C)) {
+    LOG_W("Fast refresh requested but panel temperature out of range");
+    fastRefresh = false;
+  }
+  LOG_I("Refresh mode: %s", fastRefresh ? "fast" : "normal");
+  return fastRefresh;
+}
+
+/**
+ * Split "http[s]://host[:port][/path]" into host and port (80 or 443 by default)
+ */
+static bool parseServerHost(const char* serverUrl, char* host, size_t hostSize, uint16_t* port) {
+  const char* p = strstr(serverUrl, "://");
+  *port = (strncmp(serverUrl, "https://", 8) == 0) ? 443 : 80;
+  p = p ? p + 3 : serverUrl;
+  const size_t hostLen = strcspn(p, ":/");
+  if (hostLen == 0 || hostLen >= hostSize) {
+    return false;
+  }
+  memcpy(host, p, hostLen);
+  host[hostLen] = '\0';
+  if (p[hostLen] == ':') {
+    *port = (uint16_t)atoi(p + hostLen + 1);
+  }
+  return true;
+}
+
+#ifdef FRAME_TCP_PORT
+// Format names by FRAME_PROTO_FORMAT_* code, as displayFrameBody() expects
+static const char* const kFrameFormatNames[] = {"packed4bpp", "jpeg", "png", "base6x3"};
+static const uint8_t kFrameFormatCount = sizeof(kFrameFormatNames) / sizeof(kFrameFormatNames[0]);
+
+// The whole exchange runs from these; nothing is allocated per request.
+static uint8_t tcpRequest[FRAME_PROTO_REQUEST_SIZE];
+static uint8_t tcpResponse[FRAME_PROTO_RESPONSE_SIZE];
+static char tcpCaption[FRAME_PROTO_CAPTION_MAX + 1];
+
+/**
+ * Raw TCP connection with the getStreamPtr()/end() members displayFrameBody() uses
+ */
+struct TcpFrameClient {
+  WiFiClient client;
+  Stream* getStreamPtr() { return &client; }
+  void end() { client.stop(); }
+};
+
+static void writeLe16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void writeLe32(uint8_t* p, uint32_t v) {
+  writeLe16(p, (uint16_t)v);
+  writeLe16(p + 2, (uint16_t)(v >> 16));
+}
+
+#ifdef CAPTION_WINDOW
+/**
+ * Draw the caption into a strip-sized band and send the rows it covers
+ * through the panel's partial window, over the frame already in its RAM.
+ * Nothing drawn (no caption) means nothing sent.
+ */
+static void redrawCaption() {
+  const uint32_t rowBytes = FRAME_WIDTH / 2;
+  UBYTE* strip = (UBYTE*)malloc(rowBytes * CAPTION_STRIP_ROWS);
+  if (strip == NULL) {
+    LOG_E("No memory for the caption strip");
+    return;
+  }
+  PAINT paint;
+  Paint_NewImage(paint, strip, FRAME_WIDTH, FRAME_HEIGHT, 0, EPD_7IN3E_WHITE);
+  Paint_SetScale(paint, 7);
+  Paint_SetBand(paint, FRAME_HEIGHT - CAPTION_STRIP_ROWS, CAPTION_STRIP_ROWS);
+  Paint_DrawList(paint, &captionOverlay);
+
+  UWORD xs, ys, xe, ye;
+  if (!Paint_GetDirty(paint, &xs, &ys, &xe, &ye)) {
+    LOG_I("Caption removed; it stays on the panel until the next frame");
+    free(strip);
+    return;
+  }
+  LOG_I("Sending caption window %u,%u-%u,%u", xs, ys, xe, ye);
+  initDisplay();
+  EPD_7IN3E_DisplayWindow(strip + (uint32_t)(ys - paint.BandTop) * rowBytes, xs, ys, xe, ye);
+  LOG_I("Caption refresh took %u ms", EPD_7IN3E_GetLastRefreshMs());
+  sleepDisplay();
+  free(strip);
+  strcpy(panelCaption, captionText);
+}
+#endif
+
+/**
+ * Fetch and display a frame with the binary protocol (FrameProtocol.h)
+ * from FRAME_TCP_PORT on the host of serverUrl
+ */
+static FetchResult fetchTcpFrame(const char* serverUrl, uint8_t rank, uint32_t* connectMs,
+                                 int panelTemp, bool panelTempValid) {
+  char host[64];
+  uint16_t port;
+  if (!parseServerHost(serverUrl, host, sizeof(host), &port)) {
+    LOG_E("Invalid server host");
+    return FETCH_UNREACHABLE;
+  }
+
+  uint8_t formatCode = 0;
+  while (formatCode < kFrameFormatCount && strcmp(kFrameFormatNames[formatCode], FRAME_REQUEST_FORMAT) != 0) {
+    formatCode++;
+  }
+  if (formatCode == kFrameFormatCount) {
+    formatCode = FRAME_PROTO_FORMAT_PACKED;
+  }
+
+  const uint64_t mac = ESP.getEfuseMac();
+  memset(tcpRequest, 0, sizeof(tcpRequest));
+  memcpy(tcpRequest, FRAME_PROTO_MAGIC, 4);
+  tcpRequest[4] = FRAME_PROTO_VERSION;
+#ifdef EPD_USE_13IN3E
+  tcpRequest[5] = FRAME_PROTO_PANEL_13IN3E;
+#else
+  tcpRequest[5] = FRAME_PROTO_PANEL_7IN3E;
+#endif
+  for (int i = 0; i < 6; i++) {
+    tcpRequest[6 + i] = (uint8_t)(mac >> (8 * i));
+  }
+  writeLe16(tcpRequest + 12, (1 << kFrameFormatCount) - 1); // every decoder is built in
+  tcpRequest[14] = formatCode;
+  tcpRequest[15] = (uint8_t)(int8_t)(panelTempValid ? panelTemp : FRAME_PROTO_TEMP_UNKNOWN);
+  memcpy(tcpRequest + 16, lastDigest, FRAME_PROTO_DIGEST_SIZE);
+  writeLe32(tcpRequest + 24, lastRefreshMs);
+  tcpRequest[28] = lastRefreshFast ? FRAME_PROTO_REFRESH_FAST : FRAME_PROTO_REFRESH_NORMAL;
+  tcpRequest[29] = rank;
+
+  LOG_I("Requesting frame from %s:%u (binary TCP)", host, (unsigned)FRAME_TCP_PORT);
+  const uint32_t requestStart = millis();
+
+  TcpFrameClient tcp;
+  if (!tcp.client.connect(host, FRAME_TCP_PORT, SERVER_CONNECT_BUDGET_MS)) {
+    LOG_E("Connection failed after %u ms", (unsigned)(millis() - requestStart));
+    return FETCH_UNREACHABLE;
+  }
+  *connectMs = millis() - requestStart;
+  MemProbe_Mark("connect");
+  tcp.client.setNoDelay(true);
+  if (tcp.client.write(tcpRequest, sizeof(tcpRequest)) != sizeof(tcpRequest) ||
+      !readExact(&tcp.client, tcpResponse, sizeof(tcpResponse))) {
+    LOG_E("Frame request failed");
+    tcp.end();
+    return FETCH_UNREACHABLE;
+  }
+  LOG_I("Response header after %u ms (connect %u ms)",
+        (unsigned)(millis() - requestStart), (unsigned)*connectMs);
+  MemProbe_Mark("headers");
+
+  if (memcmp(tcpResponse, FRAME_PROTO_MAGIC, 4) != 0) {
+    LOG_E("Bad frame response magic");
+    tcp.end();
+    return FETCH_UNREACHABLE;
+  }
+
+  const uint8_t status = tcpResponse[4];
+  const uint8_t payloadFormat = tcpResponse[5];
+  const uint8_t captionLength = tcpResponse[7];
+  const uint32_t length = readLe32(tcpResponse + 8);
+  nextWakeSeconds = readLe32(tcpResponse + 20);
+
+  if (captionLength > FRAME_PROTO_CAPTION_MAX ||
+      !readExact(&tcp.client, (uint8_t*)tcpCaption, captionLength)) {
+    LOG_E("Bad frame caption (%u bytes)", captionLength);
+    tcp.end();
+    return FETCH_UNREACHABLE;
+  }
+  tcpCaption[captionLength] = '\0';
+
+  if (status == FRAME_PROTO_STATUS_UNCHANGED) {
+    tcp.end();
+#ifdef CAPTION_WINDOW
+    setCaption(tcpCaption);
+    if (strcmp(hasFrameOverlay() ? captionText : "", panelCaption) != 0) {
+      LOG_I("Frame unchanged, caption changed");
+      redrawCaption();
+      return FETCH_OK;
+    }
+#endif
+    LOG_I("Frame unchanged, keeping the panel as it is");
+    return FETCH_OK;
+  }
+  if (status != FRAME_PROTO_STATUS_FRAME || payloadFormat >= kFrameFormatCount) {
+    LOG_E("Frame response status %u, format %u", status, payloadFormat);
+    tcp.end();
+    return FETCH_UNREACHABLE;
+  }
+  LOG_I("Frame format: %s, %u bytes", kFrameFormatNames[payloadFormat], length);
+
+  setCaption(tcpCaption);
+  const bool fastRefresh = chooseFastRefresh(tcpResponse[6] == FRAME_PROTO_REFRESH_FAST,
+                                             panelTemp, panelTempValid);
+  const FetchResult result = displayFrameBody(tcp, String(kFrameFormatNames[payloadFormat]), fastRefresh,
+                                              (int)length, panelTemp, panelTempValid);
+  if (result != FETCH_OK) {
+    return result;
+  }
+  memcpy(lastDigest, tcpResponse + 12, FRAME_PROTO_DIGEST_SIZE);
+#ifdef CAPTION_WINDOW
+  strcpy(panelCaption, hasFrameOverlay() ? captionText : "");
+#endif
+  return FETCH_OK;
+}
+#else
+/**
+ * Fetch and display a frame from GET /esp32/frame on serverUrl
+ */
+static FetchResult fetchHttpFrame(const char* serverUrl, uint8_t rank, uint32_t* connectMs,
+                                  int panelTemp, bool panelTempValid) {
   // Build the image endpoint URL
   char imageUrl[256];
-  snprintf(imageUrl, sizeof(imageUrl), "%s/esp32/frame", serverUrl);
+  snprintf(imageUrl, sizeof(imageUrl), "%s/esp32/frame?panel=%s&format=%s",
+           serverUrl, FRAME_PANEL, FRAME_REQUEST_FORMAT);
 
-  Serial.printf("Downloading packed frame from: %s\n", imageUrl);
+  LOG_I("Downloading packed frame from: %s", imageUrl);
+  const uint32_t requestStart = millis();
 
-  HTTPClient http;
+#ifdef FRAME_RECEIVE_NETCONN
+  NetconnClient http;
   http.setTimeout(30000);
-
+  http.setConnectTimeout(SERVER_CONNECT_BUDGET_MS);
   if (!http.begin(imageUrl)) {
-    Serial.println("Failed to begin HTTP request");
-    return false;
+    LOG_E("Failed to begin HTTP request");
+    return FETCH_UNREACHABLE;
+  }
+#else
+  char host[64];
+  uint16_t port;
+  if (!parseServerHost(serverUrl, host, sizeof(host), &port)) {
+    LOG_E("Invalid server host");
+    return FETCH_UNREACHABLE;
   }
 
+  // Connect (and for https:// resume TLS) here within the budget; HTTPClient
+  // then finds the client connected and sends the request on it. The
+  // clients are declared before http: HTTPClient stops its client when
+  // destroyed.
+  TlsSessionClient tls;
+  WiFiClient plain;
+  WiFiClient* client = (strncmp(serverUrl, "https://", 8) == 0) ? &tls : &plain;
+  if (!client->connect(host, port, SERVER_CONNECT_BUDGET_MS)) {
+    LOG_E("Connection to %s:%u failed after %u ms", host, port, (unsigned)(millis() - requestStart));
+    return FETCH_UNREACHABLE;
+  }
+  *connectMs = millis() - requestStart;
+  MemProbe_Mark("connect");
+
+  HTTPClient http;
+  http.setTimeout(30000);
+  http.setReuse(false);
+  if (!http.begin(*client, imageUrl)) {
+    LOG_E("Failed to begin HTTP request");
+    return FETCH_UNREACHABLE;
+  }
+#endif
+
   http.addHeader("Connection", "close");
+  http.addHeader("X-Server-Rank", String(rank));
+  if (lastRefreshMs > 0) {
+    http.addHeader("X-Last-Refresh-Ms", String(lastRefreshMs));
+    http.addHeader("X-Last-Refresh-Mode", lastRefreshFast ? "fast" : "normal");
+  }
+  if (panelTempValid) {
+    http.addHeader("X-Panel-Temp", String(panelTemp));
+  }
+
+  // HTTPClient drops response headers unless they are requested up front.
+  const char* headerKeys[] = {"X-Image-Format", "X-Refresh-Mode", "X-Overlay-Text"};
+  http.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
 
   int httpCode = http.GET();
+#ifdef FRAME_RECEIVE_NETCONN
+  *connectMs = http.getConnectMs();
+#endif
+  LOG_I("Response headers after %u ms (connect %u ms)",
+        (unsigned)(millis() - requestStart), (unsigned)*connectMs);
+  MemProbe_Mark("headers");
   if (httpCode != HTTP_CODE_OK) {
-    Serial.printf("HTTP request failed with code: %d\n", httpCode);
+    LOG_E("HTTP request failed with code: %d", httpCode);
     if (httpCode > 0) {
-      Serial.println(http.getString());
+      LOG_E("%s", http.getString().c_str());
     } else {
-      Serial.println("Connection failed - check server URL and network");
+      LOG_E("Connection failed - check server URL and network");
     }
     http.end();
-    return false;
+    return FETCH_UNREACHABLE;
   }
 
   const String fmt = http.header("X-Image-Format");
-  Serial.printf("X-Image-Format: %s\n", fmt.c_str());
+  LOG_D("X-Image-Format: %s", fmt.c_str());
+  setCaption(http.header("X-Overlay-Text").c_str());
+
+  const bool fastRefresh = chooseFastRefresh(http.header("X-Refresh-Mode").equalsIgnoreCase("fast"),
+                                             panelTemp, panelTempValid);
 
   const int totalSize = http.getSize();
-  Serial.printf("Frame size (Content-Length): %d bytes\n", totalSize);
+  LOG_D("Frame size (Content-Length): %d bytes", totalSize);
 
-  const uint32_t expectedLen = (uint32_t)(EPD_7IN3E_WIDTH / 2) * (uint32_t)EPD_7IN3E_HEIGHT; // 192000
-  if (totalSize > 0 && (uint32_t)totalSize != expectedLen) {
-    Serial.printf("Unexpected frame size: got %d, expected %u\n", totalSize, expectedLen);
-    http.end();
+  return displayFrameBody(http, fmt, fastRefresh, totalSize, panelTemp, panelTempValid);
+}
+#endif
+
+/**
+ * Download and display image from the first server that answers
+ */
+bool downloadAndDisplayImage(const char* const serverUrls[], uint8_t count) {
+  if (count > MAX_SERVER_URLS) {
+    count = MAX_SERVER_URLS;
+  }
+  if (count == 0 || !serverUrls[0] || strlen(serverUrls[0]) == 0) {
+    LOG_E("Invalid server URL");
     return false;
   }
 
   if (DEV_Module_Init() != 0) {
-    Serial.println("Failed to initialize display module");
-    http.end();
+    LOG_E("Failed to initialize display module");
     return false;
   }
 
-  Serial.println("Initializing e-Paper display...");
-  EPD_7IN3E_Init();
-  displayInitialized = true;
-
-  // Optional clear before drawing
-  EPD_7IN3E_Clear(EPD_7IN3E_WHITE);
-  delay(500);
+#ifdef EPD_USE_13IN3E
+  // The dual-controller panel has no temperature readout on this wiring.
+  const int panelTemp = EPD_7IN3E_TEMP_INVALID;
+#else
+  // Wake the panel just long enough to read its temperature, which goes
+  // along with the request and drives the waveform and clear decisions.
+  // It sleeps through the fetch and any failover, and is initialized
+  // again once a frame body is accepted.
+  initDisplay();
+  const int panelTemp = EPD_7IN3E_ReadTemperature();
+  sleepDisplay();
+#endif
+  const bool panelTempValid = (panelTemp != EPD_7IN3E_TEMP_INVALID);
+  if (panelTempValid) {
+    LOG_I("Panel temperature: %d C", panelTemp);
+  } else {
+    LOG_W("Panel temperature: unavailable");
+  }
+  MemProbe_Mark("panel-init");
 
-  WiFiClient* stream = http.getStreamPtr();
+  uint8_t order[MAX_SERVER_URLS];
+  ServerRanking_Order(serverUrls, count, order, SERVER_CONNECT_BUDGET_MS);
 
-  Serial.println("Streaming frame to e-Paper...");
-  const uint32_t lenToRead = (totalSize > 0) ? (uint32_t)totalSize : expectedLen;
-  const bool ok = EPD_7IN3E_DisplayStream(*stream, lenToRead);
+  for (uint8_t rank = 0; rank < count; rank++) {
+    const uint8_t index = order[rank];
+    const char* url = serverUrls[index];
+    if (!url || strlen(url) == 0) {
+      continue;
+    }
 
-  http.end();
+    uint32_t connectMs = SERVER_CONNECT_BUDGET_MS;
+#ifdef FRAME_TCP_PORT
+    const FetchResult result = fetchTcpFrame(url, rank, &connectMs, panelTemp, panelTempValid);
+#else
+    const FetchResult result = fetchHttpFrame(url, rank, &connectMs, panelTemp, panelTempValid);
+#endif
+    ServerRanking_Report(index, url, result != FETCH_UNREACHABLE, connectMs);
 
-  if (!ok) {
-    Serial.println("Failed while streaming frame to display");
-    if (displayInitialized) {
-      EPD_7IN3E_Sleep();
+    if (result == FETCH_OK) {
+      servingServerUrl = url;
+      LOG_I("Frame served by %s (choice %u of %u)", url, rank + 1, count);
+      return true;
     }
-    return false;
+    if (result == FETCH_FAILED) {
+      // The panel has been written to; another server cannot fix that today
+      return false;
+    }
+    LOG_W("Server %s unavailable, trying the next one", url);
   }
 
-  delay(2000);
-  EPD_7IN3E_Sleep();
-  delay(500);
+  LOG_E("No server delivered a frame");
+  return false;
+}
 
-  Serial.println("Image display complete");
-  return true;
+bool downloadAndDisplayImage(const char* serverUrl) {
+  return downloadAndDisplayImage(&serverUrl, 1);
+}
+
+const char* getServingServerUrl() {
+  return servingServerUrl;
+}
+
+uint32_t getNextWakeSeconds() {
+  return nextWakeSeconds;
 }
 
 /**
  * Cleanup and deinitialize display after error
  */
 void cleanupDisplay() {
-  Serial.println("Cleaning up display...");
+  LOG_I("Cleaning up display...");
   
   // Just put the display to sleep, don't fully exit the module
   // This allows us to reinitialize more easily
-  EPD_7IN3E_Sleep();
+  sleepDisplay();
   delay(2000); // Longer delay to ensure display is fully asleep
   
-  Serial.println("Display cleanup complete");
+  LOG_I("Display cleanup complete");
+}
+
+/**
+ * Initialize the selected panel. The fast waveform exists on the 7.3" only.
+ */
+void initDisplay(bool fastRefresh) {
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_Init();
+#else
+  if (fastRefresh) {
+    EPD_7IN3E_Init_Fast();
+  } else {
+    EPD_7IN3E_Init();
+  }
+#endif
+  panelAwake = true;
+}
+
+/**
+ * Fill the selected panel with one color and refresh
+ */
+void clearDisplay(uint8_t color) {
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_Clear(color);
+  LOG_I("Clear refresh took %u ms", EPD_13IN3E_GetLastRefreshMs());
+#else
+  EPD_7IN3E_Clear(color);
+  LOG_I("Clear refresh took %u ms", EPD_7IN3E_GetLastRefreshMs());
+#endif
+}
+
+/**
+ * Put the selected panel (both controllers on the 13.3") into deep sleep.
+ * Does nothing if it is not awake: a sleeping controller does not answer.
+ */
+void sleepDisplay() {
+  if (!panelAwake) {
+    return;
+  }
+  panelAwake = false;
+#ifdef EPD_USE_13IN3E
+  EPD_13IN3E_Sleep();
+#else
+  EPD_7IN3E_Sleep();
+#endif
+}
+
+/**
+ * Band output for Paint_DrawListBanded: whole rows of the panel, in order
+ */
+static void writePanelBand(const UBYTE* band, UWORD rows, void* user) {
+#ifdef EPD_USE_13IN3E
+  for (UWORD y = 0; y < rows; y++) {
+    EPD_13IN3E_WriteRow(band + (uint32_t)y * (FRAME_WIDTH / 2));
+  }
+#else
+  EPD_7IN3E_WriteFrame(band, (uint32_t)rows * (FRAME_WIDTH / 2));
+#endif
+}
+
+/**
+ * Draw the message into a few rows at a time and stream them to the panel
+ * in one data phase, for boards without PSRAM
+ */
+static bool displayListBanded(const PAINT_LIST* list) {
+  const uint32_t rowBytes = FRAME_WIDTH / 2;
+  UWORD bandRows = MESSAGE_BAND_ROWS;
+  UBYTE* band = NULL;
+  while (bandRows > 0 && (band = (UBYTE*)malloc(rowBytes * bandRows)) == NULL) {
+    bandRows /= 2;
+  }
+  if (band == NULL) {
+    LOG_E("No memory for a %u byte band", rowBytes);
+    return false;
+  }
+  // A second band lets the other core draw every other band
+  UBYTE* oddBand = (UBYTE*)malloc(rowBytes * bandRows);
+  LOG_I("Drawing message in %u-row bands (%u bytes, %s)", bandRows, rowBytes * bandRows,
+        oddBand ? "both cores" : "one core");
+
+  PAINT even, odd;
+  Paint_NewImage(even, band, FRAME_WIDTH, FRAME_HEIGHT, 0, EPD_7IN3E_WHITE);
+  Paint_SetScale(even, 7);
+  beginPanelFrame();
+  if (oddBand) {
+    Paint_NewImage(odd, oddBand, FRAME_WIDTH, FRAME_HEIGHT, 0, EPD_7IN3E_WHITE);
+    Paint_SetScale(odd, 7);
+    Paint_DrawListBandedDual(even, odd, list, bandRows, writePanelBand, NULL);
+  } else {
+    Paint_DrawListBanded(even, list, bandRows, writePanelBand, NULL);
+  }
+  endPanelFrame();
+  free(oddBand);
+  free(band);
+  return true;
+}
+
+// Alert icon left of the message: a red disc with a white "!", 0x0F
+// outside it. Drawn with whole-row copies, in the PSRAM frame or a band.
+#define ALERT_ICON_SIZE 32
+static const UBYTE alertIconData[ALERT_ICON_SIZE / 2 * ALERT_ICON_SIZE] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF,
+  0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF,
+  0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF,
+  0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x11, 0x11, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x33, 0x33, 0x33, 0x33, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+static const PAINT_SPRITE alertIcon = {alertIconData, ALERT_ICON_SIZE, ALERT_ICON_SIZE, 0x0F, MIRROR_NONE, ROTATE_0};
+
+/**
+ * Render a text message and show it: into the PSRAM frame when there is
+ * one, else band by band
+ */
+bool displayMessage(const char* message, uint8_t color) {
+  PAINT_CMD cmds[MESSAGE_MAX_CMDS];
+  PAINT_LIST list;
+  Paint_ListInit(&list, cmds, MESSAGE_MAX_CMDS);
+  Paint_ListClear(&list, EPD_7IN3E_WHITE);
+  Paint_ListRectangle(&list, 10, 10, FRAME_WIDTH - 10, FRAME_HEIGHT - 10, color, DOT_PIXEL_4X4, DRAW_FILL_EMPTY);
+  Paint_ListSprite(&list, &alertIcon, 30, 30);
+  Paint_ListString_EN(&list, 30 + ALERT_ICON_SIZE + 14, 30 + (ALERT_ICON_SIZE - Font24.Height) / 2,
+                      message, &Font24, color, EPD_7IN3E_WHITE);
+
+  const uint32_t frameLen = (uint32_t)(FRAME_WIDTH / 2) * (uint32_t)FRAME_HEIGHT;
+  if (!FrameBuffer_Init(frameLen)) {
+    return displayListBanded(&list);
+  }
+
+  // Paint's scale 7 is the same packed 4bpp layout, so it can draw in place.
+  Paint_NewImage(FrameBuffer_Get(), FRAME_WIDTH, FRAME_HEIGHT, 0, EPD_7IN3E_WHITE);
+  Paint_SetScale(7);
+  Paint_DrawList(&list);
+  showFrame(FrameBuffer_Get());
+  return true;
 }
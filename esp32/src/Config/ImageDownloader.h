@@ -3,10 +3,58 @@
 
 #include <HTTPClient.h>
 #include <WiFi.h>
+#include "ServerRanking.h"
 
 // Chunk size for streaming packed framebuffer data
 #define FRAME_CHUNK_SIZE 4096
 
+// Panel temperature policy, in whole degrees Celsius
+#define FAST_REFRESH_MIN_TEMP_C   15  // Fast waveform only inside this range
+#define FAST_REFRESH_MAX_TEMP_C   35
+#define ANTI_GHOST_CLEAR_BELOW_C  20  // Pre-clear with white only when colder
+
+// Connect budget per server when several are configured. A server that does
+// not accept the connection (and TLS handshake) in time is skipped for the
+// next one instead of holding up the wake for the full HTTP timeout.
+#define SERVER_CONNECT_BUDGET_MS  3000
+
+// Panel selection: define for the 13.3" dual-controller Spectra 6 (1200x1600),
+// leave undefined for the 7.3" panel (800x480).
+// #define EPD_USE_13IN3E
+
+// Frame transport requested from /esp32/frame (?format=...):
+//   "packed4bpp" - raw panel bytes, streamed or buffered as-is (default)
+//   "jpeg"       - ~3x smaller, decoded and dithered on the device
+//   "png"        - server-dithered 4-bit indexed PNG, inflated on the device
+//   "base6x3"    - server-dithered, three pixels per byte (2/3 of packed4bpp)
+#define FRAME_REQUEST_FORMAT "packed4bpp"
+
+// Receive frames on the lwIP netconn API instead of HTTPClient/WiFiClient.
+// Packed frames then go from the received pbufs to SPI DMA without copies
+// (7.3" panel only; the 13.3" splits rows and reads through the Stream path).
+// Off by default: the switch of the panel bus to SPI DMA in the middle of a
+// frame has not been tried on hardware yet. http:// servers only.
+// #define FRAME_RECEIVE_NETCONN
+
+// https:// server URLs use TlsSessionClient, which keeps the TLS session in
+// RTC memory so later wakes resume it instead of a full handshake. They
+// need the server's certificate: set TLS_SERVER_CERT_PEM in
+// TlsSessionClient.h.
+
+// Fetch frames with the binary protocol in FrameProtocol.h on this TCP port
+// of the server host instead of GET /esp32/frame. Saves the HTTP round of
+// header text and lets the server answer "unchanged" for the frame already
+// on the panel without sending it.
+// #define FRAME_TCP_PORT 3001
+
+// With FRAME_TCP_PORT on the 7.3" panel: when the server answers
+// "unchanged" with a different caption, send just the caption strip
+// through the panel's partial window instead of nothing. This relies on
+// the panel RAM keeping the last frame through deep sleep and reset, which
+// has not been tried on a panel yet. A caption that is removed stays up
+// until the next frame.
+// #define FRAME_CAPTION_WINDOW
+
 /**
  * Downloads an image from the server and displays it on the e-paper display
  * The image should be packed 4bpp framebuffer data from the /esp32/frame endpoint
@@ -16,11 +64,52 @@
  */
 bool downloadAndDisplayImage(const char* serverUrl);
 
+/**
+ * Like downloadAndDisplayImage(serverUrl), trying several servers.
+ * They are tried in the order ranked by ServerRanking (recent connect time
+ * and failures), each with SERVER_CONNECT_BUDGET_MS to connect, until one
+ * delivers a frame. The serving server is logged and told its rank.
+ *
+ * @param serverUrls Base URLs of the servers, in configured order
+ * @param count      Number of URLs (at most MAX_SERVER_URLS)
+ * @return true if successful, false otherwise
+ */
+bool downloadAndDisplayImage(const char* const serverUrls[], uint8_t count);
+
+/**
+ * @return the server that delivered the last frame, or NULL if none did.
+ * Points into the list passed to downloadAndDisplayImage().
+ */
+const char* getServingServerUrl();
+
+/**
+ * Seconds until the next wake as requested by the server with the last
+ * frame (binary TCP protocol only), or 0 to use the default sleep time.
+ */
+uint32_t getNextWakeSeconds();
+
 /**
  * Cleanup and deinitialize display after error
  */
 void cleanupDisplay();
 
+/**
+ * Panel-agnostic helpers for the selected display (see EPD_USE_13IN3E).
+ * initDisplay() resets the panel and loads the normal or, on the 7.3",
+ * the fast waveform; sleepDisplay() skips a panel already asleep.
+ */
+void initDisplay(bool fastRefresh = false);
+void clearDisplay(uint8_t color);
+void sleepDisplay();
+
+/**
+ * Draw a text message in the given color on a white frame and display it.
+ * Uses the PSRAM frame buffer if there is one, otherwise draws and sends
+ * the frame in bands of a few rows. Returns false (nothing drawn) if not
+ * even a band can be allocated. The display must already be initialized.
+ */
+bool displayMessage(const char* message, uint8_t color);
+
 // Optional: allow callers to skip display operations when network-only failures happen.
 
 #endif
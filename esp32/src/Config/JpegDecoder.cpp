@@ -0,0 +1,211 @@
+#include "FrameDecoder.h"
+#include "../e-Paper/EPD_7in3e.h"
+#include <esp32/rom/tjpgd.h>
+
+// TJpgDec work area: the ROM build (512 byte input buffer) needs ~3.1 KB
+#define JPEG_WORK_SIZE 4096
+
+// Measured panel colors, the same values mapRgbToEpdColor() accepts from
+// the server's dither. Dithering against these rather than pure RGB keeps
+// the device output close to the server-dithered frames.
+static const struct {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  UBYTE epd;
+} kPanelPalette[] = {
+  {0x19, 0x1E, 0x21, EPD_7IN3E_BLACK},
+  {0xE8, 0xE8, 0xE8, EPD_7IN3E_WHITE},
+  {0xB2, 0x13, 0x18, EPD_7IN3E_RED},
+  {0x21, 0x57, 0xBA, EPD_7IN3E_BLUE},
+  {0x12, 0x5F, 0x20, EPD_7IN3E_GREEN},
+  {0xEF, 0xDE, 0x44, EPD_7IN3E_YELLOW},
+};
+static const int kPaletteSize = sizeof(kPanelPalette) / sizeof(kPanelPalette[0]);
+
+struct JpegContext {
+  Stream* stream;
+  UWORD width;
+  UWORD height;
+  UWORD bandRows;     // MCU height: 8 or 16 rows
+  uint8_t* band;      // bandRows x width RGB888
+  int16_t* err;       // two rows of (width + 2) x RGB error, one pixel margin each side
+  UBYTE* row;         // one packed 4bpp output row
+  FrameRowWriter writeRow;
+  UWORD nextRow;
+  uint32_t bytesIn;
+  uint32_t ditherUs;
+  uint32_t writeUs;
+};
+
+static UINT jpegInput(JDEC* jd, BYTE* buf, UINT len) {
+  JpegContext* ctx = (JpegContext*)jd->device;
+
+  if (!buf) {
+    // TJpgDec skips segments it does not need (EXIF, comments) this way
+    uint8_t scratch[64];
+    UINT skipped = 0;
+    while (skipped < len) {
+      const UINT chunk = (len - skipped) > sizeof(scratch) ? sizeof(scratch) : (len - skipped);
+      const size_t n = ctx->stream->readBytes((char*)scratch, chunk);
+      if (n == 0) {
+        break;
+      }
+      skipped += n;
+    }
+    ctx->bytesIn += skipped;
+    return skipped;
+  }
+
+  const size_t n = ctx->stream->readBytes((char*)buf, len);
+  ctx->bytesIn += n;
+  return (UINT)n;
+}
+
+static inline int clamp255(int v) {
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+static inline int nearestPaletteIndex(int r, int g, int b) {
+  int best = 0;
+  int32_t bestDist = INT32_MAX;
+  for (int i = 0; i < kPaletteSize; i++) {
+    const int dr = r - kPanelPalette[i].r;
+    const int dg = g - kPanelPalette[i].g;
+    const int db = b - kPanelPalette[i].b;
+    const int32_t d = dr * dr + dg * dg + db * db;
+    if (d < bestDist) {
+      bestDist = d;
+      best = i;
+    }
+  }
+  return best;
+}
+
+/**
+ * Dither one RGB888 row into ctx->row and hand it to the writer.
+ * Rows alternate direction (serpentine) like the server dither, which avoids
+ * the diagonal streaks plain left-to-right diffusion leaves in flat areas.
+ */
+static void ditherRow(JpegContext* ctx, const uint8_t* rgb) {
+  const uint32_t t0 = micros();
+  const int w = ctx->width;
+  const int stride = (w + 2) * 3;
+  int16_t* cur = ctx->err + (ctx->nextRow & 1) * stride;
+  int16_t* nxt = ctx->err + ((ctx->nextRow + 1) & 1) * stride;
+  memset(nxt, 0, stride * sizeof(int16_t));
+
+  const int step = (ctx->nextRow & 1) ? -1 : 1;
+  int x = (step > 0) ? 0 : w - 1;
+  for (int i = 0; i < w; i++, x += step) {
+    const uint8_t* p = rgb + x * 3;
+    int16_t* e = cur + (x + 1) * 3;
+    int16_t* n = nxt + (x + 1) * 3;
+
+    const int r = clamp255(p[0] + e[0]);
+    const int g = clamp255(p[1] + e[1]);
+    const int b = clamp255(p[2] + e[2]);
+    const int idx = nearestPaletteIndex(r, g, b);
+
+    const UBYTE c = kPanelPalette[idx].epd;
+    UBYTE* out = ctx->row + (x >> 1);
+    *out = (x & 1) ? (UBYTE)((*out & 0xF0) | c) : (UBYTE)((c << 4) | (*out & 0x0F));
+
+    const int d[3] = {r - kPanelPalette[idx].r, g - kPanelPalette[idx].g, b - kPanelPalette[idx].b};
+    const int ahead = step * 3;
+    for (int ch = 0; ch < 3; ch++) {
+      e[ahead + ch] += (int16_t)(d[ch] * 7 / 16);
+      n[-ahead + ch] += (int16_t)(d[ch] * 3 / 16);
+      n[ch] += (int16_t)(d[ch] * 5 / 16);
+      n[ahead + ch] += (int16_t)(d[ch] / 16);
+    }
+  }
+
+  const uint32_t t1 = micros();
+  ctx->writeRow(ctx->row);
+  ctx->ditherUs += t1 - t0;
+  ctx->writeUs += micros() - t1;
+  ctx->nextRow++;
+}
+
+static UINT jpegOutput(JDEC* jd, void* bitmap, JRECT* rect) {
+  JpegContext* ctx = (JpegContext*)jd->device;
+  const BYTE* src = (const BYTE*)bitmap;
+  const UINT blockBytes = (rect->right - rect->left + 1) * 3;
+
+  for (UINT y = rect->top; y <= rect->bottom; y++) {
+    uint8_t* dst = ctx->band + ((y % ctx->bandRows) * ctx->width + rect->left) * 3;
+    memcpy(dst, src, blockBytes);
+    src += blockBytes;
+  }
+
+  // MCUs arrive left to right; the last one of an MCU row completes the band
+  if (rect->right == ctx->width - 1) {
+    for (UINT y = rect->top; y <= rect->bottom; y++) {
+      ditherRow(ctx, ctx->band + (y % ctx->bandRows) * ctx->width * 3);
+      delay(0);
+    }
+  }
+  return 1;
+}
+
+bool JpegDecoder_Decode(Stream& stream, UWORD width, UWORD height, FrameRowWriter writeRow) {
+  JpegContext ctx;
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.stream = &stream;
+  ctx.width = width;
+  ctx.height = height;
+  ctx.writeRow = writeRow;
+
+  bool ok = false;
+  const uint32_t start = millis();
+  JDEC jd;
+  JRESULT res;
+  void* work = malloc(JPEG_WORK_SIZE);
+  if (!work) {
+    LOG_E("JPEG: out of memory for decoder");
+    return false;
+  }
+
+  res = jd_prepare(&jd, jpegInput, work, JPEG_WORK_SIZE, &ctx);
+  if (res != JDR_OK) {
+    LOG_E("JPEG: header error %d", res);
+    goto done;
+  }
+  if (jd.width != width || jd.height != height) {
+    LOG_E("JPEG: got %ux%u, expected %ux%u", jd.width, jd.height, width, height);
+    goto done;
+  }
+
+  ctx.bandRows = jd.msy * 8;
+  ctx.band = (uint8_t*)malloc((size_t)ctx.bandRows * width * 3);
+  ctx.err = (int16_t*)calloc((size_t)(width + 2) * 3 * 2, sizeof(int16_t));
+  ctx.row = (UBYTE*)malloc(width / 2);
+  if (!ctx.band || !ctx.err || !ctx.row) {
+    LOG_E("JPEG: out of memory for band buffers");
+    goto done;
+  }
+
+  res = jd_decomp(&jd, jpegOutput, 0);
+  ok = (res == JDR_OK && ctx.nextRow == height);
+  if (!ok) {
+    LOG_E("JPEG: decode error %d at row %u", res, ctx.nextRow);
+  }
+
+  {
+    // Decode+dither cost against the bytes the raw frame would have needed
+    const uint32_t totalMs = millis() - start;
+    const uint32_t ditherMs = ctx.ditherUs / 1000;
+    const uint32_t writeMs = ctx.writeUs / 1000;
+    LOG_I("JPEG: %u bytes (raw frame %u), total %u ms: decode+download %u ms, dither %u ms, panel write %u ms",
+          ctx.bytesIn, (uint32_t)(width / 2) * height, totalMs,
+          totalMs - ditherMs - writeMs, ditherMs, writeMs);
+  }
+
+done:
+  free(ctx.row);
+  free(ctx.err);
+  free(ctx.band);
+  free(work);
+  return ok;
+}
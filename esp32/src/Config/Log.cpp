@@ -0,0 +1,108 @@
+#include "Log.h"
+#include "Debug.h"
+#include <stdarg.h>
+
+// Positions are absolute byte counts since power-on; ring index = pos % size.
+// The UART and the upload consume the same lines independently.
+RTC_DATA_ATTR static char logRing[LOG_RING_SIZE];
+RTC_DATA_ATTR static uint32_t logWritten = 0;
+RTC_DATA_ATTR static uint32_t logSerialPos = 0;
+RTC_DATA_ATTR static uint32_t logUploadPos = 0;
+RTC_DATA_ATTR static uint32_t logDropped = 0;
+RTC_DATA_ATTR static uint32_t logWakes = 0;
+
+static const char kLevelChar[] = {'-', 'E', 'W', 'I', 'D'};
+
+static void ringAppend(const char* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    logRing[(logWritten + i) % LOG_RING_SIZE] = data[i];
+  }
+  logWritten += len;
+}
+
+/**
+ * Oldest position still in the ring at or after pos, moved forward to a
+ * line start if the line at pos was overwritten
+ */
+static uint32_t oldestFrom(uint32_t pos) {
+  if (logWritten - pos <= LOG_RING_SIZE) {
+    return pos;
+  }
+  pos = logWritten - LOG_RING_SIZE;
+  while (pos < logWritten && logRing[pos % LOG_RING_SIZE] != '\n') {
+    pos++;
+  }
+  return pos < logWritten ? pos + 1 : pos;
+}
+
+void Log_Begin(void) {
+  logWakes++;
+  Log_Write(LOG_LEVEL_INFO, "--- wake %u ---", logWakes);
+}
+
+void Log_Write(uint8_t level, const char* format, ...) {
+  char line[LOG_LINE_MAX];
+  int n = snprintf(line, sizeof(line), "%lu %c ", (unsigned long)millis(),
+                   level < sizeof(kLevelChar) ? kLevelChar[level] : '?');
+
+  va_list args;
+  va_start(args, format);
+  const int m = vsnprintf(line + n, sizeof(line) - n, format, args);
+  va_end(args);
+  n = (m < 0) ? n : ((n + m < (int)sizeof(line) - 1) ? n + m : (int)sizeof(line) - 2);
+  line[n++] = '\n';
+
+  ringAppend(line, n);
+#if LOG_SERIAL_ECHO
+  Serial.write((const uint8_t*)line, n);
+#endif
+}
+
+void Log_FlushTo(Print& out) {
+  uint32_t pos = oldestFrom(logSerialPos);
+  while (pos < logWritten) {
+    // Up to the end of the ring storage per write
+    const size_t at = pos % LOG_RING_SIZE;
+    size_t n = logWritten - pos;
+    if (n > LOG_RING_SIZE - at) {
+      n = LOG_RING_SIZE - at;
+    }
+    out.write((const uint8_t*)logRing + at, n);
+    pos += n;
+  }
+  logSerialPos = pos;
+}
+
+size_t Log_CopyForUpload(char* out, size_t size, uint32_t* mark) {
+  const uint32_t from = oldestFrom(logUploadPos);
+  logDropped += from - logUploadPos;
+  logUploadPos = from;
+
+  size_t n = logWritten - from;
+  if (n > size) {
+    // Whole lines only; the rest goes with the next upload
+    n = size;
+    while (n > 0 && logRing[(from + n - 1) % LOG_RING_SIZE] != '\n') {
+      n--;
+    }
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = logRing[(from + i) % LOG_RING_SIZE];
+  }
+  *mark = from + n;
+  return n;
+}
+
+void Log_MarkUploaded(uint32_t mark) {
+  if (mark > logUploadPos && mark <= logWritten) {
+    logUploadPos = mark;
+  }
+}
+
+uint32_t Log_WakeCount(void) {
+  return logWakes;
+}
+
+uint32_t Log_DroppedBytes(void) {
+  return logDropped;
+}
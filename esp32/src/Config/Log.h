@@ -0,0 +1,51 @@
+#ifndef _LOG_H_
+#define _LOG_H_
+
+#include <Arduino.h>
+
+// Log ring in RTC slow memory: survives deep sleep, so lines from a wake
+// that could not upload them go out with a later one. Oldest lines are
+// overwritten when it is full.
+#define LOG_RING_SIZE 2048
+
+// Longest single log line; longer ones are cut
+#define LOG_LINE_MAX 160
+
+// 1: also print every line to Serial as it is logged (blocking, for bench
+// debugging). 0: lines are only buffered, see Log_FlushTo().
+#ifndef LOG_SERIAL_ECHO
+#define LOG_SERIAL_ECHO 0
+#endif
+
+/**
+ * Start the log for this wake: counts the wake and marks its first line
+ */
+void Log_Begin(void);
+
+/**
+ * Format one line ("<ms> <level> <text>") into the ring. Use the LOG_x()
+ * macros from Debug.h rather than calling this directly.
+ */
+void Log_Write(uint8_t level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * Print the lines not printed yet, e.g. to Serial just before deep sleep
+ */
+void Log_FlushTo(Print& out);
+
+/**
+ * Copy the lines not uploaded yet (oldest first, up to size bytes).
+ * Pass the returned mark to Log_MarkUploaded() once they are delivered.
+ *
+ * @return number of bytes copied
+ */
+size_t Log_CopyForUpload(char* out, size_t size, uint32_t* mark);
+void Log_MarkUploaded(uint32_t mark);
+
+/**
+ * @return wakes since power-on, and bytes lost to ring overflow before upload
+ */
+uint32_t Log_WakeCount(void);
+uint32_t Log_DroppedBytes(void);
+
+#endif
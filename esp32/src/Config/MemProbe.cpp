@@ -0,0 +1,116 @@
+#include "MemProbe.h"
+#include "Debug.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define STACK_UNKNOWN 0xFFFF
+
+struct MemSample {
+  char phase[MEMPROBE_NAME_LENGTH + 1];
+  uint32_t ms;
+  uint32_t freeHeap;
+  uint32_t largestBlock;
+  uint32_t minFreeHeap;
+  uint16_t stackFree[MEMPROBE_TASK_COUNT];  // bytes, STACK_UNKNOWN if no task
+};
+
+static const char* const taskNames[MEMPROBE_TASK_COUNT] = MEMPROBE_TASK_NAMES;
+
+RTC_DATA_ATTR static MemSample samples[MEMPROBE_MAX_PHASES];
+RTC_DATA_ATTR static uint8_t sampleCount;
+
+// Lowest values over all wakes; lowestFree == 0 until the first sample
+RTC_DATA_ATTR static uint32_t lowestFree;
+RTC_DATA_ATTR static uint32_t lowestLargest;
+RTC_DATA_ATTR static char lowestFreePhase[MEMPROBE_NAME_LENGTH + 1];
+RTC_DATA_ATTR static char lowestLargestPhase[MEMPROBE_NAME_LENGTH + 1];
+RTC_DATA_ATTR static uint16_t lowestStack[MEMPROBE_TASK_COUNT];
+
+void MemProbe_Begin(void) {
+  sampleCount = 0;
+  if (lowestFree == 0) {
+    for (uint8_t t = 0; t < MEMPROBE_TASK_COUNT; t++) {
+      lowestStack[t] = STACK_UNKNOWN;
+    }
+  }
+  MemProbe_Mark("boot");
+}
+
+void MemProbe_Mark(const char* phase) {
+  if (sampleCount >= MEMPROBE_MAX_PHASES) {
+    LOG_D("MemProbe: no room for phase %s", phase);
+    return;
+  }
+  MemSample* s = &samples[sampleCount++];
+  strncpy(s->phase, phase, MEMPROBE_NAME_LENGTH);
+  s->phase[MEMPROBE_NAME_LENGTH] = '\0';
+  s->ms = millis();
+  s->freeHeap = ESP.getFreeHeap();
+  s->largestBlock = ESP.getMaxAllocHeap();
+  s->minFreeHeap = ESP.getMinFreeHeap();
+
+  for (uint8_t t = 0; t < MEMPROBE_TASK_COUNT; t++) {
+    // ESP-IDF counts stack in bytes, not words
+    TaskHandle_t task = taskNames[t] ? xTaskGetHandle(taskNames[t]) : NULL;
+    s->stackFree[t] = STACK_UNKNOWN;
+    if (task || !taskNames[t]) {
+      const UBaseType_t unused = uxTaskGetStackHighWaterMark(task);
+      s->stackFree[t] = unused < STACK_UNKNOWN ? (uint16_t)unused : STACK_UNKNOWN - 1;
+    }
+    if (s->stackFree[t] < lowestStack[t]) {
+      lowestStack[t] = s->stackFree[t];
+    }
+  }
+
+  if (lowestFree == 0 || s->freeHeap < lowestFree) {
+    lowestFree = s->freeHeap;
+    memcpy(lowestFreePhase, s->phase, sizeof(lowestFreePhase));
+  }
+  if (lowestLargest == 0 || s->largestBlock < lowestLargest) {
+    lowestLargest = s->largestBlock;
+    memcpy(lowestLargestPhase, s->phase, sizeof(lowestLargestPhase));
+  }
+
+  LOG_D("Mem %s: free %u, largest %u, min free %u, loop stack %u",
+        s->phase, s->freeHeap, s->largestBlock, s->minFreeHeap, s->stackFree[0]);
+}
+
+static void appendStacks(String& out, const uint16_t* stack) {
+  char buf[8];
+  out += '[';
+  for (uint8_t t = 0; t < MEMPROBE_TASK_COUNT; t++) {
+    snprintf(buf, sizeof(buf), "%s%d", t ? "," : "",
+             stack[t] == STACK_UNKNOWN ? -1 : (int)stack[t]);
+    out += buf;
+  }
+  out += ']';
+}
+
+void MemProbe_AppendJson(String& out) {
+  char buf[160];
+
+  out += "{\"tasks\":[";
+  for (uint8_t t = 0; t < MEMPROBE_TASK_COUNT; t++) {
+    snprintf(buf, sizeof(buf), "%s\"%s\"", t ? "," : "",
+             taskNames[t] ? taskNames[t] : pcTaskGetName(NULL));
+    out += buf;
+  }
+
+  out += "],\"phases\":[";
+  for (uint8_t i = 0; i < sampleCount; i++) {
+    const MemSample* s = &samples[i];
+    snprintf(buf, sizeof(buf),
+             "%s{\"phase\":\"%s\",\"ms\":%u,\"free\":%u,\"largest\":%u,\"minFree\":%u,\"stack\":",
+             i ? "," : "", s->phase, s->ms, s->freeHeap, s->largestBlock, s->minFreeHeap);
+    out += buf;
+    appendStacks(out, s->stackFree);
+    out += '}';
+  }
+
+  snprintf(buf, sizeof(buf),
+           "],\"lowest\":{\"free\":%u,\"freePhase\":\"%s\",\"largest\":%u,\"largestPhase\":\"%s\",\"stack\":",
+           lowestFree, lowestFreePhase, lowestLargest, lowestLargestPhase);
+  out += buf;
+  appendStacks(out, lowestStack);
+  out += "}}";
+}
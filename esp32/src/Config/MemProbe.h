@@ -0,0 +1,48 @@
+#ifndef _MEM_PROBE_H_
+#define _MEM_PROBE_H_
+
+#include <Arduino.h>
+
+/**
+ * Heap and stack watermarks sampled at the phase boundaries of a wake.
+ *
+ * Each MemProbe_Mark() records free heap, the largest allocatable block,
+ * the minimum free heap since boot and the stack high-water mark of the
+ * tasks in MEMPROBE_TASK_NAMES. The samples of the current wake and the
+ * lowest values seen over all wakes are kept in RTC memory and go out with
+ * the telemetry upload, so a fragmentation failure can be traced back to
+ * the phase that left too small a block behind.
+ */
+
+// Most phase boundaries recorded per wake; later marks are dropped
+#define MEMPROBE_MAX_PHASES 16
+// Phase names are truncated to this many characters
+#define MEMPROBE_NAME_LENGTH 11
+
+// Tasks whose stacks are watched; NULL is the task calling MemProbe_Mark
+// (the Arduino loop task). "tiT" is the lwIP TCP/IP task.
+#define MEMPROBE_TASK_NAMES { NULL, "tiT", "wifi", "sys_evt" }
+#define MEMPROBE_TASK_COUNT 4
+
+/**
+ * Start a new wake: forget the previous wake's samples and record "boot"
+ */
+void MemProbe_Begin(void);
+
+/**
+ * Record the memory state at the end of a phase
+ *
+ * @param phase Short phase name, e.g. "wifi" or "frame-rx"
+ */
+void MemProbe_Mark(const char* phase);
+
+/**
+ * Append the samples as JSON:
+ *   {"tasks": [names], "phases": [{"phase", "ms", "free", "largest",
+ *    "minFree", "stack": [bytes per task]}], "lowest": {"free", "freePhase",
+ *    "largest", "largestPhase", "stack": [bytes per task]}}
+ * Stack values are the fewest bytes left unused; -1 if the task was not found.
+ */
+void MemProbe_AppendJson(String& out);
+
+#endif
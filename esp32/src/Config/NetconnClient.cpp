@@ -0,0 +1,386 @@
+#include "NetconnClient.h"
+#include "Debug.h"
+#include <lwip/api.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// netconn_connect() blocks until the handshake ends, with no timeout of its
+// own. GET() connects non-blocking instead and waits here for the
+// connection's callback: SENDPLUS once connected, ERROR on a reset. Only
+// one connection is made at a time.
+static SemaphoreHandle_t connectEvent = NULL;
+static struct netconn* connecting = NULL;
+
+static void onConnectEvent(struct netconn* conn, enum netconn_evt evt, u16_t) {
+  if (conn == connecting && (evt == NETCONN_EVT_SENDPLUS || evt == NETCONN_EVT_ERROR)) {
+    xSemaphoreGive(connectEvent);
+  }
+}
+
+NetconnClient::NetconnClient()
+    : conn(NULL), buf(NULL), data(NULL), dataLen(0), dataPos(0), closed(false),
+      timeoutMs(15000), connectTimeoutMs(15000), port(80), headerCount(0), contentLength(-1),
+      connectMs(0) {
+  host[0] = '\0';
+  path[0] = '\0';
+}
+
+NetconnClient::~NetconnClient() {
+  end();
+}
+
+/**
+ * Parse an http:// URL into host, port and path
+ */
+bool NetconnClient::begin(const char* url) {
+  if (strncmp(url, "http://", 7) != 0) {
+    LOG_E("netconn: only http:// URLs are supported");
+    return false;
+  }
+
+  const char* p = url + 7;
+  const char* slash = strchr(p, '/');
+  const char* colon = strchr(p, ':');
+  const char* hostEnd = slash ? slash : p + strlen(p);
+  if (colon && colon < hostEnd) {
+    port = (uint16_t)atoi(colon + 1);
+    hostEnd = colon;
+  }
+
+  const size_t hostLen = (size_t)(hostEnd - p);
+  if (hostLen == 0 || hostLen >= sizeof(host)) {
+    return false;
+  }
+  memcpy(host, p, hostLen);
+  host[hostLen] = '\0';
+  snprintf(path, sizeof(path), "%s", slash ? slash : "/");
+  return true;
+}
+
+void NetconnClient::addHeader(const String& name, const String& value) {
+  requestHeaders += name + ": " + value + "\r\n";
+}
+
+void NetconnClient::collectHeaders(const char* keys[], size_t count) {
+  headerCount = count < kMaxHeaders ? count : kMaxHeaders;
+  for (size_t i = 0; i < headerCount; i++) {
+    headerKeys[i] = keys[i];
+    headerValues[i] = "";
+  }
+}
+
+void NetconnClient::setTimeout(uint32_t ms) {
+  timeoutMs = ms;
+}
+
+void NetconnClient::setConnectTimeout(uint32_t ms) {
+  connectTimeoutMs = ms;
+}
+
+/**
+ * Resolve the host and connect, both within the connect timeout (as in
+ * WiFiClient::connect)
+ */
+bool NetconnClient::connectToHost() {
+  const uint32_t start = millis();
+  ip_addr_t addr;
+  if (netconn_gethostbyname(host, &addr) != ERR_OK) {
+    LOG_E("netconn: cannot resolve %s", host);
+    return false;
+  }
+
+  if (!connectEvent) {
+    connectEvent = xSemaphoreCreateBinary();
+    if (!connectEvent) {
+      return false;
+    }
+  }
+  conn = netconn_new_with_callback(NETCONN_TCP, onConnectEvent);
+  if (!conn) {
+    return false;
+  }
+
+  xSemaphoreTake(connectEvent, 0);    // left over from an earlier connection
+  connecting = conn;
+  netconn_set_nonblocking(conn, 1);
+  err_t err = netconn_connect(conn, &addr, port);
+  if (err == ERR_INPROGRESS) {
+    const uint32_t elapsed = millis() - start;
+    const uint32_t left = (elapsed < connectTimeoutMs) ? connectTimeoutMs - elapsed : 0;
+    err = (xSemaphoreTake(connectEvent, pdMS_TO_TICKS(left)) == pdTRUE) ? netconn_err(conn) : ERR_TIMEOUT;
+  }
+  connecting = NULL;
+  if (err != ERR_OK) {
+    LOG_E("netconn: connect to %s:%u failed (%d) after %u ms", host, port, err,
+          (unsigned)(millis() - start));
+    netconn_delete(conn);
+    conn = NULL;
+    return false;
+  }
+  netconn_set_nonblocking(conn, 0);
+  return true;
+}
+
+/**
+ * Connect, send the request and parse the response headers.
+ * Returns the HTTP status code, or a negative value on connection errors.
+ */
+int NetconnClient::GET() {
+  const uint32_t start = millis();
+  if (!connectToHost()) {
+    return -1;
+  }
+  netconn_set_recvtimeout(conn, (int)timeoutMs);
+  connectMs = millis() - start;
+
+  String request = String("GET ") + path + " HTTP/1.1\r\nHost: " + host + "\r\n" + requestHeaders + "\r\n";
+  if (netconn_write(conn, request.c_str(), request.length(), NETCONN_COPY) != ERR_OK) {
+    return -1;
+  }
+
+  char line[192];
+  if (!readHeaderLine(line, sizeof(line)) || strncmp(line, "HTTP/1.", 7) != 0) {
+    return -1;
+  }
+  const char* code = strchr(line, ' ');
+  const int status = code ? atoi(code + 1) : -1;
+
+  while (readHeaderLine(line, sizeof(line))) {
+    if (line[0] == '\0') {
+      return status;
+    }
+    char* colon = strchr(line, ':');
+    if (!colon) {
+      continue;
+    }
+    *colon = '\0';
+    const char* value = colon + 1;
+    while (*value == ' ') {
+      value++;
+    }
+
+    if (strcasecmp(line, "Content-Length") == 0) {
+      contentLength = atoi(value);
+    }
+    for (size_t i = 0; i < headerCount; i++) {
+      if (strcasecmp(line, headerKeys[i]) == 0) {
+        headerValues[i] = value;
+      }
+    }
+  }
+  return -1;
+}
+
+String NetconnClient::header(const char* name) {
+  for (size_t i = 0; i < headerCount; i++) {
+    if (strcasecmp(name, headerKeys[i]) == 0) {
+      return headerValues[i];
+    }
+  }
+  return String();
+}
+
+int NetconnClient::getSize() {
+  return contentLength;
+}
+
+String NetconnClient::getString() {
+  String body;
+  int c;
+  while (body.length() < 512 && (c = read()) >= 0) {
+    body += (char)c;
+  }
+  return body;
+}
+
+uint32_t NetconnClient::getConnectMs() {
+  return connectMs;
+}
+
+Stream* NetconnClient::getStreamPtr() {
+  return this;
+}
+
+void NetconnClient::end() {
+  releaseBuffer();
+  if (conn) {
+    netconn_close(conn);
+    netconn_delete(conn);
+    conn = NULL;
+  }
+}
+
+/**
+ * Make sure a fragment with unread bytes is current.
+ * Blocks in netconn_recv() (up to the receive timeout) when drained.
+ */
+bool NetconnClient::fill() {
+  while (!buf || dataPos >= dataLen) {
+    if (buf && netbuf_next(buf) >= 0) {
+      void* p;
+      netbuf_data(buf, &p, &dataLen);
+      data = (const uint8_t*)p;
+      dataPos = 0;
+      continue;
+    }
+    releaseBuffer();
+    if (closed || !conn || netconn_recv(conn, &buf) != ERR_OK) {
+      buf = NULL;
+      closed = true;
+      return false;
+    }
+    void* p;
+    netbuf_data(buf, &p, &dataLen);
+    data = (const uint8_t*)p;
+    dataPos = 0;
+  }
+  return true;
+}
+
+void NetconnClient::releaseBuffer() {
+  if (buf) {
+    netbuf_delete(buf);
+    buf = NULL;
+  }
+  data = NULL;
+  dataLen = 0;
+  dataPos = 0;
+}
+
+bool NetconnClient::readHeaderLine(char* line, size_t size) {
+  size_t n = 0;
+  while (fill()) {
+    const char c = (char)data[dataPos++];
+    if (c == '\n') {
+      if (n > 0 && line[n - 1] == '\r') {
+        n--;
+      }
+      line[n] = '\0';
+      return true;
+    }
+    if (n + 1 < size) {
+      line[n++] = c;
+    }
+  }
+  return false;
+}
+
+bool NetconnClient::writeBodyToPanel(UDOUBLE len) {
+  const uint32_t start = millis();
+  const UDOUBLE total = len;
+
+  // The bus changes hands; keep the controller deselected meanwhile so
+  // the pin switch-over cannot clock in stray bits. Deselecting does not
+  // end the data phase: the Waveshare driver this one replaced raised CS
+  // after every byte of DTM data (SendData), and its frames displayed
+  // correctly. Not yet tried with the DMA switch-over on hardware.
+  DEV_Digital_Write(EPD_CS_PIN, 1);
+  if (!DEV_SPI_DMA_Begin()) {
+    DEV_Digital_Write(EPD_CS_PIN, 0);
+    return false;
+  }
+  DEV_Digital_Write(EPD_CS_PIN, 0);
+
+  bool ok = true;
+  while (len > 0) {
+    if (!fill()) {
+      LOG_E("netconn: body ended with %u bytes left", len);
+      ok = false;
+      break;
+    }
+
+    // Queue every fragment of this netbuf straight from its pbuf payload.
+    // Ownership moves to the DMA queue: the last fragment carries the
+    // netbuf, which is deleted when that transfer is reported done.
+    struct netbuf* owned = buf;
+    buf = NULL;
+    while (len > 0) {
+      UDOUBLE n = dataLen - dataPos;
+      if (n > len) {
+        n = len;
+      }
+      const bool last = (netbuf_next(owned) < 0) || (n == len);
+      while (DEV_SPI_DMA_InFlight() >= DEV_SPI_DMA_QUEUE) {
+        struct netbuf* done = (struct netbuf*)DEV_SPI_DMA_WaitOne();
+        if (done) {
+          netbuf_delete(done);
+        }
+      }
+      if (!DEV_SPI_DMA_Queue(data + dataPos, n, last ? owned : NULL)) {
+        ok = false;
+        break;
+      }
+      len -= n;
+      if (last) {
+        owned = NULL;
+        break;
+      }
+      void* p;
+      netbuf_data(owned, &p, &dataLen);
+      data = (const uint8_t*)p;
+      dataPos = 0;
+    }
+    if (owned) {
+      netbuf_delete(owned); // only on a queueing error, nothing of it in flight
+    }
+    data = NULL;
+    dataLen = 0;
+    dataPos = 0;
+    if (!ok) {
+      break;
+    }
+  }
+
+  while (DEV_SPI_DMA_InFlight() > 0) {
+    struct netbuf* done = (struct netbuf*)DEV_SPI_DMA_WaitOne();
+    if (done) {
+      netbuf_delete(done);
+    }
+  }
+  DEV_Digital_Write(EPD_CS_PIN, 1);
+  DEV_SPI_DMA_End();
+  DEV_Digital_Write(EPD_CS_PIN, 0);
+
+  LOG_I("netconn: %u body bytes to panel by DMA in %u ms",
+        total - len, (unsigned)(millis() - start));
+  return ok;
+}
+
+int NetconnClient::available() {
+  if (buf && dataPos < dataLen) {
+    return dataLen - dataPos;
+  }
+  return 0;
+}
+
+int NetconnClient::read() {
+  if (!fill()) {
+    return -1;
+  }
+  return data[dataPos++];
+}
+
+int NetconnClient::peek() {
+  if (!fill()) {
+    return -1;
+  }
+  return data[dataPos];
+}
+
+size_t NetconnClient::readBytes(char* buffer, size_t length) {
+  size_t got = 0;
+  while (got < length && fill()) {
+    size_t n = dataLen - dataPos;
+    if (n > length - got) {
+      n = length - got;
+    }
+    memcpy(buffer + got, data + dataPos, n);
+    dataPos += n;
+    got += n;
+  }
+  return got;
+}
+
+size_t NetconnClient::write(uint8_t) {
+  return 0;
+}
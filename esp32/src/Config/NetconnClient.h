@@ -0,0 +1,90 @@
+#ifndef _NETCONN_CLIENT_H_
+#define _NETCONN_CLIENT_H_
+
+#include <Arduino.h>
+#include "DEV_Config.h"
+
+struct netconn;
+struct netbuf;
+
+/**
+ * Minimal HTTP/1.1 GET client on the lwIP netconn API.
+ *
+ * Mirrors the part of HTTPClient that ImageDownloader uses, so it can be
+ * swapped in with FRAME_RECEIVE_NETCONN. The response body is read from the
+ * received netbufs in place: as a Stream it is copied once (into the caller's
+ * buffer), and writeBodyToPanel() queues the pbuf payloads to SPI DMA without
+ * any copy, releasing each netbuf once its transfers have completed.
+ * Receive timeouts are handled by lwIP (SO_RCVTIMEO), not by polling; the
+ * connect is non-blocking and bounded by setConnectTimeout().
+ */
+class NetconnClient : public Stream {
+public:
+  NetconnClient();
+  ~NetconnClient();
+
+  bool begin(const char* url);
+  void addHeader(const String& name, const String& value);
+  void collectHeaders(const char* headerKeys[], size_t count);
+  void setTimeout(uint32_t timeoutMs);
+
+  /**
+   * Give up on GET() if resolving the host and connecting take longer
+   */
+  void setConnectTimeout(uint32_t timeoutMs);
+  int GET();
+  String header(const char* name);
+  int getSize();
+  String getString();
+  Stream* getStreamPtr();
+  void end();
+
+  /**
+   * @return time the last GET() took to resolve the host and connect, in ms
+   */
+  uint32_t getConnectMs();
+
+  /**
+   * Send the next len body bytes to the panel data phase by SPI DMA.
+   * CS must be low and DC high (frame data phase open) on entry; both are
+   * left that way on return.
+   */
+  bool writeBodyToPanel(UDOUBLE len);
+
+  // Stream
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  size_t write(uint8_t) override;
+
+private:
+  static const int kMaxHeaders = 4;
+
+  bool connectToHost();
+  bool fill();
+  void releaseBuffer();
+  bool readHeaderLine(char* line, size_t size);
+
+  struct netconn* conn;
+  struct netbuf* buf;     // netbuf being read, NULL when drained
+  const uint8_t* data;    // current fragment of buf
+  uint16_t dataLen;
+  uint16_t dataPos;
+  bool closed;
+
+  uint32_t timeoutMs;
+  uint32_t connectTimeoutMs;
+  char host[64];
+  uint16_t port;
+  char path[160];
+  String requestHeaders;
+
+  const char* headerKeys[kMaxHeaders];
+  String headerValues[kMaxHeaders];
+  size_t headerCount;
+  int32_t contentLength;
+  uint32_t connectMs;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "ServerRanking.h"
+#include "Debug.h"
+
+// Health is a failure-weighted success rate: 255 = every recent attempt
+// succeeded. Both it and the connect time move a quarter of the way
+// towards each new sample, so a few wakes are enough to re-rank.
+struct ServerStat {
+  uint32_t urlHash;   // 0 = slot unused
+  uint16_t connectMs;
+  uint8_t health;
+  uint8_t attempts;
+};
+
+RTC_DATA_ATTR static ServerStat serverStats[MAX_SERVER_URLS];
+
+static uint32_t hashUrl(const char* url) {
+  // FNV-1a; 0 is reserved for unused slots
+  uint32_t h = 2166136261u;
+  while (*url) {
+    h = (h ^ (uint8_t)*url++) * 16777619u;
+  }
+  return h ? h : 1;
+}
+
+/**
+ * Stats for the server at index, reset if that position has a new URL
+ */
+static ServerStat* statFor(uint8_t index, const char* url) {
+  ServerStat* s = &serverStats[index];
+  const uint32_t h = hashUrl(url);
+  if (s->urlHash != h) {
+    s->urlHash = h;
+    s->connectMs = 0;
+    s->health = 255;
+    s->attempts = 0;
+  }
+  return s;
+}
+
+void ServerRanking_Order(const char* const urls[], uint8_t count, uint8_t* order, uint32_t budgetMs) {
+  uint32_t score[MAX_SERVER_URLS];
+  if (count > MAX_SERVER_URLS) {
+    count = MAX_SERVER_URLS;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    const ServerStat* s = statFor(i, urls[i]);
+    // Never tried: rank by configured order, between good and bad servers
+    const uint32_t connectMs = s->attempts ? s->connectMs : budgetMs / 4;
+    score[i] = connectMs + (uint32_t)(255 - s->health) * budgetMs / 255;
+
+    // Insertion sort; equal scores keep the configured order
+    uint8_t j = i;
+    while (j > 0 && score[order[j - 1]] > score[i]) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = i;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    const ServerStat* s = &serverStats[order[i]];
+    LOG_I("Server %u: %s (score %u, connect %u ms, health %u/255, %u attempts)",
+          i + 1, urls[order[i]], score[order[i]], s->connectMs, s->health, s->attempts);
+  }
+}
+
+void ServerRanking_Report(uint8_t index, const char* url, bool ok, uint32_t connectMs) {
+  if (index >= MAX_SERVER_URLS) {
+    return;
+  }
+  ServerStat* s = statFor(index, url);
+  if (connectMs > 0xFFFF) {
+    connectMs = 0xFFFF;
+  }
+
+  if (s->attempts == 0) {
+    s->connectMs = (uint16_t)connectMs;
+  } else {
+    s->connectMs = (uint16_t)((3u * s->connectMs + connectMs) / 4);
+  }
+  if (ok) {
+    s->health = (uint8_t)(s->health + (255 - s->health + 3) / 4);
+  } else {
+    s->health = (uint8_t)(s->health - (s->health + 3) / 4);
+  }
+  if (s->attempts < 255) {
+    s->attempts++;
+  }
+}
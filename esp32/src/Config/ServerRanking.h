@@ -0,0 +1,38 @@
+#ifndef _SERVER_RANKING_H_
+#define _SERVER_RANKING_H_
+
+#include <Arduino.h>
+
+// Most server URLs that can be configured and ranked
+#define MAX_SERVER_URLS 4
+
+/**
+ * Order in which to try the configured servers.
+ *
+ * Connect latency and success history per server are kept in RTC memory
+ * across deep sleep. Each server is scored by its average connect time plus
+ * a penalty for recent failures, and the cheapest is tried first, so a
+ * server that is down stops costing a connect timeout on every wake while
+ * it still gets retried once the others look worse. Servers are tracked by
+ * their position in the list; changing the URL at a position resets it.
+ */
+
+/**
+ * @param urls     Configured server URLs, in preference order
+ * @param count    Number of URLs (at most MAX_SERVER_URLS)
+ * @param order    Receives the indices into urls, best first
+ * @param budgetMs Connect budget per attempt, used as the failure penalty
+ */
+void ServerRanking_Order(const char* const urls[], uint8_t count, uint8_t* order, uint32_t budgetMs);
+
+/**
+ * Record the outcome of one attempt
+ *
+ * @param index     Index of the server in the configured list
+ * @param url       Its URL
+ * @param ok        true if it delivered a response
+ * @param connectMs Time to connect, or the whole budget when it failed to
+ */
+void ServerRanking_Report(uint8_t index, const char* url, bool ok, uint32_t connectMs);
+
+#endif
@@ -0,0 +1,87 @@
+#include "Telemetry.h"
+#include "Debug.h"
+#include "ImageDownloader.h"
+#include "MemProbe.h"
+#include "TlsSessionClient.h"
+
+// Copy of the log lines being uploaded; static to keep it off the stack
+static char uploadLog[LOG_RING_SIZE];
+
+/**
+ * Append s as a quoted JSON string
+ */
+static void appendJsonString(String& out, const char* s, size_t len) {
+  out += '"';
+  for (size_t i = 0; i < len; i++) {
+    const char c = s[i];
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if ((uint8_t)c < 0x20) {
+      char esc[8];
+      snprintf(esc, sizeof(esc), "\\u%04x", (unsigned)(uint8_t)c);
+      out += esc;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+bool Telemetry_Upload(const char* serverUrl) {
+  if (!serverUrl || strlen(serverUrl) == 0) {
+    return false;
+  }
+
+  uint32_t mark = 0;
+  const size_t logLen = Log_CopyForUpload(uploadLog, sizeof(uploadLog), &mark);
+
+  const uint64_t mac = ESP.getEfuseMac();
+  char head[160];
+  snprintf(head, sizeof(head),
+           "{\"device\":\"%02x%02x%02x%02x%02x%02x\",\"wake\":%u,\"uptimeMs\":%lu,\"droppedBytes\":%u,\"log\":",
+           (uint8_t)mac, (uint8_t)(mac >> 8), (uint8_t)(mac >> 16),
+           (uint8_t)(mac >> 24), (uint8_t)(mac >> 32), (uint8_t)(mac >> 40),
+           Log_WakeCount(), (unsigned long)millis(), Log_DroppedBytes());
+
+  String body;
+  body.reserve(strlen(head) + logLen + logLen / 8 + 1536);
+  body += head;
+  appendJsonString(body, uploadLog, logLen);
+  // Marked last so the sample includes the log copy in body
+  MemProbe_Mark("telemetry");
+  body += ",\"memory\":";
+  MemProbe_AppendJson(body);
+  body += '}';
+
+  char url[256];
+  snprintf(url, sizeof(url), "%s/esp32/telemetry", serverUrl);
+
+  // Declared before http: HTTPClient stops its client when destroyed
+  TlsSessionClient tls;
+  HTTPClient http;
+  http.setConnectTimeout(SERVER_CONNECT_BUDGET_MS);
+  http.setTimeout(5000);
+  const bool begun = (strncmp(url, "https://", 8) == 0) ? http.begin(tls, url) : http.begin(url);
+  if (!begun) {
+    return false;
+  }
+  http.addHeader("Content-Type", "application/json");
+  if (strlen(TELEMETRY_TOKEN) > 0) {
+    http.addHeader("Authorization", String("Bearer ") + TELEMETRY_TOKEN);
+  }
+
+  const uint32_t start = millis();
+  const int code = http.POST((uint8_t*)body.c_str(), body.length());
+  http.end();
+
+  if (code < 200 || code >= 300) {
+    LOG_W("Telemetry upload failed with code %d", code);
+    return false;
+  }
+  Log_MarkUploaded(mark);
+  LOG_I("Telemetry: %u log bytes uploaded in %u ms", (unsigned)logLen, (unsigned)(millis() - start));
+  return true;
+}
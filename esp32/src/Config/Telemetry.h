@@ -0,0 +1,23 @@
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <Arduino.h>
+
+// Sent as "Authorization: Bearer <token>" if the server sets
+// ESP32_TELEMETRY_TOKEN; empty sends no header.
+#define TELEMETRY_TOKEN ""
+
+/**
+ * Upload the buffered log lines to POST /esp32/telemetry as JSON:
+ *   {"device": "<mac hex>", "wake": n, "uptimeMs": n, "droppedBytes": n,
+ *    "log": "<lines>", "memory": {...}}
+ * with "memory" as described at MemProbe_AppendJson().
+ * Lines are only marked as uploaded once the server answers 2xx, so a
+ * failed upload is retried with the next one.
+ *
+ * @param serverUrl Base URL of the server, http:// or https://
+ * @return true if the server accepted the upload
+ */
+bool Telemetry_Upload(const char* serverUrl);
+
+#endif
@@ -0,0 +1,342 @@
+#include "TlsSessionClient.h"
+#include "Debug.h"
+#include <mbedtls/ssl.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/x509_crt.h>
+#include <mbedtls/error.h>
+#include <lwip/sockets.h>
+
+#define TLS_DEFAULT_TIMEOUT_MS 15000
+
+struct TlsSessionState {
+  mbedtls_ssl_context ssl;
+  mbedtls_ssl_config conf;
+  mbedtls_entropy_context entropy;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_x509_crt cert;
+  mbedtls_net_context net;
+  char host[64];
+  uint16_t port;
+  bool established;
+};
+
+// The last negotiated session, kept across deep sleep for the next wake
+RTC_DATA_ATTR static char cachedHost[64] = {0};
+RTC_DATA_ATTR static uint16_t cachedPort = 0;
+RTC_DATA_ATTR static uint16_t cachedSessionLen = 0;
+RTC_DATA_ATTR static uint8_t cachedSession[TLS_SESSION_CACHE_SIZE];
+
+static void logTlsError(const char* what, int ret) {
+  char msg[96];
+  mbedtls_strerror(ret, msg, sizeof(msg));
+  LOG_E("TLS: %s failed: -0x%04x %s", what, (unsigned)-ret, msg);
+}
+
+TlsSessionClient::TlsSessionClient(const char* serverCertPem)
+    : serverCertPem(serverCertPem), tls(NULL), peeked(-1) {
+}
+
+TlsSessionClient::~TlsSessionClient() {
+  stop();
+}
+
+void TlsSessionClient::clearSessionCache() {
+  cachedSessionLen = 0;
+  cachedHost[0] = '\0';
+}
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip.toString().c_str(), port, TLS_DEFAULT_TIMEOUT_MS);
+}
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+  return connect(ip.toString().c_str(), port, timeoutMs);
+}
+
+int TlsSessionClient::connect(const char* host, uint16_t port) {
+  return connect(host, port, TLS_DEFAULT_TIMEOUT_MS);
+}
+
+int TlsSessionClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+  stop();
+  if (!WiFiClient::connect(host, port, timeoutMs)) {
+    return 0;
+  }
+  setNoDelay(true);
+  // The budget is for the TCP connect; a full handshake (no session to
+  // resume) needs seconds of public key math on the ESP32.
+  const uint32_t handshakeMs = timeoutMs > TLS_DEFAULT_TIMEOUT_MS ? (uint32_t)timeoutMs : TLS_DEFAULT_TIMEOUT_MS;
+  if (!handshake(host, port, handshakeMs)) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * Set up mbedTLS on the connected socket and run the handshake, offering the
+ * cached session when it belongs to the same server
+ */
+bool TlsSessionClient::handshake(const char* host, uint16_t port, uint32_t timeoutMs) {
+  tls = (TlsSessionState*)calloc(1, sizeof(TlsSessionState));
+  if (!tls) {
+    LOG_E("TLS: out of memory");
+    return false;
+  }
+  mbedtls_ssl_init(&tls->ssl);
+  mbedtls_ssl_config_init(&tls->conf);
+  mbedtls_entropy_init(&tls->entropy);
+  mbedtls_ctr_drbg_init(&tls->drbg);
+  mbedtls_x509_crt_init(&tls->cert);
+  mbedtls_net_init(&tls->net);
+  tls->net.fd = fd();
+  snprintf(tls->host, sizeof(tls->host), "%s", host);
+  tls->port = port;
+
+  int ret = mbedtls_ctr_drbg_seed(&tls->drbg, mbedtls_entropy_func, &tls->entropy, NULL, 0);
+  if (ret != 0) {
+    logTlsError("RNG seed", ret);
+    return false;
+  }
+
+  ret = mbedtls_ssl_config_defaults(&tls->conf, MBEDTLS_SSL_IS_CLIENT,
+                                    MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+  if (ret != 0) {
+    logTlsError("config", ret);
+    return false;
+  }
+
+  if (serverCertPem) {
+    // PEM parsing needs the terminating NUL counted in the length
+    ret = mbedtls_x509_crt_parse(&tls->cert, (const unsigned char*)serverCertPem, strlen(serverCertPem) + 1);
+    if (ret != 0) {
+      logTlsError("server certificate", ret);
+      return false;
+    }
+    mbedtls_ssl_conf_ca_chain(&tls->conf, &tls->cert, NULL);
+    mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+  } else {
+#ifdef TLS_ALLOW_INSECURE
+    LOG_W("TLS: no server certificate configured, %s is not authenticated", host);
+    mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_NONE);
+#else
+    LOG_E("TLS: no server certificate configured (TLS_SERVER_CERT_PEM), refusing %s", host);
+    return false;
+#endif
+  }
+  mbedtls_ssl_conf_rng(&tls->conf, mbedtls_ctr_drbg_random, &tls->drbg);
+  mbedtls_ssl_conf_read_timeout(&tls->conf, timeoutMs);
+  mbedtls_ssl_conf_session_tickets(&tls->conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+
+  ret = mbedtls_ssl_setup(&tls->ssl, &tls->conf);
+  if (ret == 0) {
+    ret = mbedtls_ssl_set_hostname(&tls->ssl, host);
+  }
+  if (ret != 0) {
+    logTlsError("setup", ret);
+    return false;
+  }
+  mbedtls_ssl_set_bio(&tls->ssl, &tls->net, mbedtls_net_send, NULL, mbedtls_net_recv_timeout);
+
+  // A session that does not load (e.g. written by another mbedTLS build)
+  // just means a full handshake.
+  bool offered = false;
+  if (cachedSessionLen > 0 && cachedPort == port && strcmp(cachedHost, host) == 0) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    offered = mbedtls_ssl_session_load(&session, cachedSession, cachedSessionLen) == 0 &&
+              mbedtls_ssl_set_session(&tls->ssl, &session) == 0;
+    mbedtls_ssl_session_free(&session);
+    if (!offered) {
+      clearSessionCache();
+    }
+  }
+
+  const uint32_t start = millis();
+  while ((ret = mbedtls_ssl_handshake(&tls->ssl)) != 0) {
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      logTlsError("handshake", ret);
+      if (offered) {
+        clearSessionCache(); // do not offer it again if it was the cause
+      }
+      return false;
+    }
+    if (millis() - start > timeoutMs) {
+      LOG_E("TLS: handshake timed out");
+      return false;
+    }
+    delay(1);
+  }
+
+  // An accepted session shows as a much shorter handshake here and as
+  // "resumed" in the server log.
+  LOG_I("TLS: %s handshake with %s:%u in %u ms (%s, %s)",
+        offered ? "resumption" : "full", host, port, (unsigned)(millis() - start),
+        mbedtls_ssl_get_version(&tls->ssl), mbedtls_ssl_get_ciphersuite(&tls->ssl));
+
+  tls->established = true;
+  return true;
+}
+
+/**
+ * Serialize the negotiated session (with the server's ticket, if it sent
+ * one) into RTC memory. Done when the connection ends rather than right
+ * after the handshake: TLS 1.3 servers send their tickets afterwards.
+ */
+void TlsSessionClient::saveSession() {
+  const char* host = tls->host;
+  const uint16_t port = tls->port;
+  if (strlen(host) >= sizeof(cachedHost) - 1) {
+    return; // possibly truncated, would never match
+  }
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+  size_t len = 0;
+  int ret = mbedtls_ssl_get_session(&tls->ssl, &session);
+  if (ret == 0) {
+    ret = mbedtls_ssl_session_save(&session, cachedSession, sizeof(cachedSession), &len);
+  }
+  mbedtls_ssl_session_free(&session);
+
+  if (ret != 0) {
+    clearSessionCache();
+    if (ret == MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL) {
+      LOG_W("TLS: session needs %u bytes, cache has %u; not cached",
+            (unsigned)len, (unsigned)sizeof(cachedSession));
+    } else {
+      logTlsError("session save", ret);
+    }
+    return;
+  }
+  strcpy(cachedHost, host);
+  cachedPort = port;
+  cachedSessionLen = (uint16_t)len;
+}
+
+void TlsSessionClient::release() {
+  if (!tls) {
+    return;
+  }
+  mbedtls_ssl_free(&tls->ssl);
+  mbedtls_ssl_config_free(&tls->conf);
+  mbedtls_ctr_drbg_free(&tls->drbg);
+  mbedtls_entropy_free(&tls->entropy);
+  mbedtls_x509_crt_free(&tls->cert);
+  free(tls);
+  tls = NULL;
+}
+
+void TlsSessionClient::stop() {
+  if (tls && tls->established) {
+    saveSession();
+    mbedtls_ssl_close_notify(&tls->ssl);
+  }
+  release();
+  peeked = -1;
+  WiFiClient::stop();
+}
+
+uint8_t TlsSessionClient::connected() {
+  if (!tls) {
+    return 0;
+  }
+  return (peeked >= 0 || mbedtls_ssl_get_bytes_avail(&tls->ssl) > 0 || WiFiClient::connected()) ? 1 : 0;
+}
+
+size_t TlsSessionClient::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+size_t TlsSessionClient::write(const uint8_t* buf, size_t size) {
+  if (!tls) {
+    return 0;
+  }
+  size_t sent = 0;
+  while (sent < size) {
+    const int ret = mbedtls_ssl_write(&tls->ssl, buf + sent, size - sent);
+    if (ret > 0) {
+      sent += ret;
+    } else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      logTlsError("write", ret);
+      break;
+    }
+  }
+  return sent;
+}
+
+/**
+ * Decrypted bytes ready without blocking. A record that has only arrived
+ * at the socket is decrypted first.
+ */
+int TlsSessionClient::available() {
+  if (!tls) {
+    return 0;
+  }
+  int avail = (int)mbedtls_ssl_get_bytes_avail(&tls->ssl);
+  if (avail == 0) {
+    uint8_t probe;
+    if (recv(tls->net.fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT) > 0) {
+      mbedtls_ssl_read(&tls->ssl, NULL, 0);
+      avail = (int)mbedtls_ssl_get_bytes_avail(&tls->ssl);
+    }
+  }
+  return avail + (peeked >= 0 ? 1 : 0);
+}
+
+int TlsSessionClient::read(uint8_t* buf, size_t size) {
+  if (!tls || size == 0) {
+    return -1;
+  }
+  size_t got = 0;
+  if (peeked >= 0) {
+    buf[got++] = (uint8_t)peeked;
+    peeked = -1;
+    if (got == size) {
+      return (int)got;
+    }
+  }
+  // Blocks for at most the read timeout (mbedtls_net_recv_timeout)
+  const int ret = mbedtls_ssl_read(&tls->ssl, buf + got, size - got);
+  if (ret > 0) {
+    return (int)got + ret;
+  }
+  if (ret != 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_TIMEOUT &&
+      ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+    logTlsError("read", ret);
+  }
+  return got > 0 ? (int)got : -1;
+}
+
+int TlsSessionClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+/**
+ * Read exactly length bytes unless the connection ends or stalls for the
+ * read timeout, like Stream::readBytes()
+ */
+size_t TlsSessionClient::readBytes(char* buffer, size_t length) {
+  size_t got = 0;
+  while (got < length) {
+    const int n = read((uint8_t*)buffer + got, length - got);
+    if (n <= 0) {
+      break;
+    }
+    got += n;
+  }
+  return got;
+}
+
+int TlsSessionClient::peek() {
+  if (peeked < 0) {
+    peeked = read();
+  }
+  return peeked;
+}
+
+void TlsSessionClient::flush() {
+}
@@ -0,0 +1,81 @@
+#ifndef _TLS_SESSION_CLIENT_H_
+#define _TLS_SESSION_CLIENT_H_
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Room for one serialized TLS session in RTC slow memory. A session carries
+// the server certificate, so an ECDSA certificate (~500 bytes) fits easily;
+// a large RSA chain may not, and then every wake does a full handshake.
+#define TLS_SESSION_CACHE_SIZE 1536
+
+// The server's (self-signed) certificate, or the CA that signed it, in PEM.
+// https:// connections for frames and telemetry are verified against it.
+// #define TLS_SERVER_CERT_PEM "-----BEGIN CERTIFICATE-----\n...\n-----END CERTIFICATE-----\n"
+
+// Without a certificate https:// connections are refused. Define this to
+// accept any certificate instead: still encrypted, but anyone who can
+// intercept the connection can pose as the server.
+// #define TLS_ALLOW_INSECURE
+
+#ifdef TLS_SERVER_CERT_PEM
+#define TLS_DEFAULT_CERT_PEM TLS_SERVER_CERT_PEM
+#else
+#define TLS_DEFAULT_CERT_PEM NULL
+#endif
+
+struct TlsSessionState;
+
+/**
+ * HTTPS transport for HTTPClient::begin(client, url) on mbedTLS.
+ *
+ * The TCP connection is WiFiClient's; TLS runs on its socket. When a
+ * connection ends, its session (ID and ticket) is serialized into
+ * RTC_DATA_ATTR memory, and the next connection to the same host:port,
+ * also after deep sleep, offers it back. A server that accepts it skips the
+ * certificate exchange and key agreement: an abbreviated handshake of one
+ * round trip and no public key operations on the ESP32.
+ */
+class TlsSessionClient : public WiFiClient {
+public:
+  /**
+   * @param serverCertPem PEM certificate (or CA) the server must present,
+   *        e.g. a self-signed server.crt. With NULL the handshake fails,
+   *        unless TLS_ALLOW_INSECURE accepts any certificate: the
+   *        connection is then encrypted but not authenticated.
+   */
+  explicit TlsSessionClient(const char* serverCertPem = TLS_DEFAULT_CERT_PEM);
+  ~TlsSessionClient();
+
+  int connect(IPAddress ip, uint16_t port);
+  int connect(IPAddress ip, uint16_t port, int32_t timeoutMs);
+  int connect(const char* host, uint16_t port);
+  int connect(const char* host, uint16_t port, int32_t timeoutMs);
+
+  size_t write(uint8_t b);
+  size_t write(const uint8_t* buf, size_t size);
+  int available();
+  int read();
+  int read(uint8_t* buf, size_t size);
+  size_t readBytes(char* buffer, size_t length);
+  int peek();
+  void flush();
+  void stop();
+  uint8_t connected();
+
+  /**
+   * Forget the cached session, e.g. after the server certificate changed
+   */
+  static void clearSessionCache();
+
+private:
+  bool handshake(const char* host, uint16_t port, uint32_t timeoutMs);
+  void saveSession();
+  void release();
+
+  const char* serverCertPem;
+  TlsSessionState* tls;  // mbedTLS contexts, heap allocated while connected
+  int peeked;            // byte read ahead by peek(), -1 if none
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "WiFiConfig.h"
+#include "Debug.h"
 
 DNSServer dnsServer;
 WebServer server(80);
@@ -98,8 +99,8 @@ const char* CAPTIVE_PORTAL_HTML = "<!DOCTYPE html>\n"
 "        <input type=\"password\" id=\"password\" name=\"password\">\n"
 "      </div>\n"
 "      <div class=\"form-group\">\n"
-"        <label for=\"server\">Server URL:</label>\n"
-"        <input type=\"url\" id=\"server\" name=\"server\" placeholder=\"http://192.168.1.100:3000\" required>\n"
+"        <label for=\"server\">Server URL (several: comma separated, preferred first):</label>\n"
+"        <input type=\"text\" id=\"server\" name=\"server\" placeholder=\"http://192.168.1.100:3000\" required>\n"
 "      </div>\n"
 "      <button type=\"submit\">Connect</button>\n"
 "    </form>\n"
@@ -145,10 +146,10 @@ const char* CAPTIVE_PORTAL_HTML = "<!DOCTYPE html>\n"
 // Initialize SPIFFS
 bool initSPIFFS() {
   if (!SPIFFS.begin(true)) {
-    Serial.println("SPIFFS Mount Failed");
+    LOG_E("SPIFFS Mount Failed");
     return false;
   }
-  Serial.println("SPIFFS mounted successfully");
+  LOG_I("SPIFFS mounted successfully");
   return true;
 }
 
@@ -160,51 +161,51 @@ void saveWiFiCredentials(const char* ssid, const char* password) {
 
   File configFile = SPIFFS.open(WIFI_CONFIG_FILE, "w");
   if (!configFile) {
-    Serial.println("Failed to open config file for writing");
+    LOG_E("Failed to open config file for writing");
     return;
   }
 
   serializeJson(doc, configFile);
   configFile.close();
-  Serial.println("WiFi credentials saved");
+  LOG_I("WiFi credentials saved");
 }
 
 // Load WiFi credentials from SPIFFS
 bool loadWiFiCredentials(char* ssid, char* password) {
   if (!SPIFFS.exists(WIFI_CONFIG_FILE)) {
-    Serial.println("Config file does not exist");
+    LOG_W("Config file does not exist");
     return false;
   }
 
   File configFile = SPIFFS.open(WIFI_CONFIG_FILE, "r");
   if (!configFile) {
-    Serial.println("Failed to open config file");
+    LOG_E("Failed to open config file");
     return false;
   }
 
-  DynamicJsonDocument doc(256);
+  DynamicJsonDocument doc(2048);
   DeserializationError error = deserializeJson(doc, configFile);
   configFile.close();
 
   if (error) {
-    Serial.println("Failed to parse config file");
+    LOG_E("Failed to parse config file");
     return false;
   }
 
   if (!doc.containsKey("ssid") || !doc.containsKey("password")) {
-    Serial.println("Config file missing required fields");
+    LOG_E("Config file missing required fields");
     return false;
   }
 
   strcpy(ssid, doc["ssid"].as<const char*>());
   strcpy(password, doc["password"].as<const char*>());
-  Serial.println("WiFi credentials loaded");
+  LOG_I("WiFi credentials loaded");
   return true;
 }
 
 // Save server URL
 void saveServerUrl(const char* url) {
-  DynamicJsonDocument doc(512);
+  DynamicJsonDocument doc(2048);
   
   // Load existing WiFi config if it exists
   if (SPIFFS.exists(WIFI_CONFIG_FILE)) {
@@ -215,17 +216,37 @@ void saveServerUrl(const char* url) {
     }
   }
   
-  doc["server_url"] = url;
+  // Split "url1, url2, ..." into the failover list
+  JsonArray urls = doc.createNestedArray("server_urls");
+  const char* p = url;
+  while (*p && urls.size() < MAX_SERVER_URLS) {
+    while (*p == ',' || *p == ' ') {
+      p++;
+    }
+    size_t len = strcspn(p, ", ");
+    if (len == 0) {
+      break;
+    }
+    if (len >= SERVER_URL_LENGTH) {
+      len = SERVER_URL_LENGTH - 1;
+    }
+    char one[SERVER_URL_LENGTH];
+    memcpy(one, p, len);
+    one[len] = '\0';
+    urls.add(one);
+    p += strcspn(p, ", ");
+  }
+  doc["server_url"] = urls.size() > 0 ? urls[0].as<const char*>() : url;
 
   File configFile = SPIFFS.open(WIFI_CONFIG_FILE, "w");
   if (!configFile) {
-    Serial.println("Failed to open config file for writing");
+    LOG_E("Failed to open config file for writing");
     return;
   }
 
   serializeJson(doc, configFile);
   configFile.close();
-  Serial.println("Server URL saved");
+  LOG_I("Server URL saved");
 }
 
 // Load server URL
@@ -239,7 +260,7 @@ bool loadServerUrl(char* url) {
     return false;
   }
 
-  DynamicJsonDocument doc(512);
+  DynamicJsonDocument doc(2048);
   DeserializationError error = deserializeJson(doc, configFile);
   configFile.close();
 
@@ -255,6 +276,42 @@ bool loadServerUrl(char* url) {
   return true;
 }
 
+// Load the failover list of server URLs
+uint8_t loadServerUrls(char urls[][SERVER_URL_LENGTH], uint8_t maxUrls) {
+  if (!SPIFFS.exists(WIFI_CONFIG_FILE)) {
+    return 0;
+  }
+
+  File configFile = SPIFFS.open(WIFI_CONFIG_FILE, "r");
+  if (!configFile) {
+    return 0;
+  }
+
+  DynamicJsonDocument doc(2048);
+  DeserializationError error = deserializeJson(doc, configFile);
+  configFile.close();
+
+  if (error) {
+    return 0;
+  }
+
+  uint8_t count = 0;
+  JsonArray list = doc["server_urls"].as<JsonArray>();
+  for (JsonVariant v : list) {
+    const char* url = v.as<const char*>();
+    if (count < maxUrls && url && strlen(url) > 0 && strlen(url) < SERVER_URL_LENGTH) {
+      strcpy(urls[count++], url);
+    }
+  }
+
+  // Configs saved before the list existed only have server_url
+  if (count == 0 && maxUrls > 0 && doc.containsKey("server_url")) {
+    strlcpy(urls[0], doc["server_url"].as<const char*>(), SERVER_URL_LENGTH);
+    count = 1;
+  }
+  return count;
+}
+
 // Handle root path during captive portal
 void handleRoot() {
   server.send(200, "text/html", CAPTIVE_PORTAL_HTML);
@@ -272,7 +329,7 @@ void handleConnect() {
     return;
   }
 
-  DynamicJsonDocument doc(512);
+  DynamicJsonDocument doc(1024);
   DeserializationError error = deserializeJson(doc, server.arg("plain"));
 
   if (error) {
@@ -302,7 +359,7 @@ void handleConnect() {
 
 // Start captive portal
 void startCaptivePortal() {
-  Serial.println("Starting Captive Portal...");
+  LOG_I("Starting Captive Portal...");
   captivePortalActive = true;
 
   // Stop any existing WiFi first
@@ -316,16 +373,15 @@ void startCaptivePortal() {
   // Start soft AP
   bool apStarted = WiFi.softAP("E-Paper Setup", "");
   if (!apStarted) {
-    Serial.println("Failed to start soft AP");
+    LOG_E("Failed to start soft AP");
     return;
   }
 
-  Serial.print("Soft AP IP: ");
-  Serial.println(WiFi.softAPIP());
+  LOG_I("Soft AP IP: %s", WiFi.softAPIP().toString().c_str());
 
   // Setup DNS server for all domains point to ESP32
   if (!dnsServer.start(DNS_PORT, "*", WiFi.softAPIP())) {
-    Serial.println("Failed to start DNS server");
+    LOG_E("Failed to start DNS server");
     return;
   }
 
@@ -337,7 +393,7 @@ void startCaptivePortal() {
   server.onNotFound(handleRoot);
 
   server.begin();
-  Serial.println("Captive Portal started. Connect to 'E-Paper Setup' network");
+  LOG_I("Captive Portal started. Connect to 'E-Paper Setup' network");
 }
 
 // Connect to WiFi
@@ -346,13 +402,12 @@ bool connectToWiFi() {
   char password[WIFI_PASSWORD_LENGTH] = {0};
 
   if (!loadWiFiCredentials(ssid, password)) {
-    Serial.println("No saved WiFi credentials. Starting captive portal...");
+    LOG_I("No saved WiFi credentials. Starting captive portal...");
     startCaptivePortal();
     return false;
   }
 
-  Serial.print("Connecting to WiFi: ");
-  Serial.println(ssid);
+  LOG_I("Connecting to WiFi: %s", ssid);
 
   WiFi.mode(WIFI_STA);
   WiFi.begin(ssid, password);
@@ -362,18 +417,14 @@ bool connectToWiFi() {
 
   while (WiFi.status() != WL_CONNECTED && attempts < maxAttempts) {
     delay(1000);
-    Serial.print(".");
     attempts++;
   }
 
   if (WiFi.status() == WL_CONNECTED) {
-    Serial.println();
-    Serial.print("Connected! IP: ");
-    Serial.println(WiFi.localIP());
+    LOG_I("Connected after %d s! IP: %s", attempts, WiFi.localIP().toString().c_str());
     return true;
   } else {
-    Serial.println();
-    Serial.println("Failed to connect to WiFi. Starting captive portal...");
+    LOG_E("Failed to connect to WiFi. Starting captive portal...");
     startCaptivePortal();
     return false;
   }
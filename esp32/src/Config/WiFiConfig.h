@@ -6,6 +6,7 @@
 #include <WebServer.h>
 #include <SPIFFS.h>
 #include <ArduinoJson.h>
+#include "ServerRanking.h"
 
 #define DNS_PORT 53
 #define WIFI_SSID_LENGTH 32
@@ -30,6 +31,8 @@ bool loadWiFiCredentials(char* ssid, char* password);
 
 /**
  * Saves server URL configuration
+ * A comma separated list configures several servers for failover
+ * ("server_urls"); the first one is also kept as "server_url".
  */
 void saveServerUrl(const char* url);
 
@@ -38,6 +41,12 @@ void saveServerUrl(const char* url);
  */
 bool loadServerUrl(char* url);
 
+/**
+ * Loads all configured server URLs, falling back to the single server_url
+ * @return number of URLs loaded into urls (0 if none is configured)
+ */
+uint8_t loadServerUrls(char urls[][SERVER_URL_LENGTH], uint8_t maxUrls);
+
 /**
  * Starts the captive portal for WiFi setup
  */
@@ -46,8 +46,37 @@
  extern "C" {
 #endif
 
+/* Keep sorted by index in UTF-8 byte order: Paint_DrawString_CN bisects it */
 const CH_CN Font12CN_Table[] = 
 {
+/*--  文字:  A  --*/
+/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
+{"A",
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0E,0x00,0x1F,0x00,0x1F,0x00,
+0x1F,0x00,0x3B,0x80,0x3B,0x80,0x71,0x80,0x7F,0xC0,0x71,0xC0,0xE0,0xE0,0xE0,0xE0,
+0xE0,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+
+/*--  文字:  a  --*/
+/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
+{"a",
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x3E,0x00,0x67,0x00,0x07,0x80,0x0F,0x80,0x7F,0x80,0xE3,0x80,0xE7,0x80,0xE7,0x80,
+0x7F,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+
+/*--  文字:  b  --*/
+/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
+{"b",
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,
+0x7F,0x00,0x7B,0x80,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x7B,0x80,
+0x7F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+
+/*--  文字:  c  --*/
+/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
+{"c",
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x3F,0x00,0x73,0x00,0xF0,0x00,0xE0,0x00,0xE0,0x00,0xE0,0x00,0xF0,0x00,0x73,0x00,
+0x3F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+
 /*--  文字:  你  --*/
 /*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
 {"你",
@@ -69,13 +98,6 @@ const CH_CN Font12CN_Table[] =
 0xFC,0xFF,0x76,0xCE,0x77,0xFE,0x7B,0xFE,0xFF,0xFE,0xF3,0xDE,0xF3,0xCE,0x37,0xEE,
 0x3E,0x6E,0x3C,0x0E,0x30,0x3E,0x00,0x00,0x00,0x00},
 
-/*--  文字:  莓  --*/
-/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
-{"莓",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x70,0xFF,0xFF,0x3E,0x70,0x38,0x00,
-0x7F,0xFF,0xE0,0x00,0xFF,0xFC,0x3B,0x8C,0x39,0xCC,0xFF,0xFF,0x73,0x9C,0x71,0xDC,
-0x7F,0xFF,0x00,0x1C,0x01,0xF8,0x00,0x00,0x00,0x00},
-
 /*--  文字:  派  --*/
 /*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
 {"派",
@@ -83,45 +105,35 @@ const CH_CN Font12CN_Table[] =
 0xCF,0xFB,0xFF,0xF8,0x3F,0xFF,0x0F,0xFF,0x7F,0xD8,0x7F,0xDC,0x6F,0xCE,0xED,0xFF,
 0xFD,0xF7,0xF9,0xC0,0x00,0x00,0x00,0x00,0x00,0x00},
 
-/*--  文字:  a  --*/
-/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
-{"a",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x3E,0x00,0x67,0x00,0x07,0x80,0x0F,0x80,0x7F,0x80,0xE3,0x80,0xE7,0x80,0xE7,0x80,
-0x7F,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-
-/*--  文字:  b  --*/
-/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
-{"b",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x70,0x00,0x70,0x00,0x70,0x00,0x70,0x00,
-0x7F,0x00,0x7B,0x80,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x71,0xC0,0x7B,0x80,
-0x7F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-
-/*--  文字:  c  --*/
-/*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
-{"c",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x3F,0x00,0x73,0x00,0xF0,0x00,0xE0,0x00,0xE0,0x00,0xE0,0x00,0xF0,0x00,0x73,0x00,
-0x3F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-
-/*--  文字:  A  --*/
+/*--  文字:  莓  --*/
 /*--  微软雅黑12;  此字体下对应的点阵为：宽x高=16x21   --*/
-{"A",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0E,0x00,0x1F,0x00,0x1F,0x00,
-0x1F,0x00,0x3B,0x80,0x3B,0x80,0x71,0x80,0x7F,0xC0,0x71,0xC0,0xE0,0xE0,0xE0,0xE0,
-0xE0,0xE0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
+{"莓",
+0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x70,0xFF,0xFF,0x3E,0x70,0x38,0x00,
+0x7F,0xFF,0xE0,0x00,0xFF,0xFC,0x3B,0x8C,0x39,0xCC,0xFF,0xFF,0x73,0x9C,0x71,0xDC,
+0x7F,0xFF,0x00,0x1C,0x01,0xF8,0x00,0x00,0x00,0x00},
 };
 
 #ifdef __cplusplus
 }
 #endif
 
+/* Table entry of each character ' ' to '~', 0xFF (CN_ASCII_NONE) if missing */
+static const uint8_t Font12CN_ASCII[95] = {
+  0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* ' ' to '/' */
+  0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* '0' to '?' */
+  0xFF,0x00,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* '@' to 'O' */
+  0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* 'P' to '_' */
+  0xFF,0x01,0x02,0x03,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* '`' to 'o' */
+  0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,  /* 'p' to '~' */
+};
+
 cFONT Font12CN = {
   Font12CN_Table,
   sizeof(Font12CN_Table)/sizeof(CH_CN),  /*size of table*/
   11, /* ASCII Width */
   16, /* Width */
   21, /* Height */
+  Font12CN_ASCII, /* ASCII index */
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
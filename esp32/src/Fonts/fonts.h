@@ -68,6 +68,11 @@ typedef struct                                          // 汉字字模数据结
   const unsigned char matrix[MAX_HEIGHT_FONT*MAX_WIDTH_FONT/8 + 1];  // 点阵码数据
 }CH_CN;
 
+// table is sorted by index in UTF-8 byte order, so ASCII entries come
+// first, and is searched by bisection. ASCII_Index, if not NULL, holds the
+// table entry of each printable ASCII character (' ' to '~'), or
+// CN_ASCII_NONE if the font has no glyph for it.
+#define CN_ASCII_NONE 0xFF
 typedef struct
 {    
   const CH_CN *table;
@@ -75,7 +80,7 @@ typedef struct
   uint16_t ASCII_Width;
   uint16_t Width;
   uint16_t Height;
-  
+  const uint8_t *ASCII_Index;
 }cFONT;
 
 extern sFONT Font24;
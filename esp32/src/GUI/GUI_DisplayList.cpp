@@ -0,0 +1,513 @@
+/******************************************************************************
+* | File      	:   GUI_DisplayList.cpp
+* | Function    :   Record GUI_Paint drawing calls and replay them, either
+*                   into a full image or band by band into a small cache
+* | Info        :
+*   Replay calls the Paint_Draw functions themselves, so a banded picture
+*   is pixel for pixel the one Paint would draw into a full image.
+******************************************************************************/
+#include "GUI_DisplayList.h"
+#include <string.h> //memset()
+#ifdef DEV_LINUX
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#endif
+
+#define PAINT_LIST_FAR 0xFFFF
+
+/******************************************************************************
+function: Start an empty list in caller-provided storage
+parameter:
+    List     : List to initialize
+    Cmds     : Storage for up to Capacity calls
+    Capacity : Number of entries in Cmds
+******************************************************************************/
+void Paint_ListInit(PAINT_LIST *List, PAINT_CMD *Cmds, UWORD Capacity)
+{
+    List->Cmds = Cmds;
+    List->Count = 0;
+    List->Capacity = Capacity;
+    List->Overflow = FALSE;
+}
+
+/******************************************************************************
+function: Append a call whose pixels lie in Xmin..Xmax-1 by Ymin..Ymax-1
+info:
+    Returns NULL (and marks the list) when it is full.
+******************************************************************************/
+static PAINT_CMD *Paint_ListAdd(PAINT_LIST *List, PAINT_OP Op, int Xmin, int Ymin, int Xmax, int Ymax)
+{
+    if (List->Count >= List->Capacity) {
+        Debug("Paint_ListAdd: display list is full\r\n");
+        List->Overflow = TRUE;
+        return NULL;
+    }
+    PAINT_CMD *Cmd = &List->Cmds[List->Count++];
+    memset(Cmd, 0, sizeof(*Cmd));
+    Cmd->Op = Op;
+    Cmd->Xmin = (Xmin < 0) ? 0 : Xmin;
+    Cmd->Ymin = (Ymin < 0) ? 0 : Ymin;
+    Cmd->Xmax = (Xmax > PAINT_LIST_FAR) ? PAINT_LIST_FAR : Xmax;
+    Cmd->Ymax = (Ymax > PAINT_LIST_FAR) ? PAINT_LIST_FAR : Ymax;
+    return Cmd;
+}
+
+void Paint_ListClear(PAINT_LIST *List, UWORD Color)
+{
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_CLEAR, 0, 0, PAINT_LIST_FAR, PAINT_LIST_FAR);
+    if (Cmd)
+        Cmd->Color = Color;
+}
+
+void Paint_ListClearWindows(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_CLEAR_WINDOWS, Xstart, Ystart, Xend, Yend);
+    if (Cmd) {
+        Cmd->X0 = Xstart;
+        Cmd->Y0 = Ystart;
+        Cmd->X1 = Xend;
+        Cmd->Y1 = Yend;
+        Cmd->Color = Color;
+    }
+}
+
+void Paint_ListPoint(PAINT_LIST *List, UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                     DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+{
+    // DOT_FILL_AROUND covers X-w..X+w-2, DOT_FILL_RIGHTUP X-1..X+w-2
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_POINT, Xpoint - Dot_Pixel, Ypoint - Dot_Pixel,
+                                   Xpoint + Dot_Pixel, Ypoint + Dot_Pixel);
+    if (Cmd) {
+        Cmd->X0 = Xpoint;
+        Cmd->Y0 = Ypoint;
+        Cmd->Color = Color;
+        Cmd->Size = Dot_Pixel;
+        Cmd->Style = Dot_Style;
+    }
+}
+
+/******************************************************************************
+function: Record a line or rectangle from (Xstart, Ystart) to (Xend, Yend)
+info:
+    Both are drawn with points of Line_width around the corners' box.
+******************************************************************************/
+static PAINT_CMD *Paint_ListBox(PAINT_LIST *List, PAINT_OP Op, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                                UWORD Color, DOT_PIXEL Line_width, UBYTE Style)
+{
+    const int Xmin = (Xstart < Xend) ? Xstart : Xend;
+    const int Xmax = (Xstart < Xend) ? Xend : Xstart;
+    const int Ymin = (Ystart < Yend) ? Ystart : Yend;
+    const int Ymax = (Ystart < Yend) ? Yend : Ystart;
+    PAINT_CMD *Cmd = Paint_ListAdd(List, Op, Xmin - Line_width, Ymin - Line_width,
+                                   Xmax + Line_width, Ymax + Line_width);
+    if (Cmd) {
+        Cmd->X0 = Xstart;
+        Cmd->Y0 = Ystart;
+        Cmd->X1 = Xend;
+        Cmd->Y1 = Yend;
+        Cmd->Color = Color;
+        Cmd->Size = Line_width;
+        Cmd->Style = Style;
+    }
+    return Cmd;
+}
+
+void Paint_ListLine(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                    UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    Paint_ListBox(List, PAINT_OP_LINE, Xstart, Ystart, Xend, Yend, Color, Line_width, Line_Style);
+}
+
+void Paint_ListRectangle(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                         UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    Paint_ListBox(List, PAINT_OP_RECTANGLE, Xstart, Ystart, Xend, Yend, Color, Line_width, Draw_Fill);
+}
+
+void Paint_ListCircle(PAINT_LIST *List, UWORD X_Center, UWORD Y_Center, UWORD Radius,
+                      UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    const int Reach = Radius + Line_width;
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_CIRCLE, X_Center - Reach, Y_Center - Reach,
+                                   X_Center + Reach, Y_Center + Reach);
+    if (Cmd) {
+        Cmd->X0 = X_Center;
+        Cmd->Y0 = Y_Center;
+        Cmd->X1 = Radius;
+        Cmd->Color = Color;
+        Cmd->Size = Line_width;
+        Cmd->Style = Draw_Fill;
+    }
+}
+
+void Paint_ListString_EN(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, const char *pString,
+                         sFONT *Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    // Long strings wrap back to Xstart on the next line, and to Ystart at the
+    // bottom, so they stay right of and below the start
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_STRING_EN, Xstart, Ystart, PAINT_LIST_FAR, PAINT_LIST_FAR);
+    if (Cmd) {
+        Cmd->X0 = Xstart;
+        Cmd->Y0 = Ystart;
+        Cmd->Data = pString;
+        Cmd->Font = Font;
+        Cmd->Color = Color_Foreground;
+        Cmd->Background = Color_Background;
+    }
+}
+
+void Paint_ListString_CN(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, const char *pString,
+                         cFONT *Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_STRING_CN, Xstart, Ystart, PAINT_LIST_FAR, Ystart + Font->Height);
+    if (Cmd) {
+        Cmd->X0 = Xstart;
+        Cmd->Y0 = Ystart;
+        Cmd->Data = pString;
+        Cmd->Font = Font;
+        Cmd->Color = Color_Foreground;
+        Cmd->Background = Color_Background;
+    }
+}
+
+void Paint_ListBitMap_Paste(PAINT_LIST *List, const unsigned char *image_buffer, UWORD xStart, UWORD yStart,
+                            UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
+{
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_BITMAP_PASTE, xStart, yStart,
+                                   xStart + imageWidth, yStart + imageHeight);
+    if (Cmd) {
+        Cmd->X0 = xStart;
+        Cmd->Y0 = yStart;
+        Cmd->X1 = imageWidth;
+        Cmd->Y1 = imageHeight;
+        Cmd->Data = image_buffer;
+        Cmd->Style = flipColor;
+    }
+}
+
+void Paint_ListSprite(PAINT_LIST *List, const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart)
+{
+    PAINT_CMD *Cmd = Paint_ListAdd(List, PAINT_OP_SPRITE, Xstart, Ystart,
+                                   Xstart + Sprite->Width, Ystart + Sprite->Height);
+    if (Cmd) {
+        Cmd->X0 = Xstart;
+        Cmd->Y0 = Ystart;
+        Cmd->Data = Sprite;
+    }
+}
+
+/******************************************************************************
+function: Draw every recorded call into the current image
+info:
+    Calls entirely outside the area the cache holds (a band, when
+    Paint_SetBand is in use) are skipped.
+******************************************************************************/
+void Paint_DrawList(PAINT &paint, const PAINT_LIST *List)
+{
+    for (UWORD i = 0; i < List->Count; i++) {
+        const PAINT_CMD *Cmd = &List->Cmds[i];
+        if (Cmd->Xmax <= paint.ClipXstart || Cmd->Xmin >= paint.ClipXend ||
+            Cmd->Ymax <= paint.ClipYstart || Cmd->Ymin >= paint.ClipYend)
+            continue;
+
+        switch (Cmd->Op) {
+        case PAINT_OP_CLEAR:
+            Paint_Clear(paint, Cmd->Color);
+            break;
+        case PAINT_OP_CLEAR_WINDOWS:
+            Paint_ClearWindows(paint, Cmd->X0, Cmd->Y0, Cmd->X1, Cmd->Y1, Cmd->Color);
+            break;
+        case PAINT_OP_POINT:
+            Paint_DrawPoint(paint, Cmd->X0, Cmd->Y0, Cmd->Color, (DOT_PIXEL)Cmd->Size, (DOT_STYLE)Cmd->Style);
+            break;
+        case PAINT_OP_LINE:
+            Paint_DrawLine(paint, Cmd->X0, Cmd->Y0, Cmd->X1, Cmd->Y1, Cmd->Color,
+                           (DOT_PIXEL)Cmd->Size, (LINE_STYLE)Cmd->Style);
+            break;
+        case PAINT_OP_RECTANGLE:
+            Paint_DrawRectangle(paint, Cmd->X0, Cmd->Y0, Cmd->X1, Cmd->Y1, Cmd->Color,
+                                (DOT_PIXEL)Cmd->Size, (DRAW_FILL)Cmd->Style);
+            break;
+        case PAINT_OP_CIRCLE:
+            Paint_DrawCircle(paint, Cmd->X0, Cmd->Y0, Cmd->X1, Cmd->Color,
+                             (DOT_PIXEL)Cmd->Size, (DRAW_FILL)Cmd->Style);
+            break;
+        case PAINT_OP_STRING_EN:
+            Paint_DrawString_EN(paint, Cmd->X0, Cmd->Y0, (const char *)Cmd->Data, (sFONT *)Cmd->Font,
+                                Cmd->Color, Cmd->Background);
+            break;
+        case PAINT_OP_STRING_CN:
+            Paint_DrawString_CN(paint, Cmd->X0, Cmd->Y0, (const char *)Cmd->Data, (cFONT *)Cmd->Font,
+                                Cmd->Color, Cmd->Background);
+            break;
+        case PAINT_OP_BITMAP_PASTE:
+            Paint_DrawBitMap_Paste(paint, (const unsigned char *)Cmd->Data, Cmd->X0, Cmd->Y0,
+                                   Cmd->X1, Cmd->Y1, Cmd->Style);
+            break;
+        case PAINT_OP_SPRITE:
+            Paint_DrawSprite(paint, (const PAINT_SPRITE *)Cmd->Data, Cmd->X0, Cmd->Y0);
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+function: Draw the list band by band and pass each band to Sink
+parameter:
+    List       : Recorded calls, normally starting with Paint_ListClear
+    BandHeight : Buffer rows per band
+    Sink       : Called with each band, top to bottom
+    User       : Passed to Sink
+info:
+    Paint_NewImage must have been given the band cache (at least
+    WidthByte * BandHeight bytes) with the full image's size. Each band is
+    drawn from scratch: anything not covered by the list keeps the previous
+    band's pixels. The image is left set to its last band.
+******************************************************************************/
+void Paint_DrawListBanded(PAINT &paint, const PAINT_LIST *List, UWORD BandHeight, PAINT_BAND_SINK Sink, void *User)
+{
+    if (BandHeight == 0)
+        return;
+    const UWORD Height = paint.HeightMemory;
+    for (UWORD Top = 0; Top < Height; Top += BandHeight) {
+        Paint_SetBand(paint, Top, BandHeight);
+        Paint_DrawList(paint, List);
+        Sink(paint.Image, paint.BandHeight, User);
+    }
+}
+
+/**
+ * The band the worker draws next, handed over through Start and Done
+**/
+#ifdef DEV_LINUX
+typedef sem_t PAINT_SIGNAL;
+#else
+typedef SemaphoreHandle_t PAINT_SIGNAL;
+#endif
+
+typedef struct {
+    PAINT *Odd;
+    const PAINT_LIST *List;
+    UWORD Top;              // HeightMemory or more: stop
+    UWORD BandHeight;
+    PAINT_SIGNAL Start;
+    PAINT_SIGNAL Done;
+#ifdef DEV_LINUX
+    pthread_t Thread;
+#endif
+} PAINT_BAND_JOB;
+
+/******************************************************************************
+function: Binary signals between the calling task and the worker: a FreeRTOS
+          semaphore on the ESP32, a POSIX one on the host
+******************************************************************************/
+#ifdef DEV_LINUX
+static bool Paint_SignalCreate(PAINT_SIGNAL *Signal)
+{
+    return sem_init(Signal, 0, 0) == 0;
+}
+
+static void Paint_SignalGive(PAINT_SIGNAL *Signal)
+{
+    sem_post(Signal);
+}
+
+static void Paint_SignalTake(PAINT_SIGNAL *Signal)
+{
+    while (sem_wait(Signal) != 0 && errno == EINTR)
+        ;
+}
+
+static void Paint_SignalDelete(PAINT_SIGNAL *Signal)
+{
+    sem_destroy(Signal);
+}
+#else
+static bool Paint_SignalCreate(PAINT_SIGNAL *Signal)
+{
+    *Signal = xSemaphoreCreateBinary();
+    return *Signal != NULL;
+}
+
+static void Paint_SignalGive(PAINT_SIGNAL *Signal)
+{
+    xSemaphoreGive(*Signal);
+}
+
+static void Paint_SignalTake(PAINT_SIGNAL *Signal)
+{
+    xSemaphoreTake(*Signal, portMAX_DELAY);
+}
+
+static void Paint_SignalDelete(PAINT_SIGNAL *Signal)
+{
+    vSemaphoreDelete(*Signal);
+}
+#endif
+
+static void Paint_BandLoop(PAINT_BAND_JOB *Job)
+{
+    for (;;) {
+        Paint_SignalTake(&Job->Start);
+        if (Job->Top >= Job->Odd->HeightMemory)
+            break;
+        Paint_SetBand(*Job->Odd, Job->Top, Job->BandHeight);
+        Paint_DrawList(*Job->Odd, Job->List);
+        Paint_SignalGive(&Job->Done);
+    }
+    Paint_SignalGive(&Job->Done);
+}
+
+/******************************************************************************
+function: Start the worker on the other core (a thread on the host), and
+          wait for it after it has given Done for the stop request
+******************************************************************************/
+#ifdef DEV_LINUX
+static void *Paint_BandThread(void *Arg)
+{
+    Paint_BandLoop((PAINT_BAND_JOB *)Arg);
+    return NULL;
+}
+
+static bool Paint_WorkerStart(PAINT_BAND_JOB *Job)
+{
+    return pthread_create(&Job->Thread, NULL, Paint_BandThread, Job) == 0;
+}
+
+static void Paint_WorkerJoin(PAINT_BAND_JOB *Job)
+{
+    pthread_join(Job->Thread, NULL);
+}
+#else
+static void Paint_BandTask(void *Arg)
+{
+    Paint_BandLoop((PAINT_BAND_JOB *)Arg);
+    vTaskDelete(NULL);
+}
+
+static bool Paint_WorkerStart(PAINT_BAND_JOB *Job)
+{
+    TaskHandle_t Worker = NULL;
+    return xTaskCreatePinnedToCore(Paint_BandTask, "paint_band", PAINT_BAND_TASK_STACK, Job,
+                                   uxTaskPriorityGet(NULL), &Worker, xPortGetCoreID() ? 0 : 1) == pdPASS;
+}
+
+static void Paint_WorkerJoin(PAINT_BAND_JOB *)
+{
+    // The task deletes itself right after its last Done
+}
+#endif
+
+/******************************************************************************
+function: Paint_DrawListBanded with every other band drawn on the other core
+parameter:
+    Even, Odd  : Two PAINTs set up alike (Paint_NewImage, Paint_SetScale, ...)
+                 on two band caches
+    List       : Recorded calls, normally starting with Paint_ListClear
+    BandHeight : Buffer rows per band
+    Sink       : Called with each band, top to bottom, from the calling task
+    User       : Passed to Sink
+info:
+    Odd bands are drawn by a task pinned to the other core (a thread when
+    built with DEV_LINUX) while the calling task draws the even band before
+    it and hands that to Sink, so drawing overlaps both the other drawing
+    and the transfer. If the worker cannot be started the bands are drawn
+    one after the other, into the same caches, with the same result.
+******************************************************************************/
+void Paint_DrawListBandedDual(PAINT &Even, PAINT &Odd, const PAINT_LIST *List, UWORD BandHeight,
+                              PAINT_BAND_SINK Sink, void *User)
+{
+    if (BandHeight == 0)
+        return;
+    const UWORD Height = Even.HeightMemory;
+
+    PAINT_BAND_JOB Job;
+    Job.Odd = &Odd;
+    Job.List = List;
+    Job.Top = 0;
+    Job.BandHeight = BandHeight;
+    bool Worker = Paint_SignalCreate(&Job.Start);
+    if (Worker && !Paint_SignalCreate(&Job.Done)) {
+        Paint_SignalDelete(&Job.Start);
+        Worker = false;
+    }
+    if (Worker && !Paint_WorkerStart(&Job)) {
+        Paint_SignalDelete(&Job.Start);
+        Paint_SignalDelete(&Job.Done);
+        Worker = false;
+    }
+    if (!Worker)
+        Debug("Paint_DrawListBandedDual: no worker, drawing the bands one by one\r\n");
+
+    for (UDOUBLE Top = 0; Top < Height; Top += 2 * (UDOUBLE)BandHeight) {
+        const UDOUBLE Next = Top + BandHeight;
+        if (Worker && Next < Height) {
+            Job.Top = Next;
+            Paint_SignalGive(&Job.Start);
+        }
+        Paint_SetBand(Even, Top, BandHeight);
+        Paint_DrawList(Even, List);
+        Sink(Even.Image, Even.BandHeight, User);
+        if (Next >= Height)
+            break;
+
+        if (Worker) {
+            Paint_SignalTake(&Job.Done);
+        } else {
+            Paint_SetBand(Odd, Next, BandHeight);
+            Paint_DrawList(Odd, List);
+        }
+        Sink(Odd.Image, Odd.BandHeight, User);
+    }
+
+    if (Worker) {
+        Job.Top = Height;
+        Paint_SignalGive(&Job.Start);
+        Paint_SignalTake(&Job.Done);
+        Paint_WorkerJoin(&Job);
+        Paint_SignalDelete(&Job.Start);
+        Paint_SignalDelete(&Job.Done);
+    }
+}
+
+/******************************************************************************
+function: Draw the list over rows of an existing picture
+parameter:
+    List   : Recorded calls, without Paint_ListClear
+    Rows   : Count buffer rows holding rows Ystart.. of the picture
+    Ystart : Row of the picture Rows[0] is
+    Count  : Number of rows
+info:
+    Paint_NewImage must have set the full picture's size and scale. Only
+    the calls that reach these rows are replayed, and they are clipped to
+    them, so the cost per row depends on what crosses it.
+******************************************************************************/
+void Paint_DrawListOnto(PAINT &paint, const PAINT_LIST *List, UBYTE *Rows, UWORD Ystart, UWORD Count)
+{
+    Paint_SelectImage(paint, Rows);
+    Paint_SetBand(paint, Ystart, Count);
+    Paint_DrawList(paint, List);
+}
+
+/******************************************************************************
+function: The calls above on the global Paint
+******************************************************************************/
+void Paint_DrawList(const PAINT_LIST *List)
+{
+    Paint_DrawList(Paint, List);
+}
+
+void Paint_DrawListBanded(const PAINT_LIST *List, UWORD BandHeight, PAINT_BAND_SINK Sink, void *User)
+{
+    Paint_DrawListBanded(Paint, List, BandHeight, Sink, User);
+}
+
+void Paint_DrawListOnto(const PAINT_LIST *List, UBYTE *Rows, UWORD Ystart, UWORD Count)
+{
+    Paint_DrawListOnto(Paint, List, Rows, Ystart, Count);
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+* | File      	:   GUI_DisplayList.h
+* | Function    :   Record GUI_Paint drawing calls and replay them, either
+*                   into a full image or band by band into a small cache
+* | Info        :
+*   A 800x480 4bpp image needs 192KB, more than a board without PSRAM can
+*   spare. Recorded into a PAINT_LIST, the same picture can be drawn into
+*   a cache of a few rows (800x40 = 16KB), one band at a time, with each
+*   band handed to a sink that sends it to the panel.
+*
+*   The same list drawn onto rows of a frame on their way to the panel
+*   (Paint_DrawListOnto) overlays it on a downloaded picture, again without
+*   a full framebuffer. Text with Color_Background WHITE (0xFF) leaves the
+*   picture behind the glyphs untouched.
+*
+*   Strings, fonts, bitmaps and sprites are referenced, not copied: they
+*   must stay valid until the list has been drawn. Replay only reads the
+*   list, so two tasks can draw the same list into two PAINTs at once.
+******************************************************************************/
+#ifndef __GUI_DISPLAYLIST_H
+#define __GUI_DISPLAYLIST_H
+
+#include "GUI_Paint.h"
+
+/**
+ * Recorded operations
+**/
+typedef enum {
+    PAINT_OP_CLEAR = 0,
+    PAINT_OP_CLEAR_WINDOWS,
+    PAINT_OP_POINT,
+    PAINT_OP_LINE,
+    PAINT_OP_RECTANGLE,
+    PAINT_OP_CIRCLE,
+    PAINT_OP_STRING_EN,
+    PAINT_OP_STRING_CN,
+    PAINT_OP_BITMAP_PASTE,
+    PAINT_OP_SPRITE,
+} PAINT_OP;
+
+/**
+ * One recorded call: the arguments, and the logical area it can touch
+ * (Xmin <= X < Xmax, Ymin <= Y < Ymax) so bands it misses can skip it
+**/
+typedef struct {
+    UBYTE Op;
+    UBYTE Size;         // DOT_PIXEL
+    UBYTE Style;        // DOT_STYLE, LINE_STYLE, DRAW_FILL or flipColor
+    UWORD X0, Y0, X1, Y1;
+    UWORD Color;
+    UWORD Background;
+    const void *Data;   // string, bitmap or PAINT_SPRITE
+    const void *Font;   // sFONT or cFONT
+    UWORD Xmin, Ymin, Xmax, Ymax;
+} PAINT_CMD;
+
+typedef struct {
+    PAINT_CMD *Cmds;
+    UWORD Count;
+    UWORD Capacity;
+    UBYTE Overflow;     // a call did not fit and was dropped
+} PAINT_LIST;
+
+/**
+ * Receives each finished band: Rows buffer rows of WidthByte bytes
+**/
+typedef void (*PAINT_BAND_SINK)(const UBYTE *Band, UWORD Rows, void *User);
+
+// Stack of the task Paint_DrawListBandedDual draws odd bands on
+#define PAINT_BAND_TASK_STACK  4096
+
+//Recording
+void Paint_ListInit(PAINT_LIST *List, PAINT_CMD *Cmds, UWORD Capacity);
+void Paint_ListClear(PAINT_LIST *List, UWORD Color);
+void Paint_ListClearWindows(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+void Paint_ListPoint(PAINT_LIST *List, UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style);
+void Paint_ListLine(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
+void Paint_ListRectangle(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_ListCircle(PAINT_LIST *List, UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_ListString_EN(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, const char *pString, sFONT *Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_ListString_CN(PAINT_LIST *List, UWORD Xstart, UWORD Ystart, const char *pString, cFONT *Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_ListBitMap_Paste(PAINT_LIST *List, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor);
+void Paint_ListSprite(PAINT_LIST *List, const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart);
+
+//Replay
+void Paint_DrawList(const PAINT_LIST *List);
+void Paint_DrawListBanded(const PAINT_LIST *List, UWORD BandHeight, PAINT_BAND_SINK Sink, void *User);
+void Paint_DrawListOnto(const PAINT_LIST *List, UBYTE *Rows, UWORD Ystart, UWORD Count);
+
+//Replay into a given PAINT
+void Paint_DrawList(PAINT &paint, const PAINT_LIST *List);
+void Paint_DrawListBanded(PAINT &paint, const PAINT_LIST *List, UWORD BandHeight, PAINT_BAND_SINK Sink, void *User);
+void Paint_DrawListOnto(PAINT &paint, const PAINT_LIST *List, UBYTE *Rows, UWORD Ystart, UWORD Count);
+void Paint_DrawListBandedDual(PAINT &Even, PAINT &Odd, const PAINT_LIST *List, UWORD BandHeight,
+                              PAINT_BAND_SINK Sink, void *User);
+
+#endif
@@ -12,6 +12,19 @@
 * | Date        :   2020-07-23
 * | Info        :
 * -----------------------------------------------------------------------------
+* Paint_SetPixel: Rotate/Mirror/Scale are resolved into a pixel writer when
+*   they change (Paint_SelectWriter), and the drawing functions clip once per
+*   primitive and then write through it unchecked.
+* Area fills (Paint_Clear, Paint_ClearWindows, filled rectangles and circles)
+*   are built on Paint_FillSpan, which memsets whole bytes of a buffer row.
+* Paint_SetBand: the buffer may hold only some rows of the image, so a
+*   full-screen picture can be drawn band by band (see GUI_DisplayList.h).
+* Paint_DrawChar, Paint_DrawString_CN: glyphs go through Paint_DrawGlyph,
+*   which at scale 7 expands font bytes to nibble masks and writes two
+*   pixels per byte; rotated or mirrored glyphs are rotated first.
+* Paint_DrawLine: rasterized row by row from the runs of its Bresenham
+*   steps, so each pixel is written once instead of once per covering point.
+*
 * V3.2(2020-07-23):
 * 1. Change: Paint_SetScale(UBYTE scale)
 *			Add scale 7 for 5.65f e-Parper
@@ -83,6 +96,9 @@
 
 PAINT Paint;
 
+static void Paint_SelectWriter(PAINT &paint);
+static void Paint_MarkDirty(PAINT &paint, int Xstart, int Ystart, int Xend, int Yend);
+
 /******************************************************************************
 function: Create Image
 parameter:
@@ -91,30 +107,34 @@ parameter:
     Height  :   The height of the picture
     Color   :   Whether the picture is inverted
 ******************************************************************************/
-void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+void Paint_NewImage(PAINT &paint, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
 {
-    Paint.Image = NULL;
-    Paint.Image = image;
+    paint.Image = NULL;
+    paint.Image = image;
 
-    Paint.WidthMemory = Width;
-    Paint.HeightMemory = Height;
-    Paint.Color = Color;    
-    Paint.Scale = 2;
-    Paint.WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
-    Paint.HeightByte = Height;    
-//    printf("WidthByte = %d, HeightByte = %d\r\n", Paint.WidthByte, Paint.HeightByte);
+    paint.WidthMemory = Width;
+    paint.HeightMemory = Height;
+    paint.Color = Color;    
+    paint.Scale = 2;
+    paint.WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
+    paint.HeightByte = Height;    
+    paint.BandTop = 0;
+    paint.BandHeight = Height;
+//    printf("WidthByte = %d, HeightByte = %d\r\n", paint.WidthByte, paint.HeightByte);
 //    printf(" EPD_WIDTH / 8 = %d\r\n",  122 / 8);
    
-    Paint.Rotate = Rotate;
-    Paint.Mirror = MIRROR_NONE;
+    paint.Rotate = Rotate;
+    paint.Mirror = MIRROR_NONE;
     
     if(Rotate == ROTATE_0 || Rotate == ROTATE_180) {
-        Paint.Width = Width;
-        Paint.Height = Height;
+        paint.Width = Width;
+        paint.Height = Height;
     } else {
-        Paint.Width = Height;
-        Paint.Height = Width;
+        paint.Width = Height;
+        paint.Height = Width;
     }
+    Paint_SelectWriter(paint);
+    Paint_ResetDirty(paint);
 }
 
 /******************************************************************************
@@ -122,9 +142,10 @@ function: Select Image
 parameter:
     image : Pointer to the image cache
 ******************************************************************************/
-void Paint_SelectImage(UBYTE *image)
+void Paint_SelectImage(PAINT &paint, UBYTE *image)
 {
-    Paint.Image = image;
+    paint.Image = image;
+    Paint_ResetDirty(paint);
 }
 
 /******************************************************************************
@@ -132,11 +153,12 @@ function: Select Image Rotate
 parameter:
     Rotate : 0,90,180,270
 ******************************************************************************/
-void Paint_SetRotate(UWORD Rotate)
+void Paint_SetRotate(PAINT &paint, UWORD Rotate)
 {
     if(Rotate == ROTATE_0 || Rotate == ROTATE_90 || Rotate == ROTATE_180 || Rotate == ROTATE_270) {
         // Debug("Set image Rotate %d\r\n", Rotate);
-        Paint.Rotate = Rotate;
+        paint.Rotate = Rotate;
+        Paint_SelectWriter(paint);
     } else {
         Debug("rotate = 0, 90, 180, 270\r\n");
     }
@@ -147,37 +169,219 @@ function:	Select Image mirror
 parameter:
     mirror   :Not mirror,Horizontal mirror,Vertical mirror,Origin mirror
 ******************************************************************************/
-void Paint_SetMirroring(UBYTE mirror)
+void Paint_SetMirroring(PAINT &paint, UBYTE mirror)
 {
     if(mirror == MIRROR_NONE || mirror == MIRROR_HORIZONTAL || 
         mirror == MIRROR_VERTICAL || mirror == MIRROR_ORIGIN) {
         // Debug("mirror image x:%s, y:%s\r\n",(mirror & 0x01)? "mirror":"none", ((mirror >> 1) & 0x01)? "mirror":"none");
-        Paint.Mirror = mirror;
+        paint.Mirror = mirror;
+        Paint_SelectWriter(paint);
     } else {
         Debug("mirror should be MIRROR_NONE, MIRROR_HORIZONTAL, \
         MIRROR_VERTICAL or MIRROR_ORIGIN\r\n");
     }    
 }
 
-void Paint_SetScale(UBYTE scale)
+void Paint_SetScale(PAINT &paint, UBYTE scale)
 {
     if(scale == 2){
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 8 == 0)? (Paint.WidthMemory / 8 ): (Paint.WidthMemory / 8 + 1);
+        paint.Scale = scale;
+        paint.WidthByte = (paint.WidthMemory % 8 == 0)? (paint.WidthMemory / 8 ): (paint.WidthMemory / 8 + 1);
     }
 	else if(scale == 4) {
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 4 == 0)? (Paint.WidthMemory / 4 ): (Paint.WidthMemory / 4 + 1);
+        paint.Scale = scale;
+        paint.WidthByte = (paint.WidthMemory % 4 == 0)? (paint.WidthMemory / 4 ): (paint.WidthMemory / 4 + 1);
     }
 	else if(scale == 6 || scale == 7) {//Only applicable with 5in65 e-Paper
-		Paint.Scale = 7;
-		Paint.WidthByte = (Paint.WidthMemory % 2 == 0)? (Paint.WidthMemory / 2 ): (Paint.WidthMemory / 2 + 1);
+		paint.Scale = 7;
+		paint.WidthByte = (paint.WidthMemory % 2 == 0)? (paint.WidthMemory / 2 ): (paint.WidthMemory / 2 + 1);
 	}
 	else {
         Debug("Set Scale Input parameter error\r\n");
         Debug("Scale Only support: 2 4 7\r\n");
     }
+    Paint_SelectWriter(paint);
+}
+
+/******************************************************************************
+function: Select the band of the image held in the cache
+parameter:
+    Ystart : First buffer row (before rotation) the cache holds
+    Height : Number of rows the cache holds
+info:
+    The cache passed to Paint_NewImage then only needs WidthByte * Height
+    bytes, and holds buffer rows Ystart..Ystart+Height-1 of the image.
+    Drawing is clipped to the band; Paint_Clear clears just the band.
+    Paint_SetBand(0, HeightMemory) goes back to the whole image.
+******************************************************************************/
+void Paint_SetBand(PAINT &paint, UWORD Ystart, UWORD Height)
+{
+    if (Ystart >= paint.HeightMemory) {
+        Debug("Paint_SetBand Input exceeds the image height\r\n");
+        return;
+    }
+    if (Height > paint.HeightMemory - Ystart)
+        Height = paint.HeightMemory - Ystart;
+    paint.BandTop = Ystart;
+    paint.BandHeight = Height;
+    paint.HeightByte = Height;
+    Paint_SelectWriter(paint);
+}
+
+/******************************************************************************
+function: Area drawn since Paint_NewImage, Paint_SelectImage or Paint_ResetDirty
+parameter:
+    Xstart, Ystart : First buffer column and row (before rotation)
+    Xend, Yend     : One past the last column and row
+info:
+    Returns 0, leaving the arguments alone, if nothing was drawn. The area
+    is one rectangle around everything drawn, in image rows also when
+    banded, so a panel can be sent just those rows. Bytes written to
+    the image directly are not seen.
+******************************************************************************/
+UBYTE Paint_GetDirty(PAINT &paint, UWORD *Xstart, UWORD *Ystart, UWORD *Xend, UWORD *Yend)
+{
+    if (paint.DirtyXstart >= paint.DirtyXend)
+        return 0;
+    *Xstart = paint.DirtyXstart;
+    *Ystart = paint.DirtyYstart;
+    *Xend = paint.DirtyXend;
+    *Yend = paint.DirtyYend;
+    return 1;
+}
+
+void Paint_ResetDirty(PAINT &paint)
+{
+    paint.DirtyXstart = 0;
+    paint.DirtyYstart = 0;
+    paint.DirtyXend = 0;
+    paint.DirtyYend = 0;
+}
+
+/******************************************************************************
+function: Pixel writers
+info:
+    Paint_WritePixel<Rotate, Mirror, Scale> is Paint_SetPixel without the
+    bounds check, with the three switches resolved at compile time.
+    Paint_SelectWriter picks the instance for the current settings, and the
+    logical area (the Clip rectangle) whose pixels map into the buffer.
+******************************************************************************/
+template <UWORD Rotate, UBYTE Mirror, UBYTE Scale>
+static void Paint_WritePixel(PAINT *paint, UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    UWORD X, Y;
+    if (Rotate == ROTATE_0) {
+        X = Xpoint;
+        Y = Ypoint;
+    } else if (Rotate == ROTATE_90) {
+        X = paint->WidthMemory - Ypoint - 1;
+        Y = Xpoint;
+    } else if (Rotate == ROTATE_180) {
+        X = paint->WidthMemory - Xpoint - 1;
+        Y = paint->HeightMemory - Ypoint - 1;
+    } else {
+        X = Ypoint;
+        Y = paint->HeightMemory - Xpoint - 1;
+    }
+
+    if (Mirror & MIRROR_HORIZONTAL)
+        X = paint->WidthMemory - X - 1;
+    if (Mirror & MIRROR_VERTICAL)
+        Y = paint->HeightMemory - Y - 1;
+
+    if (Scale == 2) {
+        UDOUBLE Addr = X / 8 + (UDOUBLE)(Y - paint->BandTop) * paint->WidthByte;
+        UBYTE Rdata = paint->Image[Addr];
+        if (Color == BLACK)
+            paint->Image[Addr] = Rdata & ~(0x80 >> (X % 8));
+        else
+            paint->Image[Addr] = Rdata | (0x80 >> (X % 8));
+    } else if (Scale == 4) {
+        UDOUBLE Addr = X / 4 + (UDOUBLE)(Y - paint->BandTop) * paint->WidthByte;
+        Color = Color % 4;//Guaranteed color scale is 4  --- 0~3
+        UBYTE Rdata = paint->Image[Addr];
+        Rdata = Rdata & (~(0xC0 >> ((X % 4)*2)));
+        paint->Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
+    } else {
+        UDOUBLE Addr = X / 2 + (UDOUBLE)(Y - paint->BandTop) * paint->WidthByte;
+        UBYTE Rdata = paint->Image[Addr];
+        Rdata = Rdata & (~(0xF0 >> ((X % 2)*4)));//Clear first, then set value
+        paint->Image[Addr] = Rdata | ((Color << 4) >> ((X % 2)*4));
+    }
+}
+
+static void Paint_WriteNothing(PAINT *, UWORD, UWORD, UWORD)
+{
+}
+
+#define PAINT_WRITERS_SCALE(R, M) \
+    { Paint_WritePixel<R, M, 2>, Paint_WritePixel<R, M, 4>, Paint_WritePixel<R, M, 7> }
+#define PAINT_WRITERS_MIRROR(R) \
+    { PAINT_WRITERS_SCALE(R, MIRROR_NONE), PAINT_WRITERS_SCALE(R, MIRROR_HORIZONTAL), \
+      PAINT_WRITERS_SCALE(R, MIRROR_VERTICAL), PAINT_WRITERS_SCALE(R, MIRROR_ORIGIN) }
+
+static const PAINT_PIXEL_WRITER Paint_Writers[4][4][3] = {
+    PAINT_WRITERS_MIRROR(ROTATE_0),
+    PAINT_WRITERS_MIRROR(ROTATE_90),
+    PAINT_WRITERS_MIRROR(ROTATE_180),
+    PAINT_WRITERS_MIRROR(ROTATE_270),
+};
+
+static void Paint_SelectWriter(PAINT &paint)
+{
+    int Scale;
+    if (paint.Scale == 2)
+        Scale = 0;
+    else if (paint.Scale == 4)
+        Scale = 1;
+    else if (paint.Scale == 6 || paint.Scale == 7 || paint.Scale == 16)
+        Scale = 2;
+    else
+        Scale = -1;
+
+    const bool Valid = (paint.Rotate == ROTATE_0 || paint.Rotate == ROTATE_90 ||
+                        paint.Rotate == ROTATE_180 || paint.Rotate == ROTATE_270) &&
+                       paint.Mirror <= MIRROR_ORIGIN && Scale >= 0;
+    if (!Valid) {
+        paint.WritePixel = Paint_WriteNothing;
+        paint.ClipXstart = paint.ClipXend = 0;
+        paint.ClipYstart = paint.ClipYend = 0;
+        return;
+    }
+    paint.WritePixel = Paint_Writers[paint.Rotate / 90][paint.Mirror][Scale];
+
+    // Rotated by 90 or 270, logical X runs along the memory's height
+    const bool Swap = (paint.Rotate == ROTATE_90 || paint.Rotate == ROTATE_270);
+    const UWORD MaxX = Swap ? paint.HeightMemory : paint.WidthMemory;
+    const UWORD MaxY = Swap ? paint.WidthMemory : paint.HeightMemory;
+    UWORD Xstart = 0, Ystart = 0;
+    UWORD Xend = (paint.Width < MaxX) ? paint.Width : MaxX;
+    UWORD Yend = (paint.Height < MaxY) ? paint.Height : MaxY;
+
+    // The band is a range of buffer rows, i.e. of logical Y (or X when
+    // swapped), counted from the other end after 180/270 or a vertical flip
+    UWORD BandStart = paint.BandTop;
+    UWORD BandEnd = paint.BandTop + paint.BandHeight;
+    const bool Flip = (paint.Rotate == ROTATE_180 || paint.Rotate == ROTATE_270) !=
+                      ((paint.Mirror & MIRROR_VERTICAL) != 0);
+    if (Flip) {
+        const UWORD T = BandStart;
+        BandStart = paint.HeightMemory - BandEnd;
+        BandEnd = paint.HeightMemory - T;
+    }
+    if (Swap) {
+        Xstart = BandStart;
+        Xend = (Xend < BandEnd) ? Xend : BandEnd;
+    } else {
+        Ystart = BandStart;
+        Yend = (Yend < BandEnd) ? Yend : BandEnd;
+    }
+    paint.ClipXstart = Xstart;
+    paint.ClipYstart = Ystart;
+    paint.ClipXend = (Xend > Xstart) ? Xend : Xstart;
+    paint.ClipYend = (Yend > Ystart) ? Yend : Ystart;
 }
+
 /******************************************************************************
 function: Draw Pixels
 parameter:
@@ -185,77 +389,236 @@ parameter:
     Ypoint : At point Y
     Color  : Painted colors
 ******************************************************************************/
-void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+void Paint_SetPixel(PAINT &paint, UWORD Xpoint, UWORD Ypoint, UWORD Color)
 {
-    if(Xpoint >= Paint.Width || Ypoint >= Paint.Height){
+    if(Xpoint < paint.ClipXstart || Xpoint >= paint.ClipXend ||
+       Ypoint < paint.ClipYstart || Ypoint >= paint.ClipYend){
         Debug("Exceeding display boundaries\r\n");
         return;
-    }      
-    UWORD X, Y;
-    switch(Paint.Rotate) {
-    case 0:
-        X = Xpoint;
-        Y = Ypoint;  
-        break;
-    case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
+    }
+    paint.WritePixel(&paint, Xpoint, Ypoint, Color);
+    Paint_MarkDirty(paint, Xpoint, Ypoint, Xpoint + 1, Ypoint + 1);
+}
+
+// Paint_SetPixel without the log line: a primitive crossing the edge of the
+// image or of a band is expected to lose some pixels
+static void Paint_WriteChecked(PAINT *paint, UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    if (Xpoint >= paint->ClipXstart && Xpoint < paint->ClipXend &&
+        Ypoint >= paint->ClipYstart && Ypoint < paint->ClipYend)
+        paint->WritePixel(paint, Xpoint, Ypoint, Color);
+}
+
+/******************************************************************************
+function: Writer for a box of Width x Height pixels at (Xstart, Ystart)
+info:
+    The unchecked writer if the whole box is inside, Paint_WriteNothing if
+    none of it is, else one that checks every pixel, so callers clip once
+    per primitive.
+******************************************************************************/
+static PAINT_PIXEL_WRITER Paint_WriterFor(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height)
+{
+    const UDOUBLE Xend = (UDOUBLE)Xstart + Width;
+    const UDOUBLE Yend = (UDOUBLE)Ystart + Height;
+    if (Xstart >= paint.ClipXstart && Xend <= paint.ClipXend &&
+        Ystart >= paint.ClipYstart && Yend <= paint.ClipYend)
+        return paint.WritePixel;
+    if (Xstart >= paint.ClipXend || Xend <= paint.ClipXstart ||
+        Ystart >= paint.ClipYend || Yend <= paint.ClipYstart)
+        return Paint_WriteNothing;
+    return Paint_WriteChecked;
+}
+
+/******************************************************************************
+function: Map a logical point to the coordinates of a WidthMemory x
+          HeightMemory buffer drawn with Rotate and Mirror
+******************************************************************************/
+static inline void Paint_MapPoint(UWORD Rotate, UWORD Mirror, UWORD WidthMemory, UWORD HeightMemory,
+                                  UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    switch(Rotate) {
+    case ROTATE_90:
+        *X = WidthMemory - Ypoint - 1;
+        *Y = Xpoint;
         break;
-    case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
+    case ROTATE_180:
+        *X = WidthMemory - Xpoint - 1;
+        *Y = HeightMemory - Ypoint - 1;
         break;
-    case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
+    case ROTATE_270:
+        *X = Ypoint;
+        *Y = HeightMemory - Xpoint - 1;
         break;
     default:
+        *X = Xpoint;
+        *Y = Ypoint;
+        break;
+    }
+    if (Mirror & MIRROR_HORIZONTAL)
+        *X = WidthMemory - *X - 1;
+    if (Mirror & MIRROR_VERTICAL)
+        *Y = HeightMemory - *Y - 1;
+}
+
+/******************************************************************************
+function: Map a logical point to buffer coordinates (as Paint_WritePixel does)
+******************************************************************************/
+static void Paint_MapToMemory(PAINT &paint, UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    Paint_MapPoint(paint.Rotate, paint.Mirror, paint.WidthMemory, paint.HeightMemory, Xpoint, Ypoint, X, Y);
+}
+
+/******************************************************************************
+function: Add buffer pixels X0..X1 by Y0..Y1 (inclusive) to the dirty area
+******************************************************************************/
+static void Paint_MarkDirtyMemory(PAINT &paint, UWORD X0, UWORD Y0, UWORD X1, UWORD Y1)
+{
+    if (paint.DirtyXstart >= paint.DirtyXend) {
+        paint.DirtyXstart = X0;
+        paint.DirtyYstart = Y0;
+        paint.DirtyXend = X1 + 1;
+        paint.DirtyYend = Y1 + 1;
         return;
     }
-    
-    switch(Paint.Mirror) {
-    case MIRROR_NONE:
-        break;
-    case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
-        break;
-    case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
-        break;
-    default:
+    if (X0 < paint.DirtyXstart)
+        paint.DirtyXstart = X0;
+    if (Y0 < paint.DirtyYstart)
+        paint.DirtyYstart = Y0;
+    if (X1 >= paint.DirtyXend)
+        paint.DirtyXend = X1 + 1;
+    if (Y1 >= paint.DirtyYend)
+        paint.DirtyYend = Y1 + 1;
+}
+
+/******************************************************************************
+function: Add the logical box Xstart..Xend-1 by Ystart..Yend-1 to the dirty area
+info:
+    Clipped to the image (or band) first, so a primitive that is partly
+    outside only marks what it can have drawn.
+******************************************************************************/
+static void Paint_MarkDirty(PAINT &paint, int Xstart, int Ystart, int Xend, int Yend)
+{
+    if (Xstart < paint.ClipXstart)
+        Xstart = paint.ClipXstart;
+    if (Ystart < paint.ClipYstart)
+        Ystart = paint.ClipYstart;
+    if (Xend > paint.ClipXend)
+        Xend = paint.ClipXend;
+    if (Yend > paint.ClipYend)
+        Yend = paint.ClipYend;
+    if (Xstart >= Xend || Ystart >= Yend)
         return;
+
+    UWORD X0, Y0, X1, Y1;
+    Paint_MapToMemory(paint, Xstart, Ystart, &X0, &Y0);
+    Paint_MapToMemory(paint, Xend - 1, Yend - 1, &X1, &Y1);
+    Paint_MarkDirtyMemory(paint, (X0 < X1) ? X0 : X1, (Y0 < Y1) ? Y0 : Y1,
+                          (X0 < X1) ? X1 : X0, (Y0 < Y1) ? Y1 : Y0);
+}
+
+/******************************************************************************
+function: Fill pixels X0..X1 (inclusive) of buffer row Y
+parameter:
+    X0, X1, Y : Buffer coordinates, already clipped to the band
+    Color     : Painted color
+info:
+    Partial bytes at either end are masked, the bytes in between are set
+    with one memset. Pixels are MSB first at 1, 2 or 4 bits (scale 2, 4, 7).
+******************************************************************************/
+static void Paint_FillSpan(PAINT &paint, UWORD X0, UWORD X1, UWORD Y, UWORD Color)
+{
+    UBYTE Bits, Pattern;
+    if (paint.Scale == 2) {
+        Bits = 1;
+        Pattern = (Color == BLACK) ? 0x00 : 0xFF;
+    } else if (paint.Scale == 4) {
+        Bits = 2;
+        Pattern = (Color % 4) * 0x55;
+    } else {
+        Bits = 4;
+        Pattern = (Color & 0x0F) * 0x11;
     }
+    const UBYTE PerByte = 8 / Bits;
 
-    if(X >= Paint.WidthMemory || Y >= Paint.HeightMemory){
-        Debug("Exceeding display boundaries\r\n");
+    UBYTE *Row = paint.Image + (UDOUBLE)(Y - paint.BandTop) * paint.WidthByte;
+    const UWORD First = X0 / PerByte;
+    const UWORD Last = X1 / PerByte;
+    UBYTE HeadMask = 0xFF >> ((X0 % PerByte) * Bits);
+    const UBYTE TailMask = (UBYTE)(0xFF << ((PerByte - 1 - X1 % PerByte) * Bits));
+
+    if (First == Last) {
+        HeadMask &= TailMask;
+    } else {
+        memset(Row + First + 1, Pattern, Last - First - 1);
+        Row[Last] = (Row[Last] & ~TailMask) | (Pattern & TailMask);
+    }
+    Row[First] = (Row[First] & ~HeadMask) | (Pattern & HeadMask);
+}
+
+/******************************************************************************
+function: Fill a logical rectangle, Xstart..Xend-1 by Ystart..Yend-1
+info:
+    Clipped to the image. Rotation and mirroring map the rectangle to another
+    rectangle in the buffer, which is filled row by row.
+******************************************************************************/
+static void Paint_FillRect(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    if (Xstart < paint.ClipXstart)
+        Xstart = paint.ClipXstart;
+    if (Ystart < paint.ClipYstart)
+        Ystart = paint.ClipYstart;
+    if (Xend > paint.ClipXend)
+        Xend = paint.ClipXend;
+    if (Yend > paint.ClipYend)
+        Yend = paint.ClipYend;
+    if (Xstart >= Xend || Ystart >= Yend)
         return;
+
+    UWORD X0, Y0, X1, Y1;
+    Paint_MapToMemory(paint, Xstart, Ystart, &X0, &Y0);
+    Paint_MapToMemory(paint, Xend - 1, Yend - 1, &X1, &Y1);
+    if (X0 > X1) {
+        UWORD T = X0; X0 = X1; X1 = T;
     }
-    
-    if(Paint.Scale == 2){
-        UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
-        UBYTE Rdata = Paint.Image[Addr];
-        if(Color == BLACK)
-            Paint.Image[Addr] = Rdata & ~(0x80 >> (X % 8));
-        else
-            Paint.Image[Addr] = Rdata | (0x80 >> (X % 8));
-    }else if(Paint.Scale == 4){
-        UDOUBLE Addr = X / 4 + Y * Paint.WidthByte;
-        Color = Color % 4;//Guaranteed color scale is 4  --- 0~3
-        UBYTE Rdata = Paint.Image[Addr];
-        
-        Rdata = Rdata & (~(0xC0 >> ((X % 4)*2)));
-        Paint.Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
-    }else if(Paint.Scale == 6 || Paint.Scale == 7 || Paint.Scale == 16){
-		UDOUBLE Addr = X / 2  + Y * Paint.WidthByte;
-		UBYTE Rdata = Paint.Image[Addr];
-		Rdata = Rdata & (~(0xF0 >> ((X % 2)*4)));//Clear first, then set value
-		Paint.Image[Addr] = Rdata | ((Color << 4) >> ((X % 2)*4));
-		// printf("Add =  %d ,data = %d\r\n",Addr,Rdata);	
+    if (Y0 > Y1) {
+        UWORD T = Y0; Y0 = Y1; Y1 = T;
+    }
+    Paint_MarkDirtyMemory(paint, X0, Y0, X1, Y1);
+    for (UWORD Y = Y0; Y <= Y1; Y++) {
+        Paint_FillSpan(paint, X0, X1, Y, Color);
+    }
+}
+
+/******************************************************************************
+function: Fill what Paint_DrawPoint(DOT_FILL_AROUND) of every point in
+          X0..X1 by Y0..Y1 (inclusive) would
+info:
+    A point of size w covers x-w .. x+w-2. Points left of or above the image
+    are dropped, as are points whose square starts above row 0; columns left
+    of 0 are cut off.
+******************************************************************************/
+static void Paint_FillDots(PAINT &paint, int X0, int X1, int Y0, int Y1, UWORD Color, DOT_PIXEL Dot_Pixel)
+{
+    const int W = Dot_Pixel;
+    if (X0 > X1) {
+        int T = X0; X0 = X1; X1 = T;
     }
+    if (X0 < 0)
+        X0 = 0;
+    if (X1 > paint.Width - 1)
+        X1 = paint.Width - 1;
+    if (Y0 < W)
+        Y0 = W;
+    if (Y1 > paint.Height - 1)
+        Y1 = paint.Height - 1;
+    if (X0 > X1 || Y0 > Y1)
+        return;
+
+    const int Left = (X0 - W > 0) ? X0 - W : 0;
+    const int Right = X1 + W - 1;    // exclusive
+    if (Right <= Left)
+        return;
+    Paint_FillRect(paint, Left, Y0 - W, Right, Y1 + W - 1, Color);
 }
 
 /******************************************************************************
@@ -263,30 +626,20 @@ function: Clear the color of the picture
 parameter:
     Color : Painted colors
 ******************************************************************************/
-void Paint_Clear(UWORD Color)
+void Paint_Clear(PAINT &paint, UWORD Color)
 {
-    if(Paint.Scale == 2) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = Color;
-			}
-		}
-    }else if(Paint.Scale == 4) {
-        for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-            for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-                UDOUBLE Addr = X + Y*Paint.WidthByte;
-                Paint.Image[Addr] = (Color<<6)|(Color<<4)|(Color<<2)|Color;
-            }
-        }
-    }else if(Paint.Scale == 6 || Paint.Scale == 7 || Paint.Scale == 16) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = (Color<<4)|Color;
-			}
-		}		
-	}
+    UBYTE Data;
+    if(paint.Scale == 2) {
+        Data = Color;   //8 pixel =  1 byte
+    }else if(paint.Scale == 4) {
+        Data = (Color<<6)|(Color<<4)|(Color<<2)|Color;
+    }else if(paint.Scale == 6 || paint.Scale == 7 || paint.Scale == 16) {
+        Data = (Color<<4)|Color;
+    }else {
+        return;
+    }
+    memset(paint.Image, Data, (UDOUBLE)paint.WidthByte * paint.HeightByte);
+    Paint_MarkDirtyMemory(paint, 0, paint.BandTop, paint.WidthMemory - 1, paint.BandTop + paint.BandHeight - 1);
 }
 
 /******************************************************************************
@@ -298,14 +651,9 @@ parameter:
     Yend   : y end point
     Color  : Painted colors
 ******************************************************************************/
-void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+void Paint_ClearWindows(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
-    UWORD X, Y;
-    for (Y = Ystart; Y < Yend; Y++) {
-        for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
-        }
-    }
+    Paint_FillRect(paint, Xstart, Ystart, Xend, Yend, Color);
 }
 
 /******************************************************************************
@@ -317,33 +665,162 @@ parameter:
     Dot_Pixel	: point size
     Dot_Style	: point Style
 ******************************************************************************/
-void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+void Paint_DrawPoint(PAINT &paint, UWORD Xpoint, UWORD Ypoint, UWORD Color,
                      DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
 {
-    if (Xpoint >= Paint.Width || Ypoint >= Paint.Height) {
+    if (Xpoint >= paint.Width || Ypoint >= paint.Height) {
         Debug("Paint_DrawPoint Input exceeds the normal display range\r\n");
         return;
     }
 
+    // Nothing of the square falls in the image (or band)
+    if (Xpoint + Dot_Pixel - 1 <= paint.ClipXstart || Xpoint >= paint.ClipXend + Dot_Pixel ||
+        Ypoint + Dot_Pixel - 1 <= paint.ClipYstart || Ypoint >= paint.ClipYend + Dot_Pixel)
+        return;
+    Paint_MarkDirty(paint, Xpoint - Dot_Pixel, Ypoint - Dot_Pixel, Xpoint + Dot_Pixel - 1, Ypoint + Dot_Pixel - 1);
+
     int16_t XDir_Num , YDir_Num;
-    if (Dot_Style == DOT_FILL_AROUND) {
+    if (Dot_Style == DOT_FILL_AROUND &&
+        Xpoint >= paint.ClipXstart + Dot_Pixel && Ypoint >= paint.ClipYstart + Dot_Pixel &&
+        Xpoint + Dot_Pixel - 2 < paint.ClipXend && Ypoint + Dot_Pixel - 2 < paint.ClipYend) {
+        // The whole square is inside
+        for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
+            for (YDir_Num = 0; YDir_Num < 2 * Dot_Pixel - 1; YDir_Num++) {
+                paint.WritePixel(&paint, Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+            }
+        }
+    } else if (Dot_Style == DOT_FILL_AROUND) {
         for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num < 2 * Dot_Pixel - 1; YDir_Num++) {
                 if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
                     break;
                 // printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+                Paint_WriteChecked(&paint, Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
             }
         }
     } else {
         for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
-                Paint_SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
+                Paint_WriteChecked(&paint, Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
             }
         }
     }
 }
 
+/******************************************************************************
+function: Line rasterizer
+info:
+    A line is drawn as if Paint_DrawPoint(DOT_FILL_AROUND) were called at
+    every Bresenham step: a point of size w covers x-w .. x+w-2 (the same
+    for y), points whose square starts above row 0 are dropped, and on a
+    dotted line every third step is painted IMAGE_BACKGROUND, so a pixel
+    gets the color of the last step covering it.
+
+    The steps with one Y form a run. Output row j (in the order the line
+    walks) is covered by runs j-2w+2 .. j, kept in a ring, and is filled
+    once: a solid line from the first run's start to the last run's end,
+    a dotted one with each step's own pixel (the one no later step covers)
+    in its color, and the last step's full width.
+******************************************************************************/
+typedef struct {
+    int X, Y;               // current step
+    int Xend, Yend;
+    int dx, dy;
+    int XAddway, YAddway;
+    int Esp;                // cumulative error
+    UDOUBLE Step;           // index of the current step along the line
+    bool Done;
+} PAINT_LINE;
+
+typedef struct {
+    int Xfirst;             // X of the first step
+    int Count;              // steps in the run
+    UDOUBLE Step;           // index of the first step
+} PAINT_LINE_RUN;
+
+#define PAINT_LINE_MAX_RUNS (2 * DOT_PIXEL_8X8 - 1)
+
+// Spans shorter than this are written pixel by pixel
+#define PAINT_LINE_SHORT_SPAN 8
+
+static void Paint_LineBegin(PAINT_LINE *Line, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    Line->X = Xstart;
+    Line->Y = Ystart;
+    Line->Xend = Xend;
+    Line->Yend = Yend;
+    Line->dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
+    Line->dy = (int)Yend - (int)Ystart <= 0 ? Yend - Ystart : Ystart - Yend;
+    // Increment direction, 1 is positive, -1 is counter;
+    Line->XAddway = Xstart < Xend ? 1 : -1;
+    Line->YAddway = Ystart < Yend ? 1 : -1;
+    Line->Esp = Line->dx + Line->dy;
+    Line->Step = 0;
+    Line->Done = false;
+}
+
+// Walk the current run up to the first step of the next one
+static void Paint_LineNextRun(PAINT_LINE *Line, PAINT_LINE_RUN *Run)
+{
+    const int Y = Line->Y;
+    Run->Xfirst = Line->X;
+    Run->Step = Line->Step;
+    Run->Count = 1;
+    for (;;) {
+        if (2 * Line->Esp >= Line->dy) {
+            if (Line->X == Line->Xend)
+                break;
+            Line->Esp += Line->dy;
+            Line->X += Line->XAddway;
+        }
+        if (2 * Line->Esp <= Line->dx) {
+            if (Line->Y == Line->Yend)
+                break;
+            Line->Esp += Line->dx;
+            Line->Y += Line->YAddway;
+        }
+        Line->Step++;
+        if (Line->Y != Y)
+            return;
+        Run->Count++;
+    }
+    Line->Done = true;
+}
+
+// Fill logical row Y from X0 to X1 (inclusive); columns left of 0 are cut off
+static void Paint_LineSpan(PAINT &paint, int X0, int X1, int Y, UWORD Color, PAINT_PIXEL_WRITER Write)
+{
+    if (X0 < 0)
+        X0 = 0;
+    if (X1 - X0 >= PAINT_LINE_SHORT_SPAN) {
+        Paint_FillRect(paint, X0, Y, X1 + 1, Y + 1, Color);
+        return;
+    }
+    // As Paint_FillSpan, keep a scale 7 color to its own pixel
+    if (paint.Scale == 7)
+        Color &= 0x0F;
+    for (int X = X0; X <= X1; X++)
+        Write(&paint, X, Y, Color);
+}
+
+// Count pixels from X along XAddway, one per step from Step on, in the
+// colors of a dotted line
+static void Paint_LineDots(PAINT &paint, int X, int XAddway, int Count, UDOUBLE Step, int Y,
+                           UWORD Color, PAINT_PIXEL_WRITER Write)
+{
+    UWORD Colors[3] = {Color, Color, IMAGE_BACKGROUND};
+    if (paint.Scale == 7) {
+        Colors[0] = Colors[1] = Color & 0x0F;
+        Colors[2] = IMAGE_BACKGROUND & 0x0F;
+    }
+    UBYTE Phase = Step % 3;
+    for (int i = 0; i < Count; i++, X += XAddway) {
+        if (X >= 0)
+            Write(&paint, X, Y, Colors[Phase]);
+        Phase = (Phase == 2) ? 0 : Phase + 1;
+    }
+}
+
 /******************************************************************************
 function: Draw a line of arbitrary slope
 parameter:
@@ -352,53 +829,91 @@ parameter:
     Xend   ：End point Xpoint coordinate
     Yend   ：End point Ypoint coordinate
     Color  ：The color of the line segment
-    Line_width : Line width
+    Line_width : Line width, at most DOT_PIXEL_8X8
     Line_Style: Solid and dotted lines
 ******************************************************************************/
-void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void Paint_DrawLine(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                     UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
 {
-    if (Xstart >= Paint.Width || Ystart >= Paint.Height ||
-        Xend >= Paint.Width || Yend >= Paint.Height) {
+    if (Xstart >= paint.Width || Ystart >= paint.Height ||
+        Xend >= paint.Width || Yend >= paint.Height) {
         Debug("Paint_DrawLine Input exceeds the normal display range\r\n");
         return;
     }
 
-    UWORD Xpoint = Xstart;
-    UWORD Ypoint = Ystart;
-    int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
-    int dy = (int)Yend - (int)Ystart <= 0 ? Yend - Ystart : Ystart - Yend;
+    const int W = (Line_width < DOT_PIXEL_8X8) ? Line_width : DOT_PIXEL_8X8;
+    const bool Dotted = (Line_Style == LINE_STYLE_DOTTED);
+    if (!Dotted && (Xstart == Xend || Ystart == Yend)) {
+        // Horizontal or vertical: one rectangle
+        Paint_FillDots(paint, Xstart, Xend, (Ystart < Yend) ? Ystart : Yend, (Ystart < Yend) ? Yend : Ystart,
+                       Color, (DOT_PIXEL)W);
+        return;
+    }
 
-    // Increment direction, 1 is positive, -1 is counter;
-    int XAddway = Xstart < Xend ? 1 : -1;
-    int YAddway = Ystart < Yend ? 1 : -1;
+    // Everything the points can cover, columns left of 0 cut off
+    const int Left = ((Xstart < Xend) ? Xstart : Xend) - W;
+    const int Top = ((Ystart < Yend) ? Ystart : Yend) - W;
+    const int Right = ((Xstart < Xend) ? Xend : Xstart) + W - 2;
+    const int Bottom = ((Ystart < Yend) ? Yend : Ystart) + W - 2;
+    const PAINT_PIXEL_WRITER Write = Paint_WriterFor(paint, (Left > 0) ? Left : 0, (Top > 0) ? Top : 0,
+                                                     Right - ((Left > 0) ? Left : 0) + 1,
+                                                     Bottom - ((Top > 0) ? Top : 0) + 1);
+    if (Write == Paint_WriteNothing)
+        return;
+    Paint_MarkDirty(paint, Left, Top, Right + 1, Bottom + 1);
 
-    //Cumulative error
-    int Esp = dx + dy;
-    char Dotted_Len = 0;
+    PAINT_LINE Line;
+    PAINT_LINE_RUN Runs[PAINT_LINE_MAX_RUNS];
+    Paint_LineBegin(&Line, Xstart, Ystart, Xend, Yend);
+    // Runs above row W are dropped: a prefix of the line, or its end
+    while (!Line.Done && Line.Y < W)
+        Paint_LineNextRun(&Line, &Runs[0]);
+    if (Line.Done && Line.Y < W)
+        return;
 
-    for (;;) {
-        Dotted_Len++;
-        //Painted dotted line, 2 point is really virtual
-        if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
-            //Debug("LINE_DOTTED\r\n");
-            Paint_DrawPoint(Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
-            Dotted_Len = 0;
-        } else {
-            Paint_DrawPoint(Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+    const int XAddway = Line.XAddway;
+    const int YAddway = Line.YAddway;
+    const int Ytop = (YAddway > 0) ? Line.Y - W : Line.Y + W - 2;
+    int Newest = -1;
+    for (int j = 0; ; j++) {
+        // Run j joins the window, which then holds runs Oldest .. Newest
+        if (!Line.Done && Line.Y >= W) {
+            Paint_LineNextRun(&Line, &Runs[j % PAINT_LINE_MAX_RUNS]);
+            Newest = j;
         }
-        if (2 * Esp >= dy) {
-            if (Xpoint == Xend)
-                break;
-            Esp += dy;
-            Xpoint += XAddway;
+        const int Oldest = (j - 2 * W + 2 > 0) ? j - 2 * W + 2 : 0;
+        if (Oldest > Newest)
+            break;
+
+        const int Y = Ytop + YAddway * j;
+        if ((YAddway > 0) ? Y >= paint.ClipYend : Y < paint.ClipYstart)
+            break;
+        if (Y < paint.ClipYstart || Y >= paint.ClipYend)
+            continue;
+
+        const PAINT_LINE_RUN *First = &Runs[Oldest % PAINT_LINE_MAX_RUNS];
+        const PAINT_LINE_RUN *Last = &Runs[Newest % PAINT_LINE_MAX_RUNS];
+        const int Xlast = Last->Xfirst + XAddway * (Last->Count - 1);
+        if (!Dotted) {
+            const int Lo = (First->Xfirst < Xlast) ? First->Xfirst : Xlast;
+            const int Hi = (First->Xfirst < Xlast) ? Xlast : First->Xfirst;
+            Paint_LineSpan(paint, Lo - W, Hi + W - 2, Y, Color, Write);
+            continue;
         }
-        if (2 * Esp <= dx) {
-            if (Ypoint == Yend)
-                break;
-            Esp += dx;
-            Ypoint += YAddway;
+
+        // Within a run every step moves X, so owns a pixel; the last step of
+        // a run only if the next run starts at another X
+        const int Own = (XAddway > 0) ? -W : W - 2;
+        for (int k = Oldest; k <= Newest; k++) {
+            const PAINT_LINE_RUN *Run = &Runs[k % PAINT_LINE_MAX_RUNS];
+            int Count = Run->Count;
+            if (k == Newest ||
+                Runs[(k + 1) % PAINT_LINE_MAX_RUNS].Xfirst == Run->Xfirst + XAddway * (Run->Count - 1))
+                Count--;
+            Paint_LineDots(paint, Run->Xfirst + Own, XAddway, Count, Run->Step, Y, Color, Write);
         }
+        const UDOUBLE Step = Last->Step + Last->Count - 1;
+        Paint_LineSpan(paint, Xlast - W, Xlast + W - 2, Y, (Step % 3 == 2) ? IMAGE_BACKGROUND : Color, Write);
     }
 }
 
@@ -413,25 +928,24 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the rectangle
 ******************************************************************************/
-void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void Paint_DrawRectangle(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                          UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (Xstart >= Paint.Width || Ystart >= Paint.Height ||
-        Xend >= Paint.Width || Yend >= Paint.Height) {
+    if (Xstart >= paint.Width || Ystart >= paint.Height ||
+        Xend >= paint.Width || Yend >= paint.Height) {
         Debug("Input exceeds the normal display range\r\n");
         return;
     }
 
     if (Draw_Fill) {
-        UWORD Ypoint;
-        for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
-            Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
-        }
+        // One line of Line_width points per row Ystart..Yend-1
+        if (Ystart < Yend)
+            Paint_FillDots(paint, Xstart, Xend, Ystart, Yend - 1, Color, Line_width);
     } else {
-        Paint_DrawLine(Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(paint, Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(paint, Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(paint, Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Paint_DrawLine(paint, Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
     }
 }
 
@@ -446,10 +960,10 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the Circle
 ******************************************************************************/
-void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+void Paint_DrawCircle(PAINT &paint, UWORD X_Center, UWORD Y_Center, UWORD Radius,
                       UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (X_Center >= Paint.Width || Y_Center >= Paint.Height) {
+    if (X_Center >= paint.Width || Y_Center >= paint.Height) {
         Debug("Paint_DrawCircle Input exceeds the normal display range\r\n");
         return;
     }
@@ -462,22 +976,18 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
-    int16_t sCountY;
     if (Draw_Fill == DRAW_FILL_FULL) {
+        // The eight octants fill every row Y_Center +- d from -h(d) to +h(d).
+        // Row XCurrent reaches YCurrent, and row YCurrent reaches XCurrent
+        // just before YCurrent moves past it; rows may be filled twice.
         while (XCurrent <= YCurrent ) { //Realistic circles
-            for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-            }
+            Paint_FillDots(paint, X_Center - YCurrent, X_Center + YCurrent, Y_Center + XCurrent, Y_Center + XCurrent, Color, DOT_PIXEL_DFT);
+            Paint_FillDots(paint, X_Center - YCurrent, X_Center + YCurrent, Y_Center - XCurrent, Y_Center - XCurrent, Color, DOT_PIXEL_DFT);
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
             else {
+                Paint_FillDots(paint, X_Center - XCurrent, X_Center + XCurrent, Y_Center + YCurrent, Y_Center + YCurrent, Color, DOT_PIXEL_DFT);
+                Paint_FillDots(paint, X_Center - XCurrent, X_Center + XCurrent, Y_Center - YCurrent, Y_Center - YCurrent, Color, DOT_PIXEL_DFT);
                 Esp += 10 + 4 * (XCurrent - YCurrent );
                 YCurrent --;
             }
@@ -485,14 +995,14 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
         }
     } else { //Draw a hollow circle
         while (XCurrent <= YCurrent ) {
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
+            Paint_DrawPoint(paint, X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
+            Paint_DrawPoint(paint, X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
+            Paint_DrawPoint(paint, X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
+            Paint_DrawPoint(paint, X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
+            Paint_DrawPoint(paint, X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
+            Paint_DrawPoint(paint, X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
+            Paint_DrawPoint(paint, X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
+            Paint_DrawPoint(paint, X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
 
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
@@ -506,54 +1016,247 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
 }
 
 /******************************************************************************
-function: Show English characters
+function: Glyph blitter
+info:
+    Paint_NibbleMask[b] spreads the 8 pixels of font byte b (MSB = left) to
+    8 nibbles, 0xF where the bit is set, leftmost pixel in the top nibble.
+    At scale 7 a glyph row then takes one lookup per 8 pixels and one
+    masked write per byte (two pixels), instead of a pixel writer call for
+    every pixel.
+******************************************************************************/
+static const UDOUBLE Paint_NibbleMask[256] = {
+    0x00000000, 0x0000000F, 0x000000F0, 0x000000FF, 0x00000F00, 0x00000F0F, 0x00000FF0, 0x00000FFF,
+    0x0000F000, 0x0000F00F, 0x0000F0F0, 0x0000F0FF, 0x0000FF00, 0x0000FF0F, 0x0000FFF0, 0x0000FFFF,
+    0x000F0000, 0x000F000F, 0x000F00F0, 0x000F00FF, 0x000F0F00, 0x000F0F0F, 0x000F0FF0, 0x000F0FFF,
+    0x000FF000, 0x000FF00F, 0x000FF0F0, 0x000FF0FF, 0x000FFF00, 0x000FFF0F, 0x000FFFF0, 0x000FFFFF,
+    0x00F00000, 0x00F0000F, 0x00F000F0, 0x00F000FF, 0x00F00F00, 0x00F00F0F, 0x00F00FF0, 0x00F00FFF,
+    0x00F0F000, 0x00F0F00F, 0x00F0F0F0, 0x00F0F0FF, 0x00F0FF00, 0x00F0FF0F, 0x00F0FFF0, 0x00F0FFFF,
+    0x00FF0000, 0x00FF000F, 0x00FF00F0, 0x00FF00FF, 0x00FF0F00, 0x00FF0F0F, 0x00FF0FF0, 0x00FF0FFF,
+    0x00FFF000, 0x00FFF00F, 0x00FFF0F0, 0x00FFF0FF, 0x00FFFF00, 0x00FFFF0F, 0x00FFFFF0, 0x00FFFFFF,
+    0x0F000000, 0x0F00000F, 0x0F0000F0, 0x0F0000FF, 0x0F000F00, 0x0F000F0F, 0x0F000FF0, 0x0F000FFF,
+    0x0F00F000, 0x0F00F00F, 0x0F00F0F0, 0x0F00F0FF, 0x0F00FF00, 0x0F00FF0F, 0x0F00FFF0, 0x0F00FFFF,
+    0x0F0F0000, 0x0F0F000F, 0x0F0F00F0, 0x0F0F00FF, 0x0F0F0F00, 0x0F0F0F0F, 0x0F0F0FF0, 0x0F0F0FFF,
+    0x0F0FF000, 0x0F0FF00F, 0x0F0FF0F0, 0x0F0FF0FF, 0x0F0FFF00, 0x0F0FFF0F, 0x0F0FFFF0, 0x0F0FFFFF,
+    0x0FF00000, 0x0FF0000F, 0x0FF000F0, 0x0FF000FF, 0x0FF00F00, 0x0FF00F0F, 0x0FF00FF0, 0x0FF00FFF,
+    0x0FF0F000, 0x0FF0F00F, 0x0FF0F0F0, 0x0FF0F0FF, 0x0FF0FF00, 0x0FF0FF0F, 0x0FF0FFF0, 0x0FF0FFFF,
+    0x0FFF0000, 0x0FFF000F, 0x0FFF00F0, 0x0FFF00FF, 0x0FFF0F00, 0x0FFF0F0F, 0x0FFF0FF0, 0x0FFF0FFF,
+    0x0FFFF000, 0x0FFFF00F, 0x0FFFF0F0, 0x0FFFF0FF, 0x0FFFFF00, 0x0FFFFF0F, 0x0FFFFFF0, 0x0FFFFFFF,
+    0xF0000000, 0xF000000F, 0xF00000F0, 0xF00000FF, 0xF0000F00, 0xF0000F0F, 0xF0000FF0, 0xF0000FFF,
+    0xF000F000, 0xF000F00F, 0xF000F0F0, 0xF000F0FF, 0xF000FF00, 0xF000FF0F, 0xF000FFF0, 0xF000FFFF,
+    0xF00F0000, 0xF00F000F, 0xF00F00F0, 0xF00F00FF, 0xF00F0F00, 0xF00F0F0F, 0xF00F0FF0, 0xF00F0FFF,
+    0xF00FF000, 0xF00FF00F, 0xF00FF0F0, 0xF00FF0FF, 0xF00FFF00, 0xF00FFF0F, 0xF00FFFF0, 0xF00FFFFF,
+    0xF0F00000, 0xF0F0000F, 0xF0F000F0, 0xF0F000FF, 0xF0F00F00, 0xF0F00F0F, 0xF0F00FF0, 0xF0F00FFF,
+    0xF0F0F000, 0xF0F0F00F, 0xF0F0F0F0, 0xF0F0F0FF, 0xF0F0FF00, 0xF0F0FF0F, 0xF0F0FFF0, 0xF0F0FFFF,
+    0xF0FF0000, 0xF0FF000F, 0xF0FF00F0, 0xF0FF00FF, 0xF0FF0F00, 0xF0FF0F0F, 0xF0FF0FF0, 0xF0FF0FFF,
+    0xF0FFF000, 0xF0FFF00F, 0xF0FFF0F0, 0xF0FFF0FF, 0xF0FFFF00, 0xF0FFFF0F, 0xF0FFFFF0, 0xF0FFFFFF,
+    0xFF000000, 0xFF00000F, 0xFF0000F0, 0xFF0000FF, 0xFF000F00, 0xFF000F0F, 0xFF000FF0, 0xFF000FFF,
+    0xFF00F000, 0xFF00F00F, 0xFF00F0F0, 0xFF00F0FF, 0xFF00FF00, 0xFF00FF0F, 0xFF00FFF0, 0xFF00FFFF,
+    0xFF0F0000, 0xFF0F000F, 0xFF0F00F0, 0xFF0F00FF, 0xFF0F0F00, 0xFF0F0F0F, 0xFF0F0FF0, 0xFF0F0FFF,
+    0xFF0FF000, 0xFF0FF00F, 0xFF0FF0F0, 0xFF0FF0FF, 0xFF0FFF00, 0xFF0FFF0F, 0xFF0FFFF0, 0xFF0FFFFF,
+    0xFFF00000, 0xFFF0000F, 0xFFF000F0, 0xFFF000FF, 0xFFF00F00, 0xFFF00F0F, 0xFFF00FF0, 0xFFF00FFF,
+    0xFFF0F000, 0xFFF0F00F, 0xFFF0F0F0, 0xFFF0F0FF, 0xFFF0FF00, 0xFFF0FF0F, 0xFFF0FFF0, 0xFFF0FFFF,
+    0xFFFF0000, 0xFFFF000F, 0xFFFF00F0, 0xFFFF00FF, 0xFFFF0F00, 0xFFFF0F0F, 0xFFFF0FF0, 0xFFFF0FFF,
+    0xFFFFF000, 0xFFFFF00F, 0xFFFFF0F0, 0xFFFFF0FF, 0xFFFFFF00, 0xFFFFFF0F, 0xFFFFFFF0, 0xFFFFFFFF,
+};
+
+/******************************************************************************
+function: Merge 8 nibbles of a glyph row into the buffer
 parameter:
-    Xpoint           ：X coordinate
-    Ypoint           ：Y coordinate
-    Acsii_Char       ：To display the English characters
-    Font             ：A structure pointer that displays a character size
-    Color_Foreground : Select the foreground color
-    Color_Background : Select the background color
+    Dst  : First of the 4 buffer bytes
+    Ext  : Nibbles inside the glyph box
+    Set  : Nibbles of set font bits, within Ext
+    Fg   : Foreground color in both nibbles
+    Bg   : Background color in both nibbles
+    Opaque : Whether unset bits are painted with Bg
 ******************************************************************************/
-void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
-                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+static void Paint_MergeNibbles(UBYTE *Dst, UDOUBLE Ext, UDOUBLE Set, UBYTE Fg, UBYTE Bg, bool Opaque)
 {
-    UWORD Page, Column;
-
-    if (Xpoint >= Paint.Width || Ypoint >= Paint.Height) {
-        Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
+    const UDOUBLE Cover = Opaque ? Ext : Set;
+    if (Cover == 0)
         return;
+    for (int i = 0; i < 4; i++) {
+        const UBYTE P = (UBYTE)(Cover >> (24 - 8 * i));
+        if (P == 0)
+            continue;
+        const UBYTE S = (UBYTE)(Set >> (24 - 8 * i));
+        Dst[i] = (Dst[i] & ~P) | (Fg & S) | (Bg & P & ~S);
     }
+}
 
-    uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
-    const unsigned char *ptr = &Font->table[Char_Offset];
+/******************************************************************************
+function: Blit a 1bpp glyph to buffer coordinates at scale 7
+parameter:
+    X, Y    : Buffer position of the glyph's top left pixel
+    Bits    : Top row, Stride bytes wide, MSB first
+    Step    : Offset from one row to the next; negative flips the glyph
+    Width, Height : Glyph size in pixels
+info:
+    The glyph must lie inside the buffer (and band). An odd X moves every
+    mask by one nibble, carried over into the next byte.
+******************************************************************************/
+static void Paint_BlitGlyph(PAINT &paint, UWORD X, UWORD Y, const unsigned char *Bits, UWORD Stride, int Step,
+                            UWORD Width, UWORD Height, UWORD Color_Foreground, UWORD Color_Background)
+{
+    const bool Opaque = (Color_Background != FONT_BACKGROUND);
+    const UBYTE Fg = (Color_Foreground & 0x0F) * 0x11;
+    const UBYTE Bg = (Color_Background & 0x0F) * 0x11;
+    const bool Odd = X % 2;
+    const UBYTE Tail = (Width % 8) ? (UBYTE)(0xFF << (8 - Width % 8)) : 0xFF;
 
-    for (Page = 0; Page < Font->Height; Page ++ ) {
-        for (Column = 0; Column < Font->Width; Column ++ ) {
+    UBYTE *Row = paint.Image + (UDOUBLE)(Y - paint.BandTop) * paint.WidthByte + X / 2;
+    for (UWORD j = 0; j < Height; j++, Row += paint.WidthByte, Bits += Step) {
+        UBYTE *Dst = Row;
+        UDOUBLE CarryExt = 0, CarrySet = 0;
+        for (UWORD k = 0; k < Stride; k++, Dst += 4) {
+            const UDOUBLE Ext = Paint_NibbleMask[(k == Stride - 1) ? Tail : 0xFF];
+            const UDOUBLE Set = Paint_NibbleMask[Bits[k]] & Ext;
+            if (!Odd) {
+                Paint_MergeNibbles(Dst, Ext, Set, Fg, Bg, Opaque);
+            } else {
+                Paint_MergeNibbles(Dst, CarryExt | (Ext >> 4), CarrySet | (Set >> 4), Fg, Bg, Opaque);
+                CarryExt = Ext << 28;
+                CarrySet = Set << 28;
+            }
+        }
+        if (Odd && CarryExt)
+            Paint_MergeNibbles(Dst, CarryExt, CarrySet, Fg, Bg, Opaque);
+    }
+}
+
+/******************************************************************************
+function: Draw a 1bpp glyph at logical (Xpoint, Ypoint)
+parameter:
+    Bits   : Rows of (Width + 7) / 8 bytes, MSB first, as in sFONT and cFONT
+info:
+    At scale 7, a glyph fully inside the image is blitted. With rotation or
+    mirroring it is first rotated into buffer orientation, so the blitter
+    itself never maps coordinates. Everything else goes through the pixel
+    writers, one pixel at a time.
+******************************************************************************/
+static void Paint_DrawGlyph(PAINT &paint, UWORD Xpoint, UWORD Ypoint, const unsigned char *Bits, UWORD Width, UWORD Height,
+                            UWORD Color_Foreground, UWORD Color_Background)
+{
+    const UWORD Stride = Width / 8 + (Width % 8 ? 1 : 0);
+    const PAINT_PIXEL_WRITER Write = Paint_WriterFor(paint, Xpoint, Ypoint, Width, Height);
+    if (Write == Paint_WriteNothing)
+        return;
+    Paint_MarkDirty(paint, Xpoint, Ypoint, Xpoint + Width, Ypoint + Height);
+
+    // Colors above 15 spill into the neighbouring pixel in Paint_WritePixel;
+    // leave those to it
+    const bool Blit = (Write == paint.WritePixel && paint.Scale == 7 && Color_Foreground <= 0x0F &&
+                       (Color_Background == FONT_BACKGROUND || Color_Background <= 0x0F));
+    if (Blit) {
+        UWORD Xa, Ya, Xb, Yb;
+        Paint_MapToMemory(paint, Xpoint, Ypoint, &Xa, &Ya);
+        Paint_MapToMemory(paint, Xpoint + Width - 1, Ypoint + Height - 1, &Xb, &Yb);
+        const bool MirrorH = (paint.Mirror & MIRROR_HORIZONTAL) != 0;
+        if ((paint.Rotate == ROTATE_0 && !MirrorH) || (paint.Rotate == ROTATE_180 && MirrorH)) {
+            // Columns still run left to right in the buffer, so at most the rows
+            // need flipping: blit them bottom up
+            if (Ya > Yb)
+                Paint_BlitGlyph(paint, Xa, Yb, Bits + (UDOUBLE)(Height - 1) * Stride, Stride, -(int)Stride,
+                                Width, Height, Color_Foreground, Color_Background);
+            else
+                Paint_BlitGlyph(paint, Xa, Ya, Bits, Stride, Stride, Width, Height, Color_Foreground, Color_Background);
+            return;
+        }
+        if (Width <= MAX_HEIGHT_FONT && Height <= MAX_HEIGHT_FONT) {
+            // Rotate into buffer orientation: map the glyph's origin, then step
+            // along the buffer axes that its columns and rows run along
+            const bool Swap = (paint.Rotate == ROTATE_90 || paint.Rotate == ROTATE_270);
+            int ColX = 0, ColY = 0, RowX = 0, RowY = 0;
+            switch (paint.Rotate) {
+            case ROTATE_90:  RowX = -1; ColY = 1;  break;
+            case ROTATE_180: ColX = -1; RowY = -1; break;
+            case ROTATE_270: RowX = 1;  ColY = -1; break;
+            default:         ColX = 1;  RowY = 1;  break;
+            }
+            if (paint.Mirror & MIRROR_HORIZONTAL) {
+                ColX = -ColX;
+                RowX = -RowX;
+            }
+            if (paint.Mirror & MIRROR_VERTICAL) {
+                ColY = -ColY;
+                RowY = -RowY;
+            }
+            const UWORD BoxWidth = Swap ? Height : Width;
+            const UWORD BoxHeight = Swap ? Width : Height;
+            const UWORD BoxStride = BoxWidth / 8 + (BoxWidth % 8 ? 1 : 0);
+
+            // Glyph pixel (0, 0) lands at (X0, Y0) of the rotated box
+            const int X0 = (ColX < 0 || RowX < 0) ? BoxWidth - 1 : 0;
+            const int Y0 = (ColY < 0 || RowY < 0) ? BoxHeight - 1 : 0;
+            UBYTE Rotated[MAX_HEIGHT_FONT * ((MAX_HEIGHT_FONT + 7) / 8)];
+            memset(Rotated, 0, (UDOUBLE)BoxStride * BoxHeight);
+            const UBYTE Tail = (Width % 8) ? (UBYTE)(0xFF << (8 - Width % 8)) : 0xFF;
+            for (UWORD j = 0; j < Height; j++) {
+                const unsigned char *Src = Bits + (UDOUBLE)j * Stride;
+                for (UWORD k = 0; k < Stride; k++) {
+                    // Visit the set bits only; most of a glyph is empty
+                    unsigned int b = Src[k] & ((k == Stride - 1) ? Tail : 0xFF);
+                    while (b) {
+                        const int Bit = __builtin_clz(b) - (int)(8 * sizeof(b) - 8);
+                        b &= ~(0x80u >> Bit);
+                        const int i = k * 8 + Bit;
+                        const int X = X0 + ColX * i + RowX * j;
+                        const int Y = Y0 + ColY * i + RowY * j;
+                        Rotated[Y * BoxStride + X / 8] |= 0x80 >> (X % 8);
+                    }
+                }
+            }
+            Paint_BlitGlyph(paint, (Xa < Xb) ? Xa : Xb, (Ya < Yb) ? Ya : Yb, Rotated, BoxStride, BoxStride,
+                            BoxWidth, BoxHeight, Color_Foreground, Color_Background);
+            return;
+        }
+    }
+
+    for (UWORD Page = 0; Page < Height; Page ++ ) {
+        for (UWORD Column = 0; Column < Width; Column ++ ) {
 
             //To determine whether the font background color and screen background color is consistent
             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                if (*Bits & (0x80 >> (Column % 8)))
+                    Write(&paint, Xpoint + Column, Ypoint + Page, Color_Foreground);
             } else {
-                if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                if (*Bits & (0x80 >> (Column % 8))) {
+                    Write(&paint, Xpoint + Column, Ypoint + Page, Color_Foreground);
                 } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                    Write(&paint, Xpoint + Column, Ypoint + Page, Color_Background);
                 }
             }
             //One pixel is 8 bits
             if (Column % 8 == 7)
-                ptr++;
+                Bits++;
         }// Write a line
-        if (Font->Width % 8 != 0)
-            ptr++;
+        if (Width % 8 != 0)
+            Bits++;
     }// Write all
 }
 
+/******************************************************************************
+function: Show English characters
+parameter:
+    Xpoint           ：X coordinate
+    Ypoint           ：Y coordinate
+    Acsii_Char       ：To display the English characters
+    Font             ：A structure pointer that displays a character size
+    Color_Foreground : Select the foreground color
+    Color_Background : Select the background color
+******************************************************************************/
+void Paint_DrawChar(PAINT &paint, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    if (Xpoint >= paint.Width || Ypoint >= paint.Height) {
+        Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
+        return;
+    }
+
+    uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
+    const unsigned char *ptr = &Font->table[Char_Offset];
+    Paint_DrawGlyph(paint, Xpoint, Ypoint, ptr, Font->Width, Font->Height, Color_Foreground, Color_Background);
+}
+
 /******************************************************************************
 function:	Display the string
 parameter:
@@ -564,30 +1267,30 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
+void Paint_DrawString_EN(PAINT &paint, UWORD Xstart, UWORD Ystart, const char * pString,
                          sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
 
-    if (Xstart >= Paint.Width || Ystart >= Paint.Height) {
+    if (Xstart >= paint.Width || Ystart >= paint.Height) {
         Debug("Paint_DrawString_EN Input exceeds the normal display range\r\n");
         return;
     }
 
     while (* pString != '\0') {
         //if X direction filled , reposition to(Xstart,Ypoint),Ypoint is Y direction plus the Height of the character
-        if ((Xpoint + Font->Width ) > Paint.Width ) {
+        if ((Xpoint + Font->Width ) > paint.Width ) {
             Xpoint = Xstart;
             Ypoint += Font->Height;
         }
 
         // If the Y direction is full, reposition to(Xstart, Ystart)
-        if ((Ypoint  + Font->Height ) > Paint.Height ) {
+        if ((Ypoint  + Font->Height ) > paint.Height ) {
             Xpoint = Xstart;
             Ypoint = Ystart;
         }
-        Paint_DrawChar(Xpoint, Ypoint, * pString, Font, Color_Foreground, Color_Background);
+        Paint_DrawChar(paint, Xpoint, Ypoint, * pString, Font, Color_Foreground, Color_Background);
 
         //The next character of the address
         pString ++;
@@ -598,6 +1301,44 @@ void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
 }
 
 
+/******************************************************************************
+function: Find the glyph of one character in a cFONT
+parameter:
+    font : Font to search
+    Code : The character's UTF-8 bytes, 1 (ASCII) or 3 (Chinese)
+    Len  : Number of bytes in Code
+info:
+    Printable ASCII goes straight through font->ASCII_Index. Everything
+    else is bisected in font->table, which is sorted by index.
+******************************************************************************/
+static const CH_CN *Paint_FindCN(const cFONT *font, const char *Code, UBYTE Len)
+{
+    const UBYTE First = (UBYTE)Code[0];
+    if (Len == 1 && font->ASCII_Index != NULL && First >= ' ' && First <= '~') {
+        const UBYTE Entry = font->ASCII_Index[First - ' '];
+        return (Entry == CN_ASCII_NONE) ? NULL : &font->table[Entry];
+    }
+
+    UWORD Low = 0, High = font->size;
+    while (Low < High) {
+        const UWORD Mid = (Low + High) / 2;
+        const unsigned char *Index = font->table[Mid].index;
+        int Diff = 0;
+        for (UBYTE i = 0; i < Len && Diff == 0; i++)
+            Diff = (int)Index[i] - (int)(UBYTE)Code[i];
+        // An ASCII entry is one byte: it sorts before any longer code
+        if (Diff == 0 && Len == 1 && Index[1] != 0)
+            Diff = 1;
+        if (Diff == 0)
+            return &font->table[Mid];
+        if (Diff < 0)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+    return NULL;
+}
+
 /******************************************************************************
 function: Display the string
 parameter:
@@ -609,12 +1350,12 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
+void Paint_DrawString_CN(PAINT &paint, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
                         UWORD Color_Foreground, UWORD Color_Background)
 {
     const char* p_text = pString;
     int x = Xstart, y = Ystart;
-    int i, j,Num;
+    const CH_CN *Glyph;
     // for (size_t i = 0; p_text[i] != 0; i++)
     // {
     //     Serial.println(*(p_text+i)&0xff, HEX);
@@ -632,75 +1373,21 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
     /* Send the string character by character on EPD */
     while (*p_text != 0) {
         if((*p_text&0xff) <= 0x7F) {  //ASCII < 126
-            for(Num = 0; Num < font->size; Num++) {
-                if(*p_text== font->table[Num].index[0]) {
-                    const unsigned char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
-                    break;
-                }
-            }
+            Glyph = Paint_FindCN(font, p_text, 1);
+            if (Glyph != NULL)
+                Paint_DrawGlyph(paint, x, y, Glyph->matrix, font->Width, font->Height,
+                                Color_Foreground, Color_Background);
             /* Point on the next character */
             p_text += 1;
             /* Decrement the column position by 16 */
             x += font->ASCII_Width;
         } else {        //Chinese
-            for(Num = 0; Num < font->size; Num++) {
-                if ((((*p_text)&0xFF) == font->table[Num].index[0]) && \
-                    (((*(p_text + 1))&0xFF) == font->table[Num].index[1]) && \
-                    (((*(p_text + 2))&0xFF) == font->table[Num].index[2])) {
-                    const unsigned char* ptr = &font->table[Num].matrix[0];
-
-                    for (j = 0; j < font->Height; j++) {
-                        for (i = 0; i < font->Width; i++) {
-                            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            } else {
-                                if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
-                                    // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                                }
-                            }
-                            if (i % 8 == 7) {
-                                ptr++;
-                            }
-                        }
-                        if (font->Width % 8 != 0) {
-                            ptr++;
-                        }
-                    }
-                    break;
-                }
-            }
+            if (p_text[1] == 0 || p_text[2] == 0)
+                break;      // truncated UTF-8 sequence
+            Glyph = Paint_FindCN(font, p_text, 3);
+            if (Glyph != NULL)
+                Paint_DrawGlyph(paint, x, y, Glyph->matrix, font->Width, font->Height,
+                                Color_Foreground, Color_Background);
             /* Point on the next character */
             p_text += 3;
             /* Decrement the column position by 16 */
@@ -720,7 +1407,7 @@ parameter:
     Color_Background : Select the background color
 ******************************************************************************/
 #define  ARRAY_LEN 255
-void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
+void Paint_DrawNum(PAINT &paint, UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
 
@@ -728,7 +1415,7 @@ void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
     uint8_t Str_Array[ARRAY_LEN] = {0}, Num_Array[ARRAY_LEN] = {0};
     uint8_t *pStr = Str_Array;
 
-    if (Xpoint >= Paint.Width || Ypoint >= Paint.Height) {
+    if (Xpoint >= paint.Width || Ypoint >= paint.Height) {
         Debug("Paint_DisNum Input exceeds the normal display range\r\n");
         return;
     }
@@ -748,7 +1435,7 @@ void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
     }
 
     //show
-    Paint_DrawString_EN(Xpoint, Ypoint, (const char*)pStr, Font, Color_Background, Color_Foreground);
+    Paint_DrawString_EN(paint, Xpoint, Ypoint, (const char*)pStr, Font, Color_Background, Color_Foreground);
 }
 
 /******************************************************************************
@@ -761,7 +1448,7 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
+void Paint_DrawTime(PAINT &paint, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
                     UWORD Color_Foreground, UWORD Color_Background)
 {
     uint8_t value[10] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
@@ -769,14 +1456,14 @@ void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
     UWORD Dx = Font->Width;
 
     //Write data into the cache
-    Paint_DrawChar(Xstart                           , Ystart, value[pTime->Hour / 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx                      , Ystart, value[pTime->Hour % 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx  + Dx / 4 + Dx / 2   , Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 2 + Dx / 2         , Ystart, value[pTime->Min / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 3 + Dx / 2         , Ystart, value[pTime->Min % 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 4 + Dx / 2 - Dx / 4, Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 5                  , Ystart, value[pTime->Sec / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 6                  , Ystart, value[pTime->Sec % 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart                           , Ystart, value[pTime->Hour / 10], Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx                      , Ystart, value[pTime->Hour % 10], Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx  + Dx / 4 + Dx / 2   , Ystart, ':'                    , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx * 2 + Dx / 2         , Ystart, value[pTime->Min / 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx * 3 + Dx / 2         , Ystart, value[pTime->Min % 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx * 4 + Dx / 2 - Dx / 4, Ystart, ':'                    , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx * 5                  , Ystart, value[pTime->Sec / 10] , Font, Color_Background, Color_Foreground);
+    Paint_DrawChar(paint, Xstart + Dx * 6                  , Ystart, value[pTime->Sec % 10] , Font, Color_Background, Color_Foreground);
 }
 
 /******************************************************************************
@@ -787,17 +1474,20 @@ info:
     Use a computer to convert the image into a corresponding array,
     and then embed the array directly into Imagedata.cpp as a .c file.
 ******************************************************************************/
-void Paint_DrawBitMap(const unsigned char* image_buffer)
+void Paint_DrawBitMap(PAINT &paint, const unsigned char* image_buffer)
 {
     UWORD x, y;
     UDOUBLE Addr = 0;
 
-    for (y = 0; y < Paint.HeightByte; y++) {
-        for (x = 0; x < Paint.WidthByte; x++) {//8 pixel =  1 byte
-            Addr = x + y * Paint.WidthByte;
-            Paint.Image[Addr] = (unsigned char)image_buffer[Addr];
+    // Banded, the cache holds rows from BandTop on
+    image_buffer += (UDOUBLE)paint.BandTop * paint.WidthByte;
+    for (y = 0; y < paint.HeightByte; y++) {
+        for (x = 0; x < paint.WidthByte; x++) {//8 pixel =  1 byte
+            Addr = x + y * paint.WidthByte;
+            paint.Image[Addr] = (unsigned char)image_buffer[Addr];
         }
     }
+    Paint_MarkDirtyMemory(paint, 0, paint.BandTop, paint.WidthMemory - 1, paint.BandTop + paint.BandHeight - 1);
 }
 
 /******************************************************************************
@@ -812,12 +1502,14 @@ parameter:
 info:
     Use this function to paste image data into a buffer
 ******************************************************************************/
-void Paint_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
+void Paint_DrawBitMap_Paste(PAINT &paint, const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
 {
     UBYTE color, srcImage;
     UWORD x, y;
     UWORD width = (imageWidth%8==0 ? imageWidth/8 : imageWidth/8+1);
-    
+    const PAINT_PIXEL_WRITER Write = Paint_WriterFor(paint, xStart, yStart, imageWidth, imageHeight);
+    Paint_MarkDirty(paint, xStart, yStart, xStart + imageWidth, yStart + imageHeight);
+
     for (y = 0; y < imageHeight; y++) {
         for (x = 0; x < imageWidth; x++) {
             srcImage = image_buffer[y*width + x/8];
@@ -825,7 +1517,7 @@ void Paint_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWO
                 color = (((srcImage<<(x%8) & 0x80) == 0) ? 1 : 0);
             else
                 color = (((srcImage<<(x%8) & 0x80) == 0) ? 0 : 1);
-            Paint_SetPixel(x+xStart, y+yStart, color);
+            Write(&paint, x+xStart, y+yStart, color);
         }
     }
 }
@@ -839,17 +1531,387 @@ parameter:
     xEnd             ：Image width
     yEnd             : Image height
 ******************************************************************************/
-void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
+void Paint_DrawImage(PAINT &paint, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
 {
     UWORD x, y;
 	UWORD w_byte=(W_Image%8)?(W_Image/8)+1:W_Image/8;
     UDOUBLE Addr = 0;
 	UDOUBLE pAddr = 0;
+    UWORD Ytop = paint.BandTop + paint.BandHeight, Ybottom = 0;
     for (y = 0; y < H_Image; y++) {
+        if (y + yStart < paint.BandTop || y + yStart >= paint.BandTop + paint.BandHeight)
+            continue;
         for (x = 0; x < w_byte; x++) {//8 pixel =  1 byte
             Addr = x + y * w_byte;
-			pAddr=x+(xStart/8)+((y+yStart)*Paint.WidthByte);
-            Paint.Image[pAddr] = (unsigned char)image_buffer[Addr];
+			pAddr=x+(xStart/8)+((y+yStart-paint.BandTop)*paint.WidthByte);
+            paint.Image[pAddr] = (unsigned char)image_buffer[Addr];
+        }
+        if (y + yStart < Ytop)
+            Ytop = y + yStart;
+        Ybottom = y + yStart;
+    }
+
+    // Whole bytes were copied: mark the pixels they hold
+    const UWORD PerByte = (paint.Scale == 2) ? 8 : (paint.Scale == 4) ? 4 : 2;
+    UDOUBLE X1 = (UDOUBLE)(xStart / 8 + w_byte) * PerByte;
+    if (X1 > paint.WidthMemory)
+        X1 = paint.WidthMemory;
+    if (w_byte > 0 && Ytop <= Ybottom && (UDOUBLE)(xStart / 8) * PerByte < X1)
+        Paint_MarkDirtyMemory(paint, (xStart / 8) * PerByte, Ytop, X1 - 1, Ybottom);
+}
+
+/******************************************************************************
+function: Size of a sprite's data as stored: rotated by 90 or 270 degrees,
+          its columns are stored as rows
+******************************************************************************/
+static void Paint_SpriteLayout(const PAINT_SPRITE *Sprite, UWORD Rotate, UWORD *Width, UWORD *Height)
+{
+    const bool Swap = (Rotate == ROTATE_90 || Rotate == ROTATE_270);
+    *Width = Swap ? Sprite->Height : Sprite->Width;
+    *Height = Swap ? Sprite->Width : Sprite->Height;
+}
+
+static inline UBYTE Paint_SpritePixel(const UBYTE *Row, UWORD X)
+{
+    return (X % 2) ? (Row[X / 2] & 0x0F) : (Row[X / 2] >> 4);
+}
+
+static inline void Paint_SpritePut(UBYTE *Row, UWORD X, UBYTE Color)
+{
+    if (X % 2)
+        Row[X / 2] = (Row[X / 2] & 0xF0) | Color;
+    else
+        Row[X / 2] = (Row[X / 2] & 0x0F) | (Color << 4);
+}
+
+/******************************************************************************
+function: Bytes Paint_PrepareSprite needs for Sprite at the current rotation
+******************************************************************************/
+UDOUBLE Paint_SpriteBytes(PAINT &paint, const PAINT_SPRITE *Sprite)
+{
+    UWORD Width, Height;
+    Paint_SpriteLayout(Sprite, paint.Rotate, &Width, &Height);
+    return (UDOUBLE)((Width + 1) / 2) * Height;
+}
+
+/******************************************************************************
+function: Store a sprite the way the current image is rotated and mirrored
+parameter:
+    Sprite   : Sprite to convert, in any orientation
+    Buffer   : Paint_SpriteBytes(Sprite) bytes for the converted data
+    Prepared : Set to the converted sprite, which draws the same
+info:
+    Paint_DrawSprite copies whole rows only if the sprite is stored the way
+    the image is rotated and mirrored. Convert each icon once, e.g. after
+    Paint_NewImage, rather than rotating it every time it is drawn.
+******************************************************************************/
+void Paint_PrepareSprite(PAINT &paint, const PAINT_SPRITE *Sprite, UBYTE *Buffer, PAINT_SPRITE *Prepared)
+{
+    UWORD SrcWidth, SrcHeight, DstWidth, DstHeight;
+    Paint_SpriteLayout(Sprite, Sprite->Rotate, &SrcWidth, &SrcHeight);
+    Paint_SpriteLayout(Sprite, paint.Rotate, &DstWidth, &DstHeight);
+    const UWORD SrcStride = (SrcWidth + 1) / 2;
+    const UWORD DstStride = (DstWidth + 1) / 2;
+    memset(Buffer, 0, (UDOUBLE)DstStride * DstHeight);
+
+    for (UWORD Y = 0; Y < Sprite->Height; Y++) {
+        for (UWORD X = 0; X < Sprite->Width; X++) {
+            UWORD Xs, Ys, Xd, Yd;
+            Paint_MapPoint(Sprite->Rotate, Sprite->Mirror, SrcWidth, SrcHeight, X, Y, &Xs, &Ys);
+            Paint_MapPoint(paint.Rotate, paint.Mirror, DstWidth, DstHeight, X, Y, &Xd, &Yd);
+            Paint_SpritePut(Buffer + (UDOUBLE)Yd * DstStride, Xd,
+                            Paint_SpritePixel(Sprite->Data + (UDOUBLE)Ys * SrcStride, Xs));
         }
     }
+
+    *Prepared = *Sprite;
+    Prepared->Data = Buffer;
+    Prepared->Rotate = paint.Rotate;
+    Prepared->Mirror = paint.Mirror;
+}
+
+/******************************************************************************
+function: Copy Len bytes (2 * Len pixels) of a 4bpp row, skipping pixels of
+          color Key unless Key is negative
+info:
+    Opaque rows are one memcpy. Otherwise 8 pixels are merged at a time:
+    each nibble that differs from Key gets a bit set, which is widened into
+    a mask for that nibble.
+******************************************************************************/
+static void Paint_MergeRow4(UBYTE *Dst, const UBYTE *Src, UWORD Len, int Key)
+{
+    if (Key < 0) {
+        memcpy(Dst, Src, Len);
+        return;
+    }
+    const uint32_t KeyBits = (uint32_t)Key * 0x11111111u;
+    UWORD i = 0;
+    for (; i + 4 <= Len; i += 4) {
+        uint32_t S, D;
+        memcpy(&S, Src + i, 4);
+        memcpy(&D, Dst + i, 4);
+        uint32_t Diff = S ^ KeyBits;
+        Diff = (Diff | (Diff >> 1) | (Diff >> 2) | (Diff >> 3)) & 0x11111111u;
+        const uint32_t Mask = Diff * 0x0F;
+        D = (D & ~Mask) | (S & Mask);
+        memcpy(Dst + i, &D, 4);
+    }
+    for (; i < Len; i++) {
+        const UBYTE Diff = Src[i] ^ (UBYTE)(Key * 0x11);
+        const UBYTE Mask = ((Diff & 0xF0) ? 0xF0 : 0x00) | ((Diff & 0x0F) ? 0x0F : 0x00);
+        Dst[i] = (Dst[i] & ~Mask) | (Src[i] & Mask);
+    }
+}
+
+// Sprite rows starting on an odd pixel are shifted into place this many
+// bytes at a time
+#define PAINT_SPRITE_CHUNK  64
+
+/******************************************************************************
+function: Copy W pixels from sprite pixel Sx of Src to buffer pixel Dx of Dst
+          (scale 7), skipping color Key unless it is negative
+******************************************************************************/
+static void Paint_BlitRow4(UBYTE *Dst, UWORD Dx, const UBYTE *Src, UWORD Sx, UWORD W, int Key)
+{
+    if (Dx % 2 && W > 0) {
+        const UBYTE Color = Paint_SpritePixel(Src, Sx);
+        if (Color != Key)
+            Paint_SpritePut(Dst, Dx, Color);
+        Dx++;
+        Sx++;
+        W--;
+    }
+
+    Dst += Dx / 2;
+    const UWORD Bytes = W / 2;
+    if (Sx % 2 == 0) {
+        Paint_MergeRow4(Dst, Src + Sx / 2, Bytes, Key);
+    } else {
+        // Each byte takes the low nibble of one sprite byte and the high
+        // nibble of the next
+        const UBYTE *S = Src + Sx / 2;
+        UBYTE Shifted[PAINT_SPRITE_CHUNK];
+        for (UWORD Done = 0; Done < Bytes; ) {
+            const UWORD N = (Bytes - Done < PAINT_SPRITE_CHUNK) ? Bytes - Done : PAINT_SPRITE_CHUNK;
+            for (UWORD i = 0; i < N; i++)
+                Shifted[i] = (UBYTE)(S[Done + i] << 4) | (S[Done + i + 1] >> 4);
+            Paint_MergeRow4(Dst + Done, Shifted, N, Key);
+            Done += N;
+        }
+    }
+
+    if (W % 2) {
+        const UBYTE Color = Paint_SpritePixel(Src, Sx + W - 1);
+        if (Color != Key)
+            Paint_SpritePut(Dst, W - 1, Color);
+    }
+}
+
+/******************************************************************************
+function: Draw a 4bpp sprite with its top left corner at (Xstart, Ystart)
+parameter:
+    Sprite : Pixels are painted colors (0..15); those equal to Sprite->Key
+             are left as they are
+info:
+    On a scale 7 image with the sprite stored the way the image is rotated
+    and mirrored (Paint_PrepareSprite), the clipped sprite is a rectangle in
+    the buffer too and is copied a row at a time. Anything else is drawn a
+    pixel at a time, to the same result.
+******************************************************************************/
+void Paint_DrawSprite(PAINT &paint, const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart)
+{
+    UDOUBLE Xend = (UDOUBLE)Xstart + Sprite->Width;
+    UDOUBLE Yend = (UDOUBLE)Ystart + Sprite->Height;
+    const UWORD X0 = (Xstart > paint.ClipXstart) ? Xstart : paint.ClipXstart;
+    const UWORD Y0 = (Ystart > paint.ClipYstart) ? Ystart : paint.ClipYstart;
+    if (Xend > paint.ClipXend)
+        Xend = paint.ClipXend;
+    if (Yend > paint.ClipYend)
+        Yend = paint.ClipYend;
+    if (X0 >= Xend || Y0 >= Yend)
+        return;
+    const UWORD X1 = (UWORD)Xend - 1;
+    const UWORD Y1 = (UWORD)Yend - 1;
+    Paint_MarkDirty(paint, X0, Y0, X1 + 1, Y1 + 1);
+
+    const int Key = (Sprite->Key <= 0x0F) ? Sprite->Key : -1;
+    UWORD Width, Height;
+    Paint_SpriteLayout(Sprite, Sprite->Rotate, &Width, &Height);
+    const UWORD Stride = (Width + 1) / 2;
+
+    if (paint.Scale == 7 && Sprite->Rotate == paint.Rotate && Sprite->Mirror == paint.Mirror) {
+        // Same mapping on both sides, so the top left corners of the two
+        // rectangles are the same pixel
+        UWORD Xa, Ya, Xb, Yb, Sxa, Sya, Sxb, Syb;
+        Paint_MapToMemory(paint, X0, Y0, &Xa, &Ya);
+        Paint_MapToMemory(paint, X1, Y1, &Xb, &Yb);
+        Paint_MapPoint(Sprite->Rotate, Sprite->Mirror, Width, Height, X0 - Xstart, Y0 - Ystart, &Sxa, &Sya);
+        Paint_MapPoint(Sprite->Rotate, Sprite->Mirror, Width, Height, X1 - Xstart, Y1 - Ystart, &Sxb, &Syb);
+        const UWORD Bx = (Xa < Xb) ? Xa : Xb;
+        const UWORD By = (Ya < Yb) ? Ya : Yb;
+        const UWORD Sx = (Sxa < Sxb) ? Sxa : Sxb;
+        const UWORD Sy = (Sya < Syb) ? Sya : Syb;
+        const UWORD W = ((Xa < Xb) ? Xb - Xa : Xa - Xb) + 1;
+        const UWORD H = ((Ya < Yb) ? Yb - Ya : Ya - Yb) + 1;
+        for (UWORD Row = 0; Row < H; Row++) {
+            Paint_BlitRow4(paint.Image + (UDOUBLE)(By + Row - paint.BandTop) * paint.WidthByte, Bx,
+                           Sprite->Data + (UDOUBLE)(Sy + Row) * Stride, Sx, W, Key);
+        }
+        return;
+    }
+
+    for (UWORD Y = Y0; Y <= Y1; Y++) {
+        for (UWORD X = X0; X <= X1; X++) {
+            UWORD Xs, Ys;
+            Paint_MapPoint(Sprite->Rotate, Sprite->Mirror, Width, Height, X - Xstart, Y - Ystart, &Xs, &Ys);
+            const UBYTE Color = Paint_SpritePixel(Sprite->Data + (UDOUBLE)Ys * Stride, Xs);
+            if (Color != Key)
+                paint.WritePixel(&paint, X, Y, Color);
+        }
+    }
+}
+
+/******************************************************************************
+function: The calls above on the global Paint
+info:
+    Existing callers keep drawing into Paint. Code that draws from more than
+    one task gives each its own PAINT and passes it instead.
+******************************************************************************/
+void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+{
+    Paint_NewImage(Paint, image, Width, Height, Rotate, Color);
+}
+
+void Paint_SelectImage(UBYTE *image)
+{
+    Paint_SelectImage(Paint, image);
+}
+
+void Paint_SetRotate(UWORD Rotate)
+{
+    Paint_SetRotate(Paint, Rotate);
+}
+
+void Paint_SetMirroring(UBYTE mirror)
+{
+    Paint_SetMirroring(Paint, mirror);
+}
+
+void Paint_SetScale(UBYTE scale)
+{
+    Paint_SetScale(Paint, scale);
+}
+
+void Paint_SetBand(UWORD Ystart, UWORD Height)
+{
+    Paint_SetBand(Paint, Ystart, Height);
+}
+
+UBYTE Paint_GetDirty(UWORD *Xstart, UWORD *Ystart, UWORD *Xend, UWORD *Yend)
+{
+    return Paint_GetDirty(Paint, Xstart, Ystart, Xend, Yend);
+}
+
+void Paint_ResetDirty(void)
+{
+    Paint_ResetDirty(Paint);
+}
+
+void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    Paint_SetPixel(Paint, Xpoint, Ypoint, Color);
+}
+
+void Paint_Clear(UWORD Color)
+{
+    Paint_Clear(Paint, Color);
+}
+
+void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    Paint_ClearWindows(Paint, Xstart, Ystart, Xend, Yend, Color);
+}
+
+void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                     DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+{
+    Paint_DrawPoint(Paint, Xpoint, Ypoint, Color, Dot_Pixel, Dot_Style);
+}
+
+void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                    UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    Paint_DrawLine(Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Line_Style);
+}
+
+void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                         UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    Paint_DrawRectangle(Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Draw_Fill);
+}
+
+void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+                      UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    Paint_DrawCircle(Paint, X_Center, Y_Center, Radius, Color, Line_width, Draw_Fill);
+}
+
+void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawChar(Paint, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
+                         sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawString_EN(Paint, Xstart, Ystart, pString, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
+                        UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawString_CN(Paint, Xstart, Ystart, pString, font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
+                   sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawNum(Paint, Xpoint, Ypoint, Nummber, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
+                    UWORD Color_Foreground, UWORD Color_Background)
+{
+    Paint_DrawTime(Paint, Xstart, Ystart, pTime, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawBitMap(const unsigned char* image_buffer)
+{
+    Paint_DrawBitMap(Paint, image_buffer);
+}
+
+void Paint_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor)
+{
+    Paint_DrawBitMap_Paste(Paint, image_buffer, xStart, yStart, imageWidth, imageHeight, flipColor);
+}
+
+void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image)
+{
+    Paint_DrawImage(Paint, image_buffer, xStart, yStart, W_Image, H_Image);
+}
+
+UDOUBLE Paint_SpriteBytes(const PAINT_SPRITE *Sprite)
+{
+    return Paint_SpriteBytes(Paint, Sprite);
+}
+
+void Paint_PrepareSprite(const PAINT_SPRITE *Sprite, UBYTE *Buffer, PAINT_SPRITE *Prepared)
+{
+    Paint_PrepareSprite(Paint, Sprite, Buffer, Prepared);
+}
+
+void Paint_DrawSprite(const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart)
+{
+    Paint_DrawSprite(Paint, Sprite, Xstart, Ystart);
 }
@@ -85,7 +85,16 @@
 /**
  * Image attributes
 **/
-typedef struct {
+typedef struct _PAINT PAINT;
+
+/**
+ * Writes one pixel at logical coordinates without any bounds check.
+ * One is instantiated per Rotate/Mirror/Scale combination and selected
+ * whenever one of them changes, so drawing does not switch on them per pixel.
+**/
+typedef void (*PAINT_PIXEL_WRITER)(PAINT *paint, UWORD Xpoint, UWORD Ypoint, UWORD Color);
+
+struct _PAINT {
     UBYTE *Image;
     UWORD Width;
     UWORD Height;
@@ -97,7 +106,24 @@ typedef struct {
     UWORD WidthByte;
     UWORD HeightByte;
     UWORD Scale;
-} PAINT;
+    UWORD BandTop;      // first buffer row held in Image (0 unless banded)
+    UWORD BandHeight;   // buffer rows held in Image
+    PAINT_PIXEL_WRITER WritePixel;
+    UWORD ClipXstart;   // logical area WritePixel may be called for:
+    UWORD ClipYstart;   // ClipXstart <= X < ClipXend,
+    UWORD ClipXend;     // ClipYstart <= Y < ClipYend
+    UWORD ClipYend;
+    UWORD DirtyXstart;  // buffer area drawn since Paint_ResetDirty:
+    UWORD DirtyYstart;  // DirtyXstart <= X < DirtyXend,
+    UWORD DirtyXend;    // DirtyYstart <= Y < DirtyYend (image rows, also
+    UWORD DirtyYend;    // when banded); empty while DirtyXstart >= DirtyXend
+};
+/**
+ * Every call below takes the PAINT to draw into as its first argument and
+ * touches nothing else, so two PAINTs (two bands, two buffers) can be drawn
+ * from two tasks at once. The same calls without it draw into the global
+ * Paint, as they always have.
+**/
 extern PAINT Paint;
 
 /**
@@ -191,6 +217,24 @@ typedef struct {
 } PAINT_TIME;
 extern PAINT_TIME sPaint_time;
 
+/**
+ * 4bpp image for Paint_DrawSprite, packed like a scale 7 image: two pixels
+ * per byte, the left one in the high nibble, (width + 1) / 2 bytes per row.
+ * Rotate and Mirror give the orientation Data is stored in: ROTATE_0 and
+ * MIRROR_NONE for a sprite stored as it is drawn, otherwise those of the
+ * image Paint_PrepareSprite stored it for. Width and Height are as drawn.
+**/
+#define PAINT_SPRITE_OPAQUE  0xFF   // Key: no transparent color
+
+typedef struct {
+    const UBYTE *Data;
+    UWORD Width;
+    UWORD Height;
+    UBYTE Key;          // color left transparent, or PAINT_SPRITE_OPAQUE
+    UBYTE Mirror;
+    UWORD Rotate;
+} PAINT_SPRITE;
+
 //init and Clear
 void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
 void Paint_SelectImage(UBYTE *image);
@@ -198,6 +242,9 @@ void Paint_SetRotate(UWORD Rotate);
 void Paint_SetMirroring(UBYTE mirror);
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color);
 void Paint_SetScale(UBYTE scale);
+void Paint_SetBand(UWORD Ystart, UWORD Height);
+UBYTE Paint_GetDirty(UWORD *Xstart, UWORD *Ystart, UWORD *Xend, UWORD *Yend);
+void Paint_ResetDirty(void);
 
 void Paint_Clear(UWORD Color);
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
@@ -219,6 +266,44 @@ void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
 void Paint_DrawBitMap(const unsigned char* image_buffer);
 void Paint_DrawBitMap_Paste(const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor);
 void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image); 
+UDOUBLE Paint_SpriteBytes(const PAINT_SPRITE *Sprite);
+void Paint_PrepareSprite(const PAINT_SPRITE *Sprite, UBYTE *Buffer, PAINT_SPRITE *Prepared);
+void Paint_DrawSprite(const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart);
+
+//init and Clear, on a given PAINT
+void Paint_NewImage(PAINT &paint, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
+void Paint_SelectImage(PAINT &paint, UBYTE *image);
+void Paint_SetRotate(PAINT &paint, UWORD Rotate);
+void Paint_SetMirroring(PAINT &paint, UBYTE mirror);
+void Paint_SetPixel(PAINT &paint, UWORD Xpoint, UWORD Ypoint, UWORD Color);
+void Paint_SetScale(PAINT &paint, UBYTE scale);
+void Paint_SetBand(PAINT &paint, UWORD Ystart, UWORD Height);
+UBYTE Paint_GetDirty(PAINT &paint, UWORD *Xstart, UWORD *Ystart, UWORD *Xend, UWORD *Yend);
+void Paint_ResetDirty(PAINT &paint);
+
+void Paint_Clear(PAINT &paint, UWORD Color);
+void Paint_ClearWindows(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+
+//Drawing, on a given PAINT
+void Paint_DrawPoint(PAINT &paint, UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay);
+void Paint_DrawLine(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
+void Paint_DrawRectangle(PAINT &paint, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_DrawCircle(PAINT &paint, UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+
+//Display string, on a given PAINT
+void Paint_DrawChar(PAINT &paint, UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_EN(PAINT &paint, UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_CN(PAINT &paint, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawNum(PAINT &paint, UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawTime(PAINT &paint, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+
+//pic, on a given PAINT
+void Paint_DrawBitMap(PAINT &paint, const unsigned char* image_buffer);
+void Paint_DrawBitMap_Paste(PAINT &paint, const unsigned char* image_buffer, UWORD xStart, UWORD yStart, UWORD imageWidth, UWORD imageHeight, UBYTE flipColor);
+void Paint_DrawImage(PAINT &paint, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image);
+UDOUBLE Paint_SpriteBytes(PAINT &paint, const PAINT_SPRITE *Sprite);
+void Paint_PrepareSprite(PAINT &paint, const PAINT_SPRITE *Sprite, UBYTE *Buffer, PAINT_SPRITE *Prepared);
+void Paint_DrawSprite(PAINT &paint, const PAINT_SPRITE *Sprite, UWORD Xstart, UWORD Ystart);
 
 #endif
 
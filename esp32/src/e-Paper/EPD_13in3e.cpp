@@ -0,0 +1,312 @@
+/*****************************************************************************
+* | File        :   EPD_13in3e.cpp
+* | Author      :   Waveshare team
+* | Function    :   13.3inch e-Paper (E) Driver (dual controller)
+* | Info        :
+*----------------
+* | This version:   V1.0
+* | Info        :
+* -----------------------------------------------------------------------------
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "EPD_13in3e.h"
+
+// Bytes of one row owned by each controller (600 pixels, 4bpp)
+#define EPD_13IN3E_HALF_ROW_BYTES  (EPD_13IN3E_WIDTH / 4)
+
+// Chip selects addressed by a command
+#define EPD_13IN3E_CS_M    0x01
+#define EPD_13IN3E_CS_S    0x02
+#define EPD_13IN3E_CS_ALL  (EPD_13IN3E_CS_M | EPD_13IN3E_CS_S)
+
+static const UBYTE PSR_V[2] = {0xDF, 0x69};
+static const UBYTE PWR_V[6] = {0x0F, 0x00, 0x28, 0x2C, 0x28, 0x38};
+static const UBYTE CDI_V[1] = {0xF7};
+static const UBYTE TCON_V[2] = {0x03, 0x03};
+static const UBYTE TRES_V[4] = {0x04, 0xB0, 0x03, 0x20};
+static const UBYTE CMD66_V[6] = {0x49, 0x55, 0x13, 0x5D, 0x05, 0x10};
+static const UBYTE EN_BUF_V[1] = {0x07};
+static const UBYTE CCSET_V[1] = {0x01};
+static const UBYTE PWS_V[1] = {0x22};
+static const UBYTE AN_TM_V[9] = {0xC0, 0x1C, 0x1C, 0xCC, 0xCC, 0xCC, 0x15, 0x15, 0x55};
+static const UBYTE AGID_V[1] = {0x10};
+static const UBYTE BTST_P_V[2] = {0xE8, 0x28};
+static const UBYTE BOOST_VDDP_EN_V[1] = {0x01};
+static const UBYTE BTST_N_V[2] = {0xE8, 0x28};
+static const UBYTE BUCK_BOOST_VDDN_V[1] = {0x01};
+static const UBYTE TFT_VCOM_POWER_V[1] = {0x02};
+
+// Duration of the most recent DISPLAY_REFRESH (0x12) busy phase, in ms.
+static UDOUBLE EPD_13IN3E_LastRefreshMs = 0;
+
+/******************************************************************************
+function :  Select controllers
+parameter:
+    Cs : EPD_13IN3E_CS_M, EPD_13IN3E_CS_S or EPD_13IN3E_CS_ALL
+******************************************************************************/
+static void EPD_13IN3E_Select(UBYTE Cs)
+{
+    DEV_Digital_Write(EPD_CS_PIN, (Cs & EPD_13IN3E_CS_M) ? 0 : 1);
+    DEV_Digital_Write(EPD_CS_S_PIN, (Cs & EPD_13IN3E_CS_S) ? 0 : 1);
+}
+
+/******************************************************************************
+function :  Software reset
+parameter:
+******************************************************************************/
+static void EPD_13IN3E_Reset(void)
+{
+    DEV_Digital_Write(EPD_RST_PIN, 1);
+    DEV_Delay_ms(30);
+    DEV_Digital_Write(EPD_RST_PIN, 0);
+    DEV_Delay_ms(30);
+    DEV_Digital_Write(EPD_RST_PIN, 1);
+    DEV_Delay_ms(30);
+}
+
+/******************************************************************************
+function :  send command and its parameters to the selected controllers
+parameter:
+    Cs   : Controllers to address
+    Reg  : Command register
+    pData: Parameters, may be NULL
+    Len  : Number of parameters
+******************************************************************************/
+static void EPD_13IN3E_Command(UBYTE Cs, UBYTE Reg, const UBYTE *pData, UDOUBLE Len)
+{
+    EPD_13IN3E_Select(Cs);
+    DEV_Digital_Write(EPD_DC_PIN, 0);
+    DEV_SPI_WriteByte(Reg);
+    if (Len > 0) {
+        DEV_Digital_Write(EPD_DC_PIN, 1);
+        DEV_SPI_Write_nByte((UBYTE *)pData, Len);
+    }
+    EPD_13IN3E_Select(0);
+}
+
+/******************************************************************************
+function :  Wait until the busy_pin goes HIGH (idle)
+parameter:
+******************************************************************************/
+static void EPD_13IN3E_ReadBusyH(void)
+{
+    Debug("e-Paper busy H\r\n");
+    unsigned long timeout = 30000; // the large panel refreshes slower
+    unsigned long start = millis();
+    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {      //LOW: busy, HIGH: idle
+        DEV_Delay_ms(1);
+        if (millis() - start > timeout) {
+            Debug("e-Paper busy H TIMEOUT\r\n");
+            return; // Exit on timeout to prevent infinite hang
+        }
+    }
+    Debug("e-Paper busy H release\r\n");
+}
+
+/******************************************************************************
+function :  Turn On Display
+parameter:
+info:
+    PON and DRF go to both controllers at once so the halves refresh together.
+******************************************************************************/
+static void EPD_13IN3E_TurnOnDisplay(void)
+{
+    const UBYTE Zero = 0x00;
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x04, NULL, 0); // POWER_ON
+    EPD_13IN3E_ReadBusyH();
+    DEV_Delay_ms(50);
+
+    const unsigned long refreshStart = millis();
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x12, &Zero, 1); // DISPLAY_REFRESH
+    EPD_13IN3E_ReadBusyH();
+    EPD_13IN3E_LastRefreshMs = (UDOUBLE)(millis() - refreshStart);
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x02, &Zero, 1); // POWER_OFF
+    EPD_13IN3E_ReadBusyH();
+}
+
+/******************************************************************************
+function :  Initialize the e-Paper register
+parameter:
+******************************************************************************/
+void EPD_13IN3E_Init(void)
+{
+    pinMode(EPD_CS_S_PIN, OUTPUT);
+    EPD_13IN3E_Select(0);
+
+    EPD_13IN3E_Reset();
+    EPD_13IN3E_ReadBusyH();
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0x74, AN_TM_V, sizeof(AN_TM_V));
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0xF0, CMD66_V, sizeof(CMD66_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x00, PSR_V, sizeof(PSR_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x50, CDI_V, sizeof(CDI_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x60, TCON_V, sizeof(TCON_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x86, AGID_V, sizeof(AGID_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0xE3, PWS_V, sizeof(PWS_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0xE0, CCSET_V, sizeof(CCSET_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x61, TRES_V, sizeof(TRES_V));
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0x01, PWR_V, sizeof(PWR_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0xB6, EN_BUF_V, sizeof(EN_BUF_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0x06, BTST_P_V, sizeof(BTST_P_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0xB7, BOOST_VDDP_EN_V, sizeof(BOOST_VDDP_EN_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0x05, BTST_N_V, sizeof(BTST_N_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0xB0, BUCK_BOOST_VDDN_V, sizeof(BUCK_BOOST_VDDN_V));
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0xB1, TFT_VCOM_POWER_V, sizeof(TFT_VCOM_POWER_V));
+}
+
+/******************************************************************************
+function :  Clear screen
+parameter:
+******************************************************************************/
+void EPD_13IN3E_Clear(UBYTE color)
+{
+    UBYTE Row[EPD_13IN3E_HALF_ROW_BYTES];
+    memset(Row, (color << 4) | color, sizeof(Row));
+
+    const UBYTE Cs[2] = {EPD_13IN3E_CS_M, EPD_13IN3E_CS_S};
+    for (UBYTE c = 0; c < 2; c++) {
+        EPD_13IN3E_Command(Cs[c], 0x10, NULL, 0);
+        EPD_13IN3E_Select(Cs[c]);
+        DEV_Digital_Write(EPD_DC_PIN, 1);
+        for (UWORD j = 0; j < EPD_13IN3E_HEIGHT; j++) {
+            DEV_SPI_Write_nByte(Row, sizeof(Row));
+        }
+        EPD_13IN3E_Select(0);
+    }
+
+    EPD_13IN3E_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :  Sends the image buffer in RAM to e-Paper and displays
+parameter:
+    Image : Full packed 4bpp frame, same layout as EPD_13IN3E_DisplayStream
+******************************************************************************/
+void EPD_13IN3E_Display(const UBYTE *Image)
+{
+    const UBYTE Cs[2] = {EPD_13IN3E_CS_M, EPD_13IN3E_CS_S};
+    for (UBYTE c = 0; c < 2; c++) {
+        EPD_13IN3E_Command(Cs[c], 0x10, NULL, 0);
+        EPD_13IN3E_Select(Cs[c]);
+        DEV_Digital_Write(EPD_DC_PIN, 1);
+        const UBYTE *Half = Image + c * EPD_13IN3E_HALF_ROW_BYTES;
+        for (UWORD j = 0; j < EPD_13IN3E_HEIGHT; j++) {
+            DEV_SPI_Write_nByte((UBYTE *)Half, EPD_13IN3E_HALF_ROW_BYTES);
+            Half += EPD_13IN3E_HALF_ROW_BYTES * 2;
+        }
+        EPD_13IN3E_Select(0);
+    }
+
+    EPD_13IN3E_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :  Stream a packed 4bpp frame straight from the network to the panel
+parameter:
+    stream : Source of len bytes, (width/2)*height, top-down, row-major,
+             high nibble = left pixel (same layout as the 7.3inch frame)
+info:
+    The DTM data phase is opened on both controllers first. Each half row is
+    then routed to its controller's CS as it arrives; a controller keeps its
+    write position while deselected, so no 960KB framebuffer is needed.
+    Filter, if any, sees each row before it is sent.
+******************************************************************************/
+bool EPD_13IN3E_DisplayStream(Stream &stream, UDOUBLE len, EPD_ROW_FILTER Filter, void *User)
+{
+    if (len != (UDOUBLE)EPD_13IN3E_HALF_ROW_BYTES * 2 * EPD_13IN3E_HEIGHT) {
+        return false;
+    }
+
+    EPD_13IN3E_BeginFrame();
+
+    UBYTE buf[EPD_13IN3E_HALF_ROW_BYTES * 2];
+    for (UWORD j = 0; j < EPD_13IN3E_HEIGHT; j++) {
+        const size_t got = stream.readBytes((char*)buf, sizeof(buf));
+        if (got != sizeof(buf)) {
+            EPD_13IN3E_Select(0);
+            return false;
+        }
+        if (Filter) {
+            Filter(buf, j, 1, User);
+        }
+        EPD_13IN3E_WriteRow(buf);
+        delay(0);
+    }
+
+    EPD_13IN3E_EndFrame();
+    return true;
+}
+
+/******************************************************************************
+function :  Write a frame row by row, e.g. rows produced by a decoder
+parameter:
+info:
+    BeginFrame, then EPD_13IN3E_HEIGHT full rows of (width/2) bytes through
+    WriteRow, then EndFrame, which also refreshes.
+******************************************************************************/
+void EPD_13IN3E_BeginFrame(void)
+{
+    EPD_13IN3E_Command(EPD_13IN3E_CS_M, 0x10, NULL, 0);
+    EPD_13IN3E_Command(EPD_13IN3E_CS_S, 0x10, NULL, 0);
+    DEV_Digital_Write(EPD_DC_PIN, 1);
+}
+
+void EPD_13IN3E_WriteRow(const UBYTE *Row)
+{
+    EPD_13IN3E_Select(EPD_13IN3E_CS_M);
+    DEV_SPI_Write_nByte((UBYTE *)Row, EPD_13IN3E_HALF_ROW_BYTES);
+    EPD_13IN3E_Select(EPD_13IN3E_CS_S);
+    DEV_SPI_Write_nByte((UBYTE *)Row + EPD_13IN3E_HALF_ROW_BYTES, EPD_13IN3E_HALF_ROW_BYTES);
+    EPD_13IN3E_Select(0);
+}
+
+void EPD_13IN3E_EndFrame(void)
+{
+    EPD_13IN3E_TurnOnDisplay();
+}
+
+/******************************************************************************
+function :  Duration of the last display refresh
+parameter:
+******************************************************************************/
+UDOUBLE EPD_13IN3E_GetLastRefreshMs(void)
+{
+    return EPD_13IN3E_LastRefreshMs;
+}
+
+/******************************************************************************
+function :  Enter sleep mode
+parameter:
+******************************************************************************/
+void EPD_13IN3E_Sleep(void)
+{
+    const UBYTE Zero = 0x00;
+    const UBYTE Check = 0xA5;
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x02, &Zero, 1); // POWER_OFF
+    EPD_13IN3E_ReadBusyH();
+
+    EPD_13IN3E_Command(EPD_13IN3E_CS_ALL, 0x07, &Check, 1); // DEEP_SLEEP
+    DEV_Delay_ms(100);
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+* | File        :   EPD_13in3e.h
+* | Author      :   Waveshare team
+* | Function    :   13.3inch e-Paper (E) Driver (dual controller)
+* | Info        :
+*   The panel is driven by two controllers. Each one owns one half of every
+*   row: the master (EPD_CS_PIN) the left 600 pixels, the slave
+*   (EPD_CS_S_PIN) the right 600 pixels. Both share DC, RST and BUSY.
+*----------------
+* | This version:   V1.0
+* | Info        :
+* -----------------------------------------------------------------------------
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#ifndef __EPD_13IN3E_H_
+#define __EPD_13IN3E_H_
+
+#include "../Config/Debug.h"
+#include "../Config/DEV_Config.h"
+#include "EPD_Panel.h"
+
+class Stream;
+
+// Display resolution
+#define EPD_13IN3E_WIDTH       1200
+#define EPD_13IN3E_HEIGHT      1600
+
+/**********************************
+Color Index (same as EPD_7IN3E_*)
+**********************************/
+#define EPD_13IN3E_BLACK   0x0   /// 000
+#define EPD_13IN3E_WHITE   0x1   /// 001
+#define EPD_13IN3E_YELLOW  0x2   /// 010
+#define EPD_13IN3E_RED     0x3   /// 011
+#define EPD_13IN3E_BLUE    0x5   /// 101
+#define EPD_13IN3E_GREEN   0x6   /// 110
+
+void EPD_13IN3E_Init(void);
+void EPD_13IN3E_Clear(UBYTE color);
+void EPD_13IN3E_Sleep(void);
+void EPD_13IN3E_Display(const UBYTE *Image);
+bool EPD_13IN3E_DisplayStream(Stream &stream, UDOUBLE len, EPD_ROW_FILTER Filter = NULL, void *User = NULL);
+void EPD_13IN3E_BeginFrame(void);
+void EPD_13IN3E_WriteRow(const UBYTE *Row);
+void EPD_13IN3E_EndFrame(void);
+UDOUBLE EPD_13IN3E_GetLastRefreshMs(void);
+
+#endif
@@ -30,165 +30,46 @@
 ******************************************************************************/
 #include "EPD_7in3e.h"
 
-/******************************************************************************
-function :  Software reset
-parameter:
-******************************************************************************/
-static void EPD_7IN3E_Reset(void)
-{
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-    DEV_Digital_Write(EPD_RST_PIN, 0);
-    DEV_Delay_ms(2);
-    DEV_Digital_Write(EPD_RST_PIN, 1);
-    DEV_Delay_ms(20);
-}
+// The one panel wired to the default DEV_Config pins.
+static EPD_7IN3E_Panel Panel;
 
 /******************************************************************************
-function :  send command
+function :  Initialize the e-Paper register
 parameter:
-     Reg : Command register
 ******************************************************************************/
-static void EPD_7IN3E_SendCommand(UBYTE Reg)
+void EPD_7IN3E_Init(void)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 0);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Reg);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    Panel.Init();
 }
 
 /******************************************************************************
-function :  send data
+function :  Initialize the e-Paper register with the fast-refresh waveform
 parameter:
-    Data : Write data
 ******************************************************************************/
-static void EPD_7IN3E_SendData(UBYTE Data)
+void EPD_7IN3E_Init_Fast(void)
 {
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
-    DEV_SPI_WriteByte(Data);
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+    Panel.InitFast();
 }
 
 /******************************************************************************
-function :  Wait until the busy_pin goes HIGH (idle)
+function :  Read the controller's internal temperature sensor
 parameter:
+info:
+    Call after EPD_7IN3E_Init(). Returns whole degrees Celsius, or
+    EPD_7IN3E_TEMP_INVALID when no reading is available.
 ******************************************************************************/
-static void EPD_7IN3E_ReadBusyH(void)
+int EPD_7IN3E_ReadTemperature(void)
 {
-    Debug("e-Paper busy H\r\n");
-    unsigned long timeout = 15000; // 15 second timeout
-    unsigned long start = millis();
-    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {      //LOW: busy, HIGH: idle
-        DEV_Delay_ms(1);
-        if (millis() - start > timeout) {
-            Debug("e-Paper busy H TIMEOUT\r\n");
-            return; // Exit on timeout to prevent infinite hang
-        }
-    }
-    Debug("e-Paper busy H release\r\n");
+    return Panel.ReadTemperature();
 }
 
 /******************************************************************************
-function :  Turn On Display
+function :  Duration of the last display refresh
 parameter:
 ******************************************************************************/
-static void EPD_7IN3E_TurnOnDisplay(void)
+UDOUBLE EPD_7IN3E_GetLastRefreshMs(void)
 {
-    
-    EPD_7IN3E_SendCommand(0x04); // POWER_ON
-    EPD_7IN3E_ReadBusyH();
-
-    //Second setting 
-    EPD_7IN3E_SendCommand(0x06);
-    EPD_7IN3E_SendData(0x6F);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x17);
-    EPD_7IN3E_SendData(0x49);
-
-    EPD_7IN3E_SendCommand(0x12); // DISPLAY_REFRESH
-    EPD_7IN3E_SendData(0x00);
-    EPD_7IN3E_ReadBusyH();
-    
-    EPD_7IN3E_SendCommand(0x02); // POWER_OFF
-    EPD_7IN3E_SendData(0X00);
-    EPD_7IN3E_ReadBusyH();
-}
-
-/******************************************************************************
-function :  Initialize the e-Paper register
-parameter:
-******************************************************************************/
-void EPD_7IN3E_Init(void)
-{
-    EPD_7IN3E_Reset();
-    EPD_7IN3E_ReadBusyH();
-    DEV_Delay_ms(30);
-
-    EPD_7IN3E_SendCommand(0xAA);    // CMDH
-    EPD_7IN3E_SendData(0x49);
-    EPD_7IN3E_SendData(0x55);
-    EPD_7IN3E_SendData(0x20);
-    EPD_7IN3E_SendData(0x08);
-    EPD_7IN3E_SendData(0x09);
-    EPD_7IN3E_SendData(0x18);
-
-    EPD_7IN3E_SendCommand(0x01);//
-    EPD_7IN3E_SendData(0x3F);
-
-    EPD_7IN3E_SendCommand(0x00);  
-    EPD_7IN3E_SendData(0x5F);
-    EPD_7IN3E_SendData(0x69);
-
-    EPD_7IN3E_SendCommand(0x03);
-    EPD_7IN3E_SendData(0x00);
-    EPD_7IN3E_SendData(0x54);
-    EPD_7IN3E_SendData(0x00);
-    EPD_7IN3E_SendData(0x44); 
-
-    EPD_7IN3E_SendCommand(0x05);
-    EPD_7IN3E_SendData(0x40);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x2C);
-
-    EPD_7IN3E_SendCommand(0x06);
-    EPD_7IN3E_SendData(0x6F);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x17);
-    EPD_7IN3E_SendData(0x49);
-
-    EPD_7IN3E_SendCommand(0x08);
-    EPD_7IN3E_SendData(0x6F);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x1F);
-    EPD_7IN3E_SendData(0x22);
-
-    EPD_7IN3E_SendCommand(0x30);
-    EPD_7IN3E_SendData(0x03);
-    
-    EPD_7IN3E_SendCommand(0x50);
-    EPD_7IN3E_SendData(0x3F);
-
-    EPD_7IN3E_SendCommand(0x60);
-    EPD_7IN3E_SendData(0x02);
-    EPD_7IN3E_SendData(0x00);
-
-    EPD_7IN3E_SendCommand(0x61);
-    EPD_7IN3E_SendData(0x03);
-    EPD_7IN3E_SendData(0x20);
-    EPD_7IN3E_SendData(0x01); 
-    EPD_7IN3E_SendData(0xE0);
-
-    EPD_7IN3E_SendCommand(0x84);
-    EPD_7IN3E_SendData(0x01);
-
-    EPD_7IN3E_SendCommand(0xE3);
-    EPD_7IN3E_SendData(0x2F);
-
-    EPD_7IN3E_SendCommand(0x04);     //PWR on  
-    EPD_7IN3E_ReadBusyH();          //waiting for the electronic paper IC to release the idle signal
-
+    return Panel.GetLastRefreshMs();
 }
 
 /******************************************************************************
@@ -197,18 +78,7 @@ parameter:
 ******************************************************************************/
 void EPD_7IN3E_Clear(UBYTE color)
 {
-    UWORD Width, Height;
-    Width = (EPD_7IN3E_WIDTH % 2 == 0)? (EPD_7IN3E_WIDTH / 2 ): (EPD_7IN3E_WIDTH / 2 + 1);
-    Height = EPD_7IN3E_HEIGHT;
-
-    EPD_7IN3E_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN3E_SendData((color<<4)|color);
-        }
-    }
-
-    EPD_7IN3E_TurnOnDisplay();
+    Panel.Clear(color);
 }
 
 /******************************************************************************
@@ -217,17 +87,17 @@ parameter:
 ******************************************************************************/
 void EPD_7IN3E_Show7Block(void)
 {
-    unsigned long i, j, k;
+    unsigned long j, k;
     unsigned char const Color_seven[6] = 
     {EPD_7IN3E_BLACK, EPD_7IN3E_YELLOW, EPD_7IN3E_RED, EPD_7IN3E_BLUE, EPD_7IN3E_GREEN, EPD_7IN3E_WHITE};
 
-    EPD_7IN3E_SendCommand(0x10);
+    Panel.SendCommand(0x10);
     for(k = 0 ; k < 6; k ++) {
         for(j = 0 ; j < 20000; j ++) {
-            EPD_7IN3E_SendData((Color_seven[k]<<4) |Color_seven[k]);
+            Panel.SendData((Color_seven[k]<<4) |Color_seven[k]);
         }
     }
-    EPD_7IN3E_TurnOnDisplay();
+    Panel.Refresh();
 }
 
 void EPD_7IN3E_Show(void)
@@ -237,26 +107,26 @@ void EPD_7IN3E_Show(void)
     {EPD_7IN3E_BLACK, EPD_7IN3E_YELLOW, EPD_7IN3E_RED, EPD_7IN3E_BLUE, EPD_7IN3E_GREEN, EPD_7IN3E_WHITE};
 
     UWORD Width, Height;
-    Width = (EPD_7IN3E_WIDTH % 2 == 0)? (EPD_7IN3E_WIDTH / 2 ): (EPD_7IN3E_WIDTH / 2 + 1);
+    Width = EPD_7IN3E_Panel::BYTES_PER_ROW;
     Height = EPD_7IN3E_HEIGHT;
     k = 0;
     o = 0;
 
-    EPD_7IN3E_SendCommand(0x10);
+    Panel.SendCommand(0x10);
     for (UWORD j = 0; j < Height; j++) {
         if((j > 10) && (j<50))
         for (UWORD i = 0; i < Width; i++) {
-                EPD_7IN3E_SendData((Color_seven[0]<<4) |Color_seven[0]);
+                Panel.SendData((Color_seven[0]<<4) |Color_seven[0]);
             }
         else if(o < Height/2)
         for (UWORD i = 0; i < Width; i++) {
-                EPD_7IN3E_SendData((Color_seven[0]<<4) |Color_seven[0]);
+                Panel.SendData((Color_seven[0]<<4) |Color_seven[0]);
             }
         
         else
         {
             for (UWORD i = 0; i < Width; i++) {
-                EPD_7IN3E_SendData((Color_seven[k]<<4) |Color_seven[k]);
+                Panel.SendData((Color_seven[k]<<4) |Color_seven[k]);
                 
             }
             k++ ;
@@ -268,7 +138,7 @@ void EPD_7IN3E_Show(void)
         if(o >= Height)
             o = 0;
     }
-    EPD_7IN3E_TurnOnDisplay();
+    Panel.Refresh();
 }
 
 /******************************************************************************
@@ -277,69 +147,84 @@ parameter:
 ******************************************************************************/
 void EPD_7IN3E_Display(UBYTE *Image)
 {
-    UWORD Width, Height;
-    Width = (EPD_7IN3E_WIDTH % 2 == 0)? (EPD_7IN3E_WIDTH / 2 ): (EPD_7IN3E_WIDTH / 2 + 1);
-    Height = EPD_7IN3E_HEIGHT;
-
-    EPD_7IN3E_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_7IN3E_SendData(Image[i + j * Width]);
-        }
-    }
-    EPD_7IN3E_TurnOnDisplay();
+    Panel.Display(Image);
 }
 
-bool EPD_7IN3E_DisplayStream(Stream &stream, UDOUBLE len)
+bool EPD_7IN3E_DisplayStream(Stream &stream, UDOUBLE len, EPD_ROW_FILTER Filter, void *User)
 {
     // Stream is expected to provide exactly len bytes in the panel's native
     // packed 4bpp format: (width/2)*height bytes, top-down, row-major.
-    EPD_7IN3E_SendCommand(0x10);
-
-    // Hold CS asserted for the whole transfer.
-    DEV_Digital_Write(EPD_DC_PIN, 1);
-    DEV_Digital_Write(EPD_CS_PIN, 0);
+    // Filter, if any, may change whole rows before they are sent.
+    return Panel.DisplayStream(stream, len, true, Filter, User);
+}
 
-    UBYTE buf[1024];
-    UDOUBLE remaining = len;
-    while (remaining > 0) {
-        const size_t want = (remaining > sizeof(buf)) ? sizeof(buf) : (size_t)remaining;
-        const size_t got = stream.readBytes((char*)buf, want);
-        if (got != want) {
-            DEV_Digital_Write(EPD_CS_PIN, 1);
-            return false;
-        }
+/******************************************************************************
+function :  Write a frame in pieces, e.g. rows produced by a decoder
+parameter:
+info:
+    BeginFrame, then exactly (width/2)*height bytes through WriteFrame, then
+    EndFrame, which also refreshes. Nothing else may use the bus in between.
+******************************************************************************/
+void EPD_7IN3E_BeginFrame(void)
+{
+    Panel.BeginFrame();
+}
 
-        DEV_SPI_Write_nByte(buf, (UDOUBLE)got);
-        remaining -= (UDOUBLE)got;
-        delay(0);
-    }
+void EPD_7IN3E_WriteFrame(const UBYTE *Data, UDOUBLE Len)
+{
+    Panel.WriteFrame(Data, Len);
+}
 
-    DEV_Digital_Write(EPD_CS_PIN, 1);
+void EPD_7IN3E_EndFrame(void)
+{
+    Panel.EndFrame();
+    Panel.Refresh();
+}
 
-    EPD_7IN3E_TurnOnDisplay();
-    return true;
+/******************************************************************************
+function :  End the data phase of a frame that could not be completed
+parameter:
+info:
+    Releases CS without a refresh, so the panel keeps showing the last
+    frame and the next command (e.g. EPD_7IN3E_Sleep) is received as one.
+******************************************************************************/
+void EPD_7IN3E_AbortFrame(void)
+{
+    Panel.EndFrame();
 }
 
 void EPD_7IN3E_DisplayPart(const UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh)
 {
 	unsigned long i, j;
 	UWORD Width, Height;
-	Width = (EPD_7IN3E_WIDTH % 2 == 0)? (EPD_7IN3E_WIDTH / 2 ): (EPD_7IN3E_WIDTH / 2 + 1);
+	Width = EPD_7IN3E_Panel::BYTES_PER_ROW;
 	Height = EPD_7IN3E_HEIGHT;
 	
-	EPD_7IN3E_SendCommand(0x10);
+	Panel.SendCommand(0x10);
 	for(i=0; i<Height; i++) {
 		for(j=0; j<Width; j++) {
 			if(i<image_heigh+ystart && i>=ystart && j<(image_width+xstart)/2 && j>=xstart/2) {
-				EPD_7IN3E_SendData(Image[(j-xstart/2) + (image_width/2*(i-ystart))]);
+				Panel.SendData(Image[(j-xstart/2) + (image_width/2*(i-ystart))]);
 			}
 			else {
-				EPD_7IN3E_SendData(0x11);
+				Panel.SendData(0x11);
 			}
 		}
 	}
-	EPD_7IN3E_TurnOnDisplay();
+	Panel.Refresh();
+}
+
+/******************************************************************************
+function :  Send only pixels xstart..xend-1 by ystart..yend-1 and display
+parameter:
+    rows : Packed rows of the frame, starting with row ystart
+info:
+    For redrawing part of a frame already in the panel RAM, with the area
+    from Paint_GetDirty(). Returns false, sending nothing, if it is empty.
+******************************************************************************/
+bool EPD_7IN3E_DisplayWindow(const UBYTE *rows, UWORD xstart, UWORD ystart, UWORD xend, UWORD yend)
+{
+    return Panel.DisplayWindow(rows, xstart, ystart, xend, yend);
 }
 
 /******************************************************************************
@@ -348,13 +233,5 @@ parameter:
 ******************************************************************************/
 void EPD_7IN3E_Sleep(void)
 {
-    EPD_7IN3E_SendCommand(0X02); // POWER_OFF
-    EPD_7IN3E_SendData(0x00);
-    EPD_7IN3E_ReadBusyH(); // Wait for power-off to complete
-
-    EPD_7IN3E_SendCommand(0x07); // DEEP_SLEEP
-    EPD_7IN3E_SendData(0XA5);
-    DEV_Delay_ms(100); // Give display time to enter sleep, but don't wait for busy
-    // Note: Display may not signal completion when entering deep sleep mode
+    Panel.Sleep();
 }
-
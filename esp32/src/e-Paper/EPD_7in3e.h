@@ -33,6 +33,7 @@
 
 #include "../Config/Debug.h"
 #include "../Config/DEV_Config.h"
+#include "EPD_Panel.h"
 
 class Stream;
 
@@ -51,6 +52,13 @@ Color Index
 #define EPD_7IN3E_BLUE    0x5   /// 101
 #define EPD_7IN3E_GREEN   0x6   /// 110
 
+// The 7.3inch Spectra 6 on the default DEV_Config pins. Additional panels on
+// the same bus instantiate EpdPanel with their own EpdPins.
+typedef EpdPanel<EPD_7IN3E_WIDTH, EPD_7IN3E_HEIGHT, EpdDefaultPins, EpdDevBus> EPD_7IN3E_Panel;
+
+// Returned by EPD_7IN3E_ReadTemperature when no valid reading is available
+#define EPD_7IN3E_TEMP_INVALID  EPD_PANEL_TEMP_INVALID
+
 void EPD_7IN3E_Init(void);
 void EPD_7IN3E_Init_Fast(void);
 void EPD_7IN3E_Clear(UBYTE color);
@@ -58,7 +66,14 @@ void EPD_7IN3E_Show7Block(void);
 void EPD_7IN3E_Show(void);
 void EPD_7IN3E_Display(UBYTE *Image);
 void EPD_7IN3E_DisplayPart(const UBYTE *Image, UWORD xstart, UWORD ystart, UWORD image_width, UWORD image_heigh);
+bool EPD_7IN3E_DisplayWindow(const UBYTE *rows, UWORD xstart, UWORD ystart, UWORD xend, UWORD yend);
 void EPD_7IN3E_Sleep(void);
-bool EPD_7IN3E_DisplayStream(Stream &stream, UDOUBLE len);
+bool EPD_7IN3E_DisplayStream(Stream &stream, UDOUBLE len, EPD_ROW_FILTER Filter = NULL, void *User = NULL);
+void EPD_7IN3E_BeginFrame(void);
+void EPD_7IN3E_WriteFrame(const UBYTE *Data, UDOUBLE Len);
+void EPD_7IN3E_EndFrame(void);
+void EPD_7IN3E_AbortFrame(void);
+UDOUBLE EPD_7IN3E_GetLastRefreshMs(void);
+int EPD_7IN3E_ReadTemperature(void);
 
 #endif
@@ -0,0 +1,603 @@
+/*****************************************************************************
+* | File        :   EPD_Panel.h
+* | Function    :   Spectra 6 (7.3inch e-Paper (E) family) panel driver template
+* | Info        :
+*   One EpdPanel instance drives one controller. Resolution, pins and the SPI
+*   bus are compile-time parameters, so several panels can share one bus on
+*   separate CS/BUSY/RST lines without any per-call pin lookups.
+*
+*   The refresh is split in two (StartRefresh / WaitRefresh) so frame data
+*   can be streamed to one panel while another one is still refreshing:
+*
+*       PanelA.DisplayStream(..., false);   // data + start refresh A
+*       PanelB.DisplayStream(..., false);   // data for B while A refreshes
+*       PanelA.WaitRefresh();
+*       PanelB.WaitRefresh();
+*
+*   EPD_DisplayStreamPair() is that sequence; pi/bench/panel_check.cpp runs
+*   it against two simulated controllers. Both panels are initialized
+*   before it, see EpdPins. The 13.3" (E) is not such a pair: its two
+*   controllers split every row of one frame and are driven by EPD_13in3e.
+*----------------
+* | This version:   V1.0
+* | Info        :   Register values from the Waveshare EPD_7in3e driver
+******************************************************************************/
+#ifndef __EPD_PANEL_H_
+#define __EPD_PANEL_H_
+
+#include "../Config/Debug.h"
+#include "../Config/DEV_Config.h"
+
+class Stream;
+
+// Returned by ReadTemperature when no valid reading is available
+#define EPD_PANEL_TEMP_INVALID  (-128)
+
+/**
+ * Called by the stream pumps on whole rows just before they go to the
+ * panel, e.g. to draw an overlay into them: Rows holds Count packed rows,
+ * the first of which is row Ystart of the frame.
+**/
+typedef void (*EPD_ROW_FILTER)(UBYTE *Rows, UWORD Ystart, UWORD Count, void *User);
+
+/**
+ * Pin set of one panel.
+ * Panels on a shared bus need their own CS, BUSY and RST. Init() pulses
+ * RST, so with a shared RST it would also reset a panel in the middle of
+ * its refresh. DC may be shared, since it is only sampled while CS is low.
+**/
+template <UBYTE Cs, UBYTE Dc, UBYTE Rst, UBYTE Busy>
+struct EpdPins {
+    static const UBYTE CS = Cs;
+    static const UBYTE DC = Dc;
+    static const UBYTE RST = Rst;
+    static const UBYTE BUSY = Busy;
+};
+typedef EpdPins<EPD_CS_PIN, EPD_DC_PIN, EPD_RST_PIN, EPD_BUSY_PIN> EpdDefaultPins;
+
+/**
+ * SPI bus on top of DEV_Config.
+ * Read is bit-banged on the shared SDA line: Release() hands the pins over
+ * from the SPI peripheral, Restore() gives them back. CS is left to the
+ * caller so the same bus can serve any panel.
+**/
+struct EpdDevBus {
+    static void Write(UBYTE Data)
+    {
+        DEV_SPI_WriteByte(Data);
+    }
+    static void Write(UBYTE *pData, UDOUBLE Len)
+    {
+        DEV_SPI_Write_nByte(pData, Len);
+    }
+    static void Release(void)
+    {
+        DEV_GPIO_Init();
+    }
+    static void Restore(void)
+    {
+        DEV_SPI_Init();
+    }
+    static UBYTE Read(void)
+    {
+        UBYTE j = 0;
+        GPIO_Mode(EPD_MOSI_PIN, 0);
+        for (int i = 0; i < 8; i++) {
+            j = j << 1;
+            if (DEV_Digital_Read(EPD_MOSI_PIN))
+                j = j | 0x01;
+            DEV_Digital_Write(EPD_SCK_PIN, GPIO_PIN_SET);
+            DEV_Digital_Write(EPD_SCK_PIN, GPIO_PIN_RESET);
+        }
+        GPIO_Mode(EPD_MOSI_PIN, 1);
+        return j;
+    }
+};
+
+template <UWORD Width, UWORD Height, class Pins, class Bus>
+class EpdPanel {
+public:
+    static const UWORD WIDTH = Width;
+    static const UWORD HEIGHT = Height;
+    static const UWORD BYTES_PER_ROW = (Width % 2 == 0) ? (Width / 2) : (Width / 2 + 1);
+    static const UDOUBLE FRAME_BYTES = (UDOUBLE)BYTES_PER_ROW * Height;
+
+    EpdPanel() : RefreshStart(0), LastRefreshMs(0) {}
+
+    /******************************************************************************
+    function :  Initialize the e-Paper register
+    ******************************************************************************/
+    void Init(void)
+    {
+        GPIO_Config();
+        Reset();
+        ReadBusyH();
+        DEV_Delay_ms(30);
+
+        SendCommand(0xAA);    // CMDH
+        SendData(0x49);
+        SendData(0x55);
+        SendData(0x20);
+        SendData(0x08);
+        SendData(0x09);
+        SendData(0x18);
+
+        SendCommand(0x01);
+        SendData(0x3F);
+
+        SendCommand(0x00);
+        SendData(0x5F);
+        SendData(0x69);
+
+        SendCommand(0x03);
+        SendData(0x00);
+        SendData(0x54);
+        SendData(0x00);
+        SendData(0x44);
+
+        SendCommand(0x05);
+        SendData(0x40);
+        SendData(0x1F);
+        SendData(0x1F);
+        SendData(0x2C);
+
+        SendCommand(0x06);
+        SendData(0x6F);
+        SendData(0x1F);
+        SendData(0x17);
+        SendData(0x49);
+
+        SendCommand(0x08);
+        SendData(0x6F);
+        SendData(0x1F);
+        SendData(0x1F);
+        SendData(0x22);
+
+        SendCommand(0x30);
+        SendData(0x03);
+
+        SendCommand(0x50);
+        SendData(0x3F);
+
+        SendCommand(0x60);
+        SendData(0x02);
+        SendData(0x00);
+
+        SendCommand(0x61);    // TRES: resolution from the template parameters
+        SendData((UBYTE)(Width >> 8));
+        SendData((UBYTE)(Width & 0xFF));
+        SendData((UBYTE)(Height >> 8));
+        SendData((UBYTE)(Height & 0xFF));
+
+        SendCommand(0x84);
+        SendData(0x01);
+
+        SendCommand(0xE3);
+        SendData(0x2F);
+
+        SendCommand(0x04);     //PWR on
+        ReadBusyH();          //waiting for the electronic paper IC to release the idle signal
+    }
+
+    /******************************************************************************
+    function :  Initialize the e-Paper register with the fast-refresh waveform
+    info:
+        Use instead of Init(), not after it: this is the whole init.
+        The controller picks its waveform from the temperature it measures.
+        As in the Waveshare UC81xx drivers' Init_Fast (e.g. EPD_7in5_V2),
+        CCSET (0xE0) = 0x02 makes it take the temperature from TSSET (0xE5)
+        instead, and a fixed 0x5A there selects the short waveform, trading
+        some color saturation and ghosting for a much shorter refresh.
+    ******************************************************************************/
+    void InitFast(void)
+    {
+        GPIO_Config();
+        Reset();
+        ReadBusyH();
+        DEV_Delay_ms(30);
+
+        SendCommand(0xAA);    // CMDH
+        SendData(0x49);
+        SendData(0x55);
+        SendData(0x20);
+        SendData(0x08);
+        SendData(0x09);
+        SendData(0x18);
+
+        SendCommand(0x01);
+        SendData(0x3F);
+
+        SendCommand(0x00);
+        SendData(0x5F);
+        SendData(0x69);
+
+        SendCommand(0x03);
+        SendData(0x00);
+        SendData(0x54);
+        SendData(0x00);
+        SendData(0x44);
+
+        SendCommand(0x05);
+        SendData(0x40);
+        SendData(0x1F);
+        SendData(0x1F);
+        SendData(0x2C);
+
+        SendCommand(0x06);
+        SendData(0x6F);
+        SendData(0x1F);
+        SendData(0x17);
+        SendData(0x49);
+
+        SendCommand(0x08);
+        SendData(0x6F);
+        SendData(0x1F);
+        SendData(0x1F);
+        SendData(0x22);
+
+        SendCommand(0x30);
+        SendData(0x03);
+
+        SendCommand(0x50);
+        SendData(0x3F);
+
+        SendCommand(0x60);
+        SendData(0x02);
+        SendData(0x00);
+
+        SendCommand(0x61);    // TRES: resolution from the template parameters
+        SendData((UBYTE)(Width >> 8));
+        SendData((UBYTE)(Width & 0xFF));
+        SendData((UBYTE)(Height >> 8));
+        SendData((UBYTE)(Height & 0xFF));
+
+        SendCommand(0x84);
+        SendData(0x01);
+
+        SendCommand(0xE3);
+        SendData(0x2F);
+
+        SendCommand(0x04);     //PWR on
+        ReadBusyH();
+
+        SendCommand(0xE0);    // CCSET: temperature from TSSET
+        SendData(0x02);
+        SendCommand(0xE5);    // TSSET: forced temperature value
+        SendData(0x5A);
+    }
+
+    /******************************************************************************
+    function :  Read the controller's internal temperature sensor
+    info:
+        Call after Init(). Returns whole degrees Celsius, or
+        EPD_PANEL_TEMP_INVALID when the line is not driven (-1 C is not a
+        plausible indoor reading, so all ones is treated as "no answer").
+    ******************************************************************************/
+    int ReadTemperature(void)
+    {
+        SendCommand(0x40);    // TSC: measure and return temperature
+        ReadBusyH();
+
+        Bus::Release();
+        DEV_Digital_Write(Pins::DC, 1);
+        DEV_Digital_Write(Pins::CS, 0);
+        UBYTE Temp = Bus::Read();   // D[10:3]: signed whole degrees
+        Bus::Read();                // D[2:0]: fraction, not needed
+        DEV_Digital_Write(Pins::CS, 1);
+        Bus::Restore();
+
+        if (Temp == 0xFF) {
+            return EPD_PANEL_TEMP_INVALID;
+        }
+        return (int)(int8_t)Temp;
+    }
+
+    /******************************************************************************
+    function :  Clear screen
+    ******************************************************************************/
+    void Clear(UBYTE Color)
+    {
+        UBYTE Row[BYTES_PER_ROW];
+        for (UWORD i = 0; i < BYTES_PER_ROW; i++) {
+            Row[i] = (Color << 4) | Color;
+        }
+
+        BeginFrame();
+        for (UWORD j = 0; j < Height; j++) {
+            WriteFrame(Row, BYTES_PER_ROW);
+        }
+        EndFrame();
+
+        Refresh();
+    }
+
+    /******************************************************************************
+    function :  Sends the image buffer in RAM to e-Paper and displays
+    ******************************************************************************/
+    void Display(const UBYTE *Image)
+    {
+        BeginFrame();
+        WriteFrame(Image, FRAME_BYTES);
+        EndFrame();
+
+        Refresh();
+    }
+
+    /******************************************************************************
+    function :  Send only a window of a frame and display it
+    parameter:
+        Rows        : Packed 4bpp rows, BYTES_PER_ROW each, the first of which
+                      is row Ystart (a band, or Image + Ystart * BYTES_PER_ROW)
+        Xstart, Ystart, Xend, Yend : Pixels Xstart..Xend-1 by Ystart..Yend-1,
+                      e.g. from Paint_GetDirty()
+    info:
+        Returns false, without touching the panel, if the window is empty.
+        Otherwise the window is widened to whole 8-pixel columns and only
+        its bytes are sent between PTIN and PTOUT; the rest of the panel RAM
+        keeps what it held. The refresh still covers the whole panel.
+    ******************************************************************************/
+    bool DisplayWindow(const UBYTE *Rows, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+    {
+        if (Xend > Width)
+            Xend = Width;
+        if (Yend > Height)
+            Yend = Height;
+        if (Xstart >= Xend || Ystart >= Yend) {
+            return false;
+        }
+        Xstart &= ~7;
+        Xend = (Xend + 7 > Width) ? Width : ((Xend + 7) & ~7);
+
+        SendCommand(0x91);    // PTIN: DTM data goes to the window only
+        SetWindow(Xstart, Ystart, Xend - 1, Yend - 1);
+        BeginFrame();
+        for (UWORD y = Ystart; y < Yend; y++) {
+            WriteFrame(Rows + (UDOUBLE)(y - Ystart) * BYTES_PER_ROW + Xstart / 2, (Xend - Xstart) / 2);
+        }
+        EndFrame();
+        SendCommand(0x92);    // PTOUT
+
+        Refresh();
+        return true;
+    }
+
+    /******************************************************************************
+    function :  Stream a packed 4bpp frame straight from the network to the panel
+    parameter:
+        stream : Source providing exactly len bytes in the panel's native
+                 packed 4bpp format: BYTES_PER_ROW * HEIGHT, top-down.
+        wait   : false returns right after the refresh has started, so the bus
+                 can be used for another panel; call WaitRefresh() later.
+        Filter : Optional, sees every chunk before it is sent. Chunks are
+                 then whole rows, as many as fit in the 1KB buffer.
+    ******************************************************************************/
+    bool DisplayStream(Stream &stream, UDOUBLE len, bool wait = true,
+                       EPD_ROW_FILTER Filter = NULL, void *User = NULL)
+    {
+        BeginFrame();
+
+        UBYTE buf[(BYTES_PER_ROW > 1024) ? BYTES_PER_ROW : 1024];
+        const size_t chunk = Filter ? (sizeof(buf) / BYTES_PER_ROW) * BYTES_PER_ROW : sizeof(buf);
+        UWORD row = 0;
+        UDOUBLE remaining = len;
+        while (remaining > 0) {
+            const size_t want = (remaining > chunk) ? chunk : (size_t)remaining;
+            const size_t got = stream.readBytes((char*)buf, want);
+            if (got != want) {
+                EndFrame();
+                return false;
+            }
+
+            if (Filter) {
+                const UWORD rows = (UWORD)(got / BYTES_PER_ROW);
+                Filter(buf, row, rows, User);
+                row += rows;
+            }
+            WriteFrame(buf, (UDOUBLE)got);
+            remaining -= (UDOUBLE)got;
+            delay(0);
+        }
+
+        EndFrame();
+
+        if (wait) {
+            Refresh();
+        } else {
+            StartRefresh();
+        }
+        return true;
+    }
+
+    /******************************************************************************
+    function :  Start the frame data phase (DTM, 0x10)
+    info:
+        CS stays asserted until EndFrame(), so WriteFrame() is a plain bulk
+        transfer. Nothing else may use the bus in between.
+    ******************************************************************************/
+    void BeginFrame(void)
+    {
+        SendCommand(0x10);
+        DEV_Digital_Write(Pins::DC, 1);
+        DEV_Digital_Write(Pins::CS, 0);
+    }
+
+    void WriteFrame(const UBYTE *Data, UDOUBLE Len)
+    {
+        Bus::Write((UBYTE *)Data, Len);
+    }
+
+    void EndFrame(void)
+    {
+        DEV_Digital_Write(Pins::CS, 1);
+    }
+
+    /******************************************************************************
+    function :  Power on and start the display refresh without waiting for it
+    ******************************************************************************/
+    void StartRefresh(void)
+    {
+        SendCommand(0x04); // POWER_ON
+        ReadBusyH();
+
+        //Second setting
+        SendCommand(0x06);
+        SendData(0x6F);
+        SendData(0x1F);
+        SendData(0x17);
+        SendData(0x49);
+
+        RefreshStart = millis();
+        SendCommand(0x12); // DISPLAY_REFRESH
+        SendData(0x00);
+    }
+
+    /******************************************************************************
+    function :  Wait for a refresh started by StartRefresh() and power off
+    ******************************************************************************/
+    void WaitRefresh(void)
+    {
+        ReadBusyH();
+        LastRefreshMs = (UDOUBLE)(millis() - RefreshStart);
+
+        SendCommand(0x02); // POWER_OFF
+        SendData(0X00);
+        ReadBusyH();
+    }
+
+    void Refresh(void)
+    {
+        StartRefresh();
+        WaitRefresh();
+    }
+
+    bool IsBusy(void)
+    {
+        return !DEV_Digital_Read(Pins::BUSY);     //LOW: busy, HIGH: idle
+    }
+
+    /******************************************************************************
+    function :  Duration of the last display refresh
+    info:
+        Measured from DISPLAY_REFRESH until BUSY is released, excluding the
+        power on/off phases. 0 until the first refresh.
+    ******************************************************************************/
+    UDOUBLE GetLastRefreshMs(void) const
+    {
+        return LastRefreshMs;
+    }
+
+    /******************************************************************************
+    function :  Enter sleep mode
+    ******************************************************************************/
+    void Sleep(void)
+    {
+        SendCommand(0X02); // POWER_OFF
+        SendData(0x00);
+        ReadBusyH(); // Wait for power-off to complete
+
+        SendCommand(0x07); // DEEP_SLEEP
+        SendData(0XA5);
+        DEV_Delay_ms(100); // Give display time to enter sleep, but don't wait for busy
+        // Note: Display may not signal completion when entering deep sleep mode
+    }
+
+    void SendCommand(UBYTE Reg)
+    {
+        DEV_Digital_Write(Pins::DC, 0);
+        DEV_Digital_Write(Pins::CS, 0);
+        Bus::Write(Reg);
+        DEV_Digital_Write(Pins::CS, 1);
+    }
+
+    void SendData(UBYTE Data)
+    {
+        DEV_Digital_Write(Pins::DC, 1);
+        DEV_Digital_Write(Pins::CS, 0);
+        Bus::Write(Data);
+        DEV_Digital_Write(Pins::CS, 1);
+    }
+
+private:
+    unsigned long RefreshStart;
+    UDOUBLE LastRefreshMs;
+
+    // The default pins are set up by DEV_Module_Init; panels on other pins
+    // configure their own CS/DC/RST/BUSY lines here.
+    void GPIO_Config(void)
+    {
+        pinMode(Pins::BUSY, INPUT_PULLUP);
+        pinMode(Pins::RST, OUTPUT);
+        pinMode(Pins::DC, OUTPUT);
+        pinMode(Pins::CS, OUTPUT);
+        DEV_Digital_Write(Pins::CS, 1);
+    }
+
+    void Reset(void)
+    {
+        DEV_Digital_Write(Pins::RST, 1);
+        DEV_Delay_ms(20);
+        DEV_Digital_Write(Pins::RST, 0);
+        DEV_Delay_ms(2);
+        DEV_Digital_Write(Pins::RST, 1);
+        DEV_Delay_ms(20);
+    }
+
+    // Partial window (0x83): pixels Xs..Xe by Ys..Ye, inclusive, each as
+    // 16 bits MSB first, then PT_SCAN (1: scan inside the window only).
+    void SetWindow(UWORD Xs, UWORD Ys, UWORD Xe, UWORD Ye)
+    {
+        SendCommand(0x83);
+        SendData((UBYTE)(Xs >> 8));
+        SendData((UBYTE)(Xs & 0xFF));
+        SendData((UBYTE)(Xe >> 8));
+        SendData((UBYTE)(Xe & 0xFF));
+        SendData((UBYTE)(Ys >> 8));
+        SendData((UBYTE)(Ys & 0xFF));
+        SendData((UBYTE)(Ye >> 8));
+        SendData((UBYTE)(Ye & 0xFF));
+        SendData(0x01);
+    }
+
+    // Wait until the busy_pin goes HIGH (idle)
+    void ReadBusyH(void)
+    {
+        Debug("e-Paper busy H\r\n");
+        unsigned long timeout = 15000; // 15 second timeout
+        unsigned long start = millis();
+        while (IsBusy()) {
+            DEV_Delay_ms(1);
+            if (millis() - start > timeout) {
+                Debug("e-Paper busy H TIMEOUT\r\n");
+                return; // Exit on timeout to prevent infinite hang
+            }
+        }
+        Debug("e-Paper busy H release\r\n");
+    }
+};
+
+/******************************************************************************
+function :  Update two panels on one bus within a single refresh window
+parameter:
+    A, B      : Initialized panels with their own CS, BUSY and RST pins
+    StreamA/B : Packed 4bpp frames, LenA/LenB bytes
+info:
+    A's refresh is started as soon as its frame is in, B's frame is
+    streamed while A refreshes, then both refreshes are awaited. Returns
+    false if a stream ended early; A is refreshed anyway once started.
+******************************************************************************/
+template <class PanelA, class PanelB>
+bool EPD_DisplayStreamPair(PanelA &A, Stream &StreamA, UDOUBLE LenA,
+                           PanelB &B, Stream &StreamB, UDOUBLE LenB)
+{
+    if (!A.DisplayStream(StreamA, LenA, false)) {
+        return false;
+    }
+    const bool ok = B.DisplayStream(StreamB, LenB, false);
+    A.WaitRefresh();
+    if (ok) {
+        B.WaitRefresh();
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,412 @@
+/*****************************************************************************
+* | File      	:   DEV_Config_Linux.cpp
+* | Author      :   Waveshare team
+* | Function    :   Hardware underlying interface, Linux (Raspberry Pi)
+* | Info        :
+*   Same interface as esp32/src/Config/DEV_Config.cpp, built with DEV_LINUX
+*   so the e-Paper drivers compile unchanged. Select one backend:
+*     USE_GPIOD_LIB : spidev bulk ioctl transfers, GPIO through libgpiod (v1)
+*     USE_MOCK_LIB  : no hardware; SPI traffic is decoded and counted, and the
+*                     frame data (command 0x10) is written to $EPD_MOCK_FRAME
+*----------------
+* |	This version:   V1.0
+* | Date        :   2020-02-19
+* | Info        :
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documnetation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to  whom the Software is
+# furished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS OR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+******************************************************************************/
+#include "DEV_Config.h"
+#include "Debug.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+#ifdef USE_GPIOD_LIB
+#include <gpiod.h>
+#endif
+
+#if !defined(USE_GPIOD_LIB) && !defined(USE_MOCK_LIB)
+#error "Define USE_GPIOD_LIB or USE_MOCK_LIB (see pi/Makefile)"
+#endif
+
+#ifndef EPD_SPI_DEVICE
+#define EPD_SPI_DEVICE   "/dev/spidev0.0"
+#endif
+#ifndef EPD_GPIO_CHIP
+#define EPD_GPIO_CHIP    "gpiochip0"   // name, path or number; gpiochip4 on a Pi 5 with older kernels
+#endif
+#ifndef EPD_SPI_SPEED_HZ
+#define EPD_SPI_SPEED_HZ 4000000
+#endif
+
+// Largest spidev message. The kernel refuses messages longer than the spidev
+// bufsiz module parameter (4096 by default, raise it with spidev.bufsiz=65536
+// on the kernel command line); the actual value is read at init.
+#define DEV_SPI_MAX_MESSAGE   65536
+
+static UDOUBLE DEV_SPI_Bufsiz = 4096;
+
+/******************************************************************************
+function:	Largest message spidev accepts
+******************************************************************************/
+static UDOUBLE DEV_SPI_ReadBufsiz(void)
+{
+    UDOUBLE bufsiz = 4096;
+    FILE *f = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+    if (f) {
+        unsigned long v;
+        if (fscanf(f, "%lu", &v) == 1 && v > 0) {
+            bufsiz = (v < DEV_SPI_MAX_MESSAGE) ? (UDOUBLE)v : DEV_SPI_MAX_MESSAGE;
+        }
+        fclose(f);
+    }
+    return bufsiz;
+}
+
+#ifdef USE_GPIOD_LIB
+/******************************************************************************
+function:	spidev and libgpiod
+info:
+    CS is the SPI controller's CE0 and is asserted per ioctl, as the Python
+    driver does; DEV_Digital_Write() on it does nothing. Build with
+    EPD_GPIO_CS (and dtoverlay=spi0-0cs) to drive it as a plain GPIO instead,
+    so it stays low across a whole frame.
+    The data line belongs to spidev, so the bit-banged register read (the
+    panel temperature) is not available; DEV_Digital_Read() returns 1 for it.
+******************************************************************************/
+static int DEV_SPI_Fd = -1;
+static struct gpiod_chip *DEV_GPIO_Chip = NULL;
+
+struct DEV_GPIO_Line {
+    UWORD pin;
+    struct gpiod_line *line;
+    UWORD mode;     // 0 input, 1 output
+};
+static DEV_GPIO_Line DEV_GPIO_Lines[] = {
+    {EPD_RST_PIN, NULL, 1},
+    {EPD_DC_PIN, NULL, 1},
+    {EPD_BUSY_PIN, NULL, 0},
+    {EPD_PWR_PIN, NULL, 1},
+#ifdef EPD_GPIO_CS
+    {EPD_CS_PIN, NULL, 1},
+#endif
+};
+
+static DEV_GPIO_Line *DEV_GPIO_Find(UWORD Pin)
+{
+    for (size_t i = 0; i < sizeof(DEV_GPIO_Lines) / sizeof(DEV_GPIO_Lines[0]); i++) {
+        if (DEV_GPIO_Lines[i].pin == Pin) {
+            return &DEV_GPIO_Lines[i];
+        }
+    }
+    return NULL;
+}
+
+static int DEV_GPIO_Request(DEV_GPIO_Line *l)
+{
+    if (l->line) {
+        gpiod_line_release(l->line);
+    }
+    l->line = gpiod_chip_get_line(DEV_GPIO_Chip, l->pin);
+    if (!l->line) {
+        return -1;
+    }
+    if (l->mode) {
+        return gpiod_line_request_output(l->line, "epd", 0);
+    }
+    // The HAT's BUSY has its own pull-up; ask for one where supported
+    int ret = gpiod_line_request_input_flags(l->line, "epd", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP);
+    if (ret < 0) {
+        ret = gpiod_line_request_input(l->line, "epd");
+    }
+    return ret;
+}
+
+static UBYTE DEV_HW_Init(void)
+{
+    DEV_GPIO_Chip = gpiod_chip_open_lookup(EPD_GPIO_CHIP);
+    if (!DEV_GPIO_Chip) {
+        LOG_E("Cannot open GPIO chip %s: %s", EPD_GPIO_CHIP, strerror(errno));
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(DEV_GPIO_Lines) / sizeof(DEV_GPIO_Lines[0]); i++) {
+        if (DEV_GPIO_Request(&DEV_GPIO_Lines[i]) < 0) {
+            LOG_E("Cannot request GPIO %u: %s", DEV_GPIO_Lines[i].pin, strerror(errno));
+            return 1;
+        }
+    }
+
+    DEV_SPI_Fd = open(EPD_SPI_DEVICE, O_RDWR);
+    if (DEV_SPI_Fd < 0) {
+        LOG_E("Cannot open %s: %s", EPD_SPI_DEVICE, strerror(errno));
+        return 1;
+    }
+    uint8_t mode = SPI_MODE_0;
+#ifdef EPD_GPIO_CS
+    mode |= SPI_NO_CS;
+#endif
+    uint8_t bits = 8;
+    uint32_t speed = EPD_SPI_SPEED_HZ;
+    if (ioctl(DEV_SPI_Fd, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(DEV_SPI_Fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(DEV_SPI_Fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) {
+        LOG_E("Cannot configure %s: %s", EPD_SPI_DEVICE, strerror(errno));
+        return 1;
+    }
+    return 0;
+}
+
+static void DEV_HW_Exit(void)
+{
+    for (size_t i = 0; i < sizeof(DEV_GPIO_Lines) / sizeof(DEV_GPIO_Lines[0]); i++) {
+        if (DEV_GPIO_Lines[i].line) {
+            gpiod_line_release(DEV_GPIO_Lines[i].line);
+            DEV_GPIO_Lines[i].line = NULL;
+        }
+    }
+    if (DEV_GPIO_Chip) {
+        gpiod_chip_close(DEV_GPIO_Chip);
+        DEV_GPIO_Chip = NULL;
+    }
+    if (DEV_SPI_Fd >= 0) {
+        close(DEV_SPI_Fd);
+        DEV_SPI_Fd = -1;
+    }
+}
+
+static bool DEV_SPI_Message(struct spi_ioc_transfer *xfer, unsigned n)
+{
+    if (ioctl(DEV_SPI_Fd, SPI_IOC_MESSAGE(n), xfer) < 0) {
+        LOG_E("SPI transfer failed: %s", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void DEV_Digital_Write(UWORD Pin, UBYTE Value)
+{
+    DEV_GPIO_Line *l = DEV_GPIO_Find(Pin);
+    if (l && l->line && l->mode) {
+        gpiod_line_set_value(l->line, Value ? 1 : 0);
+    }
+}
+
+UBYTE DEV_Digital_Read(UWORD Pin)
+{
+    DEV_GPIO_Line *l = DEV_GPIO_Find(Pin);
+    if (!l || !l->line) {
+        return 1;
+    }
+    return gpiod_line_get_value(l->line) > 0 ? 1 : 0;
+}
+
+void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode)
+{
+    DEV_GPIO_Line *l = DEV_GPIO_Find(GPIO_Pin);
+    if (!l || l->mode == (Mode ? 1 : 0)) {
+        return;
+    }
+    l->mode = Mode ? 1 : 0;
+    if (DEV_GPIO_Chip && DEV_GPIO_Request(l) < 0) {
+        LOG_E("Cannot switch GPIO %u: %s", GPIO_Pin, strerror(errno));
+    }
+}
+#endif
+
+#ifdef USE_MOCK_LIB
+/******************************************************************************
+function:	Mock spidev
+info:
+    Messages go through the same chunking as on hardware. Bytes sent with
+    DC low are commands, the rest is data; data after command 0x10 (DTM) is
+    the frame and is appended to the file named by $EPD_MOCK_FRAME, if set.
+    BUSY always reads idle.
+******************************************************************************/
+static UBYTE DEV_Mock_Dc = 0;
+static UBYTE DEV_Mock_Command = 0;
+static UDOUBLE DEV_Mock_Commands = 0;
+static UDOUBLE DEV_Mock_DataBytes = 0;
+static UDOUBLE DEV_Mock_FrameBytes = 0;
+static UDOUBLE DEV_Mock_Ioctls = 0;
+static FILE *DEV_Mock_Frame = NULL;
+
+static UBYTE DEV_HW_Init(void)
+{
+    const char *path = getenv("EPD_MOCK_FRAME");
+    if (path && *path) {
+        DEV_Mock_Frame = fopen(path, "wb");
+        if (!DEV_Mock_Frame) {
+            LOG_E("Cannot create %s: %s", path, strerror(errno));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void DEV_HW_Exit(void)
+{
+    LOG_I("Mock spidev: %u commands, %u data bytes (%u frame) in %u ioctls",
+          DEV_Mock_Commands, DEV_Mock_DataBytes, DEV_Mock_FrameBytes, DEV_Mock_Ioctls);
+    if (DEV_Mock_Frame) {
+        fclose(DEV_Mock_Frame);
+        DEV_Mock_Frame = NULL;
+    }
+}
+
+static bool DEV_SPI_Message(struct spi_ioc_transfer *xfer, unsigned n)
+{
+    UDOUBLE total = 0;
+    for (unsigned i = 0; i < n; i++) {
+        total += xfer[i].len;
+    }
+    if (total > DEV_SPI_Bufsiz) {
+        // What the kernel would answer
+        LOG_E("SPI transfer failed: %s", strerror(EMSGSIZE));
+        return false;
+    }
+
+    DEV_Mock_Ioctls++;
+    for (unsigned i = 0; i < n; i++) {
+        const UBYTE *p = (const UBYTE *)(uintptr_t)xfer[i].tx_buf;
+        if (DEV_Mock_Dc == 0) {
+            for (UDOUBLE j = 0; j < xfer[i].len; j++) {
+                DEV_Mock_Command = p[j];
+                DEV_Mock_Commands++;
+                LOG_D("Mock spidev: command 0x%02x", DEV_Mock_Command);
+            }
+            continue;
+        }
+        DEV_Mock_DataBytes += xfer[i].len;
+        if (DEV_Mock_Command == 0x10) {
+            DEV_Mock_FrameBytes += xfer[i].len;
+            if (DEV_Mock_Frame) {
+                fwrite(p, 1, xfer[i].len, DEV_Mock_Frame);
+            }
+        }
+    }
+    return true;
+}
+
+void DEV_Digital_Write(UWORD Pin, UBYTE Value)
+{
+    if (Pin == EPD_DC_PIN) {
+        DEV_Mock_Dc = Value ? 1 : 0;
+    }
+}
+
+UBYTE DEV_Digital_Read(UWORD Pin)
+{
+    (void)Pin;
+    return 1;   // BUSY high = idle
+}
+
+void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode)
+{
+    (void)GPIO_Pin;
+    (void)Mode;
+}
+#endif
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    GPIO_Mode(pin, mode == OUTPUT ? 1 : 0);
+}
+
+void DEV_Delay_ms(UDOUBLE xms)
+{
+    delay(xms);
+}
+
+/******************************************************************************
+function:	Module Initialize, the spidev and GPIO lines
+parameter:
+Info:
+******************************************************************************/
+UBYTE DEV_Module_Init(void)
+{
+    DEV_SPI_Bufsiz = DEV_SPI_ReadBufsiz();
+    if (DEV_HW_Init() != 0) {
+        DEV_HW_Exit();
+        return 1;
+    }
+    DEV_Digital_Write(EPD_CS_PIN, 1);
+    DEV_Digital_Write(EPD_PWR_PIN, 1);
+    LOG_I("SPI %s at %u Hz, %u bytes per transfer", EPD_SPI_DEVICE,
+          (unsigned)EPD_SPI_SPEED_HZ, DEV_SPI_Bufsiz);
+    return 0;
+}
+
+// spidev keeps the pins; there is nothing to hand over
+void DEV_GPIO_Init(void)
+{
+}
+
+void DEV_SPI_Init(void)
+{
+}
+
+/******************************************************************************
+function:
+			SPI read and write
+info:
+    One ioctl per bufsiz bytes, so a whole frame takes a handful of system
+    calls (3 for 192000 bytes at bufsiz 65536) instead of one per byte.
+******************************************************************************/
+void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
+{
+    struct spi_ioc_transfer xfer;
+    while (len > 0) {
+        const UDOUBLE part = (len > DEV_SPI_Bufsiz) ? DEV_SPI_Bufsiz : len;
+        memset(&xfer, 0, sizeof(xfer));
+        xfer.tx_buf = (unsigned long)pData;
+        xfer.len = part;
+        xfer.speed_hz = EPD_SPI_SPEED_HZ;
+        xfer.bits_per_word = 8;
+        if (!DEV_SPI_Message(&xfer, 1)) {
+            return;
+        }
+        pData += part;
+        len -= part;
+    }
+}
+
+void DEV_SPI_WriteByte(UBYTE data)
+{
+    DEV_SPI_Write_nByte(&data, 1);
+}
+
+void DEV_SPI_SendByte(UBYTE data)
+{
+    DEV_SPI_WriteByte(data);
+}
+
+UBYTE DEV_SPI_ReadByte()
+{
+    return 0xff;
+}
+
+void DEV_Module_Exit(void)
+{
+    DEV_Digital_Write(EPD_PWR_PIN, 0);
+    DEV_Digital_Write(EPD_RST_PIN, 0);
+    DEV_HW_Exit();
+}
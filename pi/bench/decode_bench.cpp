@@ -0,0 +1,242 @@
+/**
+ * Host benchmark and output check for the frame decoders (make bench).
+ *
+ * JPEG: a synthetic 800x480 picture (gradients, flat panel-color patches and
+ * noise) is encoded in memory and run through JpegDecoder_Decode, on the
+ * ROM TJpgDec interface implemented with libjpeg (compat/tjpgd.cpp). The
+ * decode alone is timed too, so what remains is the dither and the 4bpp
+ * packing. Every output pixel must be a panel color, and the flat patches
+ * must come out as their own color.
+ *
+ * Base-6: a random tri-pixel frame is expanded by Base6Decoder_Decode and
+ * compared with a digit-by-digit expansion of the same bytes.
+ *
+ * The numbers are host CPU times; the ESP32 is 20-50x slower, but the
+ * ratios between the stages carry over.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <jpeglib.h>
+#include <string.h>
+#include <esp32/rom/tjpgd.h>
+#include "../../esp32/src/Config/FrameDecoder.h"
+#include "../../esp32/src/e-Paper/EPD_7in3e.h"
+
+#define WIDTH   EPD_7IN3E_WIDTH
+#define HEIGHT  EPD_7IN3E_HEIGHT
+#define RUNS    20
+
+/**
+ * A byte array as the network stream the decoders read from
+ */
+class MemoryStream : public Stream {
+public:
+  MemoryStream(const uint8_t* data, size_t len) : data(data), len(len), pos(0) {}
+  size_t readBytes(char* buffer, size_t length) override {
+    const size_t n = (length < len - pos) ? length : len - pos;
+    memcpy(buffer, data + pos, n);
+    pos += n;
+    return n;
+  }
+
+private:
+  const uint8_t* data;
+  size_t len;
+  size_t pos;
+};
+
+static UBYTE frame[WIDTH / 2 * HEIGHT];
+static UWORD frameRow;
+
+static void storeRow(const UBYTE* row) {
+  if (frameRow < HEIGHT) {
+    memcpy(frame + (uint32_t)frameRow * (WIDTH / 2), row, WIDTH / 2);
+  }
+  frameRow++;
+}
+
+static double nowMs() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t lcgState = 1;
+static uint8_t randomByte() {
+  lcgState = lcgState * 1103515245u + 12345u;
+  return (uint8_t)(lcgState >> 16);
+}
+
+// Flat patches in exact panel colors (JpegDecoder's palette), 64x64 each
+static const struct {
+  uint8_t r, g, b;
+  UBYTE epd;
+} kPatches[] = {
+  {0x19, 0x1E, 0x21, EPD_7IN3E_BLACK},
+  {0xE8, 0xE8, 0xE8, EPD_7IN3E_WHITE},
+  {0xB2, 0x13, 0x18, EPD_7IN3E_RED},
+  {0x21, 0x57, 0xBA, EPD_7IN3E_BLUE},
+};
+#define PATCH_SIZE 64
+#define PATCH_TOP  32
+
+static void makePicture(uint8_t* rgb) {
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      uint8_t* p = rgb + ((size_t)y * WIDTH + x) * 3;
+      const uint8_t noise = randomByte() & 0x0F;
+      p[0] = (uint8_t)(x * 255 / WIDTH) ^ noise;
+      p[1] = (uint8_t)(y * 255 / HEIGHT);
+      p[2] = (uint8_t)((x + y) * 255 / (WIDTH + HEIGHT)) ^ noise;
+    }
+  }
+  for (int i = 0; i < (int)(sizeof(kPatches) / sizeof(kPatches[0])); i++) {
+    for (int y = PATCH_TOP; y < PATCH_TOP + PATCH_SIZE; y++) {
+      for (int x = 0; x < PATCH_SIZE; x++) {
+        uint8_t* p = rgb + ((size_t)y * WIDTH + 64 + i * 2 * PATCH_SIZE + x) * 3;
+        p[0] = kPatches[i].r;
+        p[1] = kPatches[i].g;
+        p[2] = kPatches[i].b;
+      }
+    }
+  }
+}
+
+static size_t encodeJpeg(const uint8_t* rgb, unsigned char** out) {
+  struct jpeg_compress_struct cinfo;
+  struct jpeg_error_mgr err;
+  unsigned long len = 0;
+  cinfo.err = jpeg_std_error(&err);
+  jpeg_create_compress(&cinfo);
+  jpeg_mem_dest(&cinfo, out, &len);
+  cinfo.image_width = WIDTH;
+  cinfo.image_height = HEIGHT;
+  cinfo.input_components = 3;
+  cinfo.in_color_space = JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 85, TRUE);  // 4:2:0 baseline, as the server sends
+  jpeg_start_compress(&cinfo, TRUE);
+  while (cinfo.next_scanline < HEIGHT) {
+    JSAMPROW row = (JSAMPROW)(rgb + (size_t)cinfo.next_scanline * WIDTH * 3);
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  return len;
+}
+
+static UINT readMemory(JDEC* jd, BYTE* buf, UINT len) {
+  MemoryStream* stream = (MemoryStream*)jd->device;
+  if (!buf) {
+    static char scratch[4096];
+    return (UINT)stream->readBytes(scratch, len < sizeof(scratch) ? len : sizeof(scratch));
+  }
+  return (UINT)stream->readBytes((char*)buf, len);
+}
+
+static UINT discardBlock(JDEC*, void*, JRECT*) {
+  return 1;
+}
+
+/**
+ * Decode only, to the same MCU blocks JpegDecoder receives
+ */
+static bool decodeOnly(const uint8_t* jpeg, size_t len) {
+  static uint8_t work[4096];
+  MemoryStream stream(jpeg, len);
+  JDEC jd;
+  return jd_prepare(&jd, readMemory, work, sizeof(work), &stream) == JDR_OK &&
+         jd_decomp(&jd, discardBlock, 0) == JDR_OK;
+}
+
+static UBYTE pixelAt(int x, int y) {
+  const UBYTE b = frame[(size_t)y * (WIDTH / 2) + x / 2];
+  return (x & 1) ? (b & 0x0F) : (b >> 4);
+}
+
+static bool benchJpeg() {
+  static uint8_t rgb[WIDTH * HEIGHT * 3];
+  makePicture(rgb);
+  unsigned char* jpeg = NULL;
+  const size_t len = encodeJpeg(rgb, &jpeg);
+
+  double t0 = nowMs();
+  bool ok = true;
+  for (int i = 0; i < RUNS; i++) {
+    ok &= decodeOnly(jpeg, len);
+  }
+  const double decodeMs = (nowMs() - t0) / RUNS;
+
+  t0 = nowMs();
+  for (int i = 0; i < RUNS; i++) {
+    MemoryStream stream(jpeg, len);
+    frameRow = 0;
+    ok &= JpegDecoder_Decode(stream, WIDTH, HEIGHT, storeRow) && frameRow == HEIGHT;
+  }
+  const double totalMs = (nowMs() - t0) / RUNS;
+  free(jpeg);
+
+  printf("JPEG %dx%d, %u bytes (packed frame %u):\n", WIDTH, HEIGHT, (unsigned)len, (unsigned)sizeof(frame));
+  printf("  %-30s %8.3f ms\n", "decode (libjpeg)", decodeMs);
+  printf("  %-30s %8.3f ms\n", "decode + dither + pack", totalMs);
+  printf("  %-30s %8.3f ms\n", "dither + pack", totalMs - decodeMs);
+
+  int badColor = 0;
+  int badPatch = 0;
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      const UBYTE c = pixelAt(x, y);
+      badColor += (c > EPD_7IN3E_GREEN || c == 4);
+    }
+  }
+  // Inner part of each patch: its edges blur in the JPEG
+  for (int i = 0; i < (int)(sizeof(kPatches) / sizeof(kPatches[0])); i++) {
+    for (int y = PATCH_TOP + 16; y < PATCH_TOP + PATCH_SIZE - 16; y++) {
+      for (int x = 16; x < PATCH_SIZE - 16; x++) {
+        badPatch += pixelAt(64 + i * 2 * PATCH_SIZE + x, y) != kPatches[i].epd;
+      }
+    }
+  }
+  printf("  %-30s %d not a panel color, %d wrong in flat patches\n", "output", badColor, badPatch);
+  return ok && badColor == 0 && badPatch == 0;
+}
+
+static bool benchBase6() {
+  // d0*36 + d1*6 + d2 per byte, d0 leftmost; digit -> panel color
+  static const UBYTE kDigitColor[6] = {EPD_7IN3E_BLACK, EPD_7IN3E_WHITE, EPD_7IN3E_YELLOW,
+                                       EPD_7IN3E_RED, EPD_7IN3E_BLUE, EPD_7IN3E_GREEN};
+  static uint8_t packed[WIDTH * HEIGHT / 3];
+  static UBYTE expected[WIDTH / 2 * HEIGHT];
+  for (size_t i = 0; i < sizeof(packed); i++) {
+    packed[i] = randomByte() % 216;
+  }
+  for (size_t i = 0; i < sizeof(packed); i++) {
+    const uint8_t digits[3] = {(uint8_t)(packed[i] / 36), (uint8_t)(packed[i] / 6 % 6), (uint8_t)(packed[i] % 6)};
+    for (int k = 0; k < 3; k++) {
+      const size_t pixel = i * 3 + k;
+      UBYTE* b = expected + pixel / 2;
+      const UBYTE c = kDigitColor[digits[k]];
+      *b = (pixel & 1) ? (UBYTE)((*b & 0xF0) | c) : (UBYTE)((c << 4) | (*b & 0x0F));
+    }
+  }
+
+  const double t0 = nowMs();
+  bool ok = true;
+  for (int i = 0; i < RUNS; i++) {
+    MemoryStream stream(packed, sizeof(packed));
+    frameRow = 0;
+    ok &= Base6Decoder_Decode(stream, WIDTH, HEIGHT, storeRow) && frameRow == HEIGHT;
+  }
+  const double ms = (nowMs() - t0) / RUNS;
+  const bool same = memcmp(frame, expected, sizeof(frame)) == 0;
+
+  printf("Base-6 %dx%d, %u bytes (packed frame %u):\n", WIDTH, HEIGHT, (unsigned)sizeof(packed), (unsigned)sizeof(frame));
+  printf("  %-30s %8.3f ms\n", "expand + pack", ms);
+  printf("  %-30s %s\n", "output", same ? "matches digit-by-digit expansion" : "MISMATCH");
+  return ok && same;
+}
+
+int main() {
+  bool ok = benchJpeg();
+  ok &= benchBase6();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,636 @@
+/**
+ * Host benchmark and output check for GUI_Paint (make bench).
+ *
+ * Times the drawing primitives on a full 800x480 packed 4bpp image, then
+ * draws three fixed workloads across every rotation, mirror and scale:
+ * the primitives, random shapes partly off the image, and text in every
+ * font. A digest of each is compared with the one the original per-pixel
+ * Waveshare GUI_Paint produces for the same calls, so a fast path that
+ * changes a single pixel fails the check (exit status 1).
+ *
+ * The display list (GUI_DisplayList.h) is checked against itself: a scene
+ * recorded once is drawn into a full image with Paint_DrawList, and every
+ * other way of drawing it must give the same bytes.
+ *
+ * Sprites are checked against drawing the same 4bpp pixels one
+ * Paint_SetPixel at a time, and timed against that and Paint_DrawImage.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "../../esp32/src/GUI/GUI_Paint.h"
+#include "../../esp32/src/GUI/GUI_DisplayList.h"
+
+// Digests of the original GUI_Paint, drawing the workloads below
+#define EXPECT_PRIMITIVES 0x071c3fc7960fdadbULL
+#define EXPECT_RANDOM     0x2aef609ac83f4f63ULL
+#define EXPECT_TEXT       0xc41fcf6367f4844dULL
+
+// Digests of the display-list scene drawn with Paint_DrawList, over all
+// orientations and scales, on white and over a noisy picture. Recorded when
+// these checks were added: a change means Paint_DrawList draws differently.
+#define EXPECT_LIST       0x79ba14ea999d6c83ULL
+#define EXPECT_OVERLAY    0x8c35129792d4cbbdULL
+#define EXPECT_SPRITES    0x05d9f1299ecdb90dULL
+
+static UBYTE image[800 * 480 / 2];
+
+static double nowMs() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t digest(uint64_t h) {
+  for (size_t i = 0; i < sizeof(image); i++) {
+    h = (h ^ image[i]) * 0x100000001b3ULL;  // FNV-1a
+  }
+  return h;
+}
+
+// Same sequence on every platform, unlike rand()
+static uint32_t lcgState;
+static int randomBelow(int n) {
+  lcgState = lcgState * 1103515245u + 12345u;
+  return (int)((lcgState >> 8) % (uint32_t)n);
+}
+
+static const UWORD kScales[] = {2, 4, 7};
+
+// The original wrote the gaps of a dotted line (IMAGE_BACKGROUND, 0xFF)
+// over the neighbouring pixel of the same byte at scale 7; that was fixed
+// on purpose, so dotted lines are only compared at the other scales.
+static LINE_STYLE comparableStyle(LINE_STYLE style, UWORD scale) {
+  return scale == 7 ? LINE_STYLE_SOLID : style;
+}
+
+#define BENCH(name, iters, code)                                    \
+  {                                                                 \
+    const double t0 = nowMs();                                      \
+    for (int it = 0; it < (iters); it++) {                          \
+      code;                                                         \
+    }                                                               \
+    printf("  %-30s %8.3f ms\n", name, (nowMs() - t0) / (iters));   \
+  }
+
+static void benchPrimitives(const char* line) {
+  Paint_NewImage(image, 800, 480, 0, 1);
+  Paint_SetScale(7);
+  BENCH("Paint_Clear", 200, Paint_Clear(1));
+  BENCH("ClearWindows full", 20, Paint_ClearWindows(0, 0, 800, 480, 2));
+  BENCH("Rectangle fill full", 5, Paint_DrawRectangle(0, 0, 799, 479, 3, DOT_PIXEL_1X1, DRAW_FILL_FULL));
+  BENCH("Circle fill r=200", 5, Paint_DrawCircle(400, 240, 200, 5, DOT_PIXEL_1X1, DRAW_FILL_FULL));
+  BENCH("Lines 3px diagonal x50", 20,
+        for (int i = 0; i < 50; i++) Paint_DrawLine(10, 10 + i * 8, 790, 470 - i * 8, 0, DOT_PIXEL_3X3, LINE_STYLE_SOLID));
+  BENCH("Lines 1px h/v x200", 20, for (int i = 0; i < 100; i++) {
+    Paint_DrawLine(0, i * 4, 799, i * 4, 0, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    Paint_DrawLine(i * 8, 0, i * 8, 479, 0, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  });
+  BENCH("Font24 screen, transparent", 20,
+        for (int y = 0; y + 24 <= 480; y += 24) Paint_DrawString_EN(0, y, line, &Font24, 0, WHITE));
+  BENCH("Font24 screen, opaque", 20,
+        for (int y = 0; y + 24 <= 480; y += 24) Paint_DrawString_EN(0, y, line, &Font24, 0, 1));
+  BENCH("Font12 screen, opaque", 20,
+        for (int y = 0; y + 12 <= 480; y += 12) Paint_DrawString_EN(0, y, line, &Font12, 0, 6));
+}
+
+static uint64_t drawPrimitives() {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int r = 0; r < 4; r++) {
+    for (int m = 0; m < 4; m++) {
+      for (UWORD s : kScales) {
+        Paint_NewImage(image, 800, 480, r * 90, 1);
+        Paint_SetScale(s);
+        Paint_SetMirroring(m);
+        Paint_Clear(s == 2 ? 0xFF : 1);
+        Paint_DrawRectangle(5, 5, 300, 200, 3, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
+        Paint_DrawRectangle(20, 30, 200, 150, 2, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+        Paint_DrawCircle(200, 200, 60, 5, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+        Paint_DrawCircle(100, 300, 40, 6, DOT_PIXEL_3X3, DRAW_FILL_EMPTY);
+        Paint_DrawLine(0, 0, 470, 470, 0, DOT_PIXEL_2X2, comparableStyle(LINE_STYLE_DOTTED, s));
+        Paint_DrawLine(3, 400, 460, 10, 0, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+        Paint_DrawString_EN(10, 250, "Hello, Spectra 6!", &Font24, 0, 1);
+        Paint_DrawString_EN(10, 350, "transparent", &Font16, 3, WHITE);
+        Paint_ClearWindows(600, 10, 700, 90, 4);
+        Paint_DrawNum(300, 420, 1234567, &Font20, 0, 1);
+        Paint_SetPixel(799, 479, 0);
+        Paint_SetPixel(479, 799, 0);
+        h = digest(h);
+      }
+    }
+  }
+  return h;
+}
+
+/**
+ * Random shapes on full and small images, partly outside them
+ */
+static uint64_t drawRandom() {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  lcgState = 12345;
+  for (int round = 0; round < 3000; round++) {
+    const int r = randomBelow(4);
+    const int m = randomBelow(4);
+    const UWORD s = kScales[randomBelow(3)];
+    const UWORD w = randomBelow(2) ? 800 : 37 + randomBelow(60);
+    const UWORD hgt = randomBelow(2) ? 480 : 29 + randomBelow(50);
+    Paint_NewImage(image, w, hgt, r * 90, 1);
+    Paint_SetScale(s);
+    Paint_SetMirroring(m);
+    Paint_Clear(0);
+    const int mw = Paint.Width + 10;
+    const int mh = Paint.Height + 10;
+    for (int k = 0; k < 6; k++) {
+      const int op = randomBelow(6);
+      const UWORD c = randomBelow(7);
+      const UWORD x0 = randomBelow(mw), y0 = randomBelow(mh);
+      const UWORD x1 = randomBelow(mw), y1 = randomBelow(mh);
+      const UWORD radius = randomBelow(120);
+      const DOT_PIXEL dot = (DOT_PIXEL)(1 + randomBelow(5));
+      const LINE_STYLE style = comparableStyle((LINE_STYLE)randomBelow(2), s);
+      switch (op) {
+        case 0: Paint_DrawRectangle(x0, y0, x1, y1, c, dot, DRAW_FILL_FULL); break;
+        case 1: Paint_DrawCircle(x0, y0, radius, c, dot, DRAW_FILL_FULL); break;
+        case 2: Paint_ClearWindows(x0, y0, x1, y1, c); break;
+        case 3: Paint_DrawLine(x0, y0, x1, y1, c, dot, style); break;
+        case 4: Paint_DrawRectangle(x0, y0, x1, y1, c, dot, DRAW_FILL_EMPTY); break;
+        default: Paint_DrawCircle(x0, y0, radius, c, dot, DRAW_FILL_EMPTY); break;
+      }
+    }
+    h = digest(h);
+  }
+  return h;
+}
+
+static uint64_t drawText(const char* line, const char* cn) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int r = 0; r < 4; r++) {
+    for (int m = 0; m < 4; m++) {
+      for (UWORD s : kScales) {
+        for (UWORD x0 = 0; x0 < 4; x0 += 1 + x0) {  // 0, 1, 3: both nibbles
+          Paint_NewImage(image, 800, 480, r * 90, 1);
+          Paint_SetScale(s);
+          Paint_SetMirroring(m);
+          Paint_Clear(s == 2 ? 0xFF : 1);
+          Paint_DrawString_EN(x0, x0, line, &Font24, 0, 1);
+          Paint_DrawString_EN(x0 + 5, 100 + x0, line, &Font16, 3, WHITE);
+          Paint_DrawString_EN(x0, 300, line, &Font12, 2, 6);
+          Paint_DrawString_EN(x0, 400, line, &Font8, 5, 0x1F);
+          Paint_DrawString_EN(x0 + 1, 200, line, &Font20, 0x13, 2);
+          Paint_DrawString_CN(x0, 150, cn, &Font24CN, 3, 1);
+          Paint_DrawString_CN(x0 + 7, 180, cn, &Font12CN, 0, WHITE);
+          Paint_DrawString_EN(Paint.Width - 30, Paint.Height - 10, "clip", &Font24, 0, 1);
+          h = digest(h);
+        }
+      }
+    }
+  }
+  return h;
+}
+
+static bool check(const char* name, uint64_t got, uint64_t expected) {
+  const bool ok = got == expected;
+  printf("  %-30s %016llx %s\n", name, (unsigned long long)got, ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+#define LIST_CAPACITY 64
+#define IMAGE_BYTES   sizeof(image)
+#define GUARD_BYTES   64
+#define GUARD_FILL    0xA5
+
+static PAINT_CMD listCmds[LIST_CAPACITY];
+static PAINT_LIST scene;
+static UBYTE reference[IMAGE_BYTES];
+static UBYTE bandA[IMAGE_BYTES + 2 * GUARD_BYTES];
+static UBYTE bandB[IMAGE_BYTES];
+static const UBYTE kBitmap[] = {0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C};  // 8x8 face
+
+/**
+ * Shapes, text and a bitmap in fixed places, many of them crossing the
+ * image edges and the 40-row band boundaries, then random shapes
+ */
+static void recordScene(PAINT_LIST* list, bool clear, const char* line, const char* cn) {
+  Paint_ListInit(list, listCmds, LIST_CAPACITY);
+  if (clear) {
+    Paint_ListClear(list, 1);
+  }
+  Paint_ListClearWindows(list, 600, 10, 700, 90, 4);
+  Paint_ListRectangle(list, 5, 5, 300, 200, 3, DOT_PIXEL_2X2, DRAW_FILL_EMPTY);
+  Paint_ListRectangle(list, 20, 30, 200, 150, 2, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_ListCircle(list, 200, 200, 60, 5, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_ListCircle(list, 100, 300, 40, 6, DOT_PIXEL_3X3, DRAW_FILL_EMPTY);
+  Paint_ListCircle(list, 790, 470, 30, 0, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+  Paint_ListLine(list, 0, 0, 470, 470, 0, DOT_PIXEL_2X2, LINE_STYLE_DOTTED);
+  Paint_ListLine(list, 3, 400, 460, 10, 0, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+  Paint_ListLine(list, 0, 79, 799, 81, 3, DOT_PIXEL_4X4, LINE_STYLE_SOLID);
+  Paint_ListPoint(list, 1, 1, 5, DOT_PIXEL_3X3, DOT_FILL_AROUND);
+  Paint_ListPoint(list, 400, 120, 2, DOT_PIXEL_5X5, DOT_FILL_RIGHTUP);
+  Paint_ListString_EN(list, 10, 250, "Hello, Spectra 6!", &Font24, 0, 1);
+  Paint_ListString_EN(list, 10, 350, "transparent", &Font16, 3, WHITE);
+  Paint_ListString_EN(list, 0, 36, line, &Font12, 2, 6);
+  Paint_ListString_EN(list, 770, 465, "clip", &Font24, 0, 1);
+  Paint_ListString_CN(list, 30, 150, cn, &Font24CN, 3, 1);
+  Paint_ListBitMap_Paste(list, kBitmap, 500, 117, 8, 8, 0);
+  Paint_ListBitMap_Paste(list, kBitmap, 508, 117, 8, 8, 1);
+
+  lcgState = 777;
+  for (int k = 0; k < 16; k++) {
+    const UWORD c = randomBelow(7);
+    const UWORD x0 = randomBelow(820), y0 = randomBelow(500);
+    const UWORD x1 = randomBelow(820), y1 = randomBelow(500);
+    const DOT_PIXEL dot = (DOT_PIXEL)(1 + randomBelow(4));
+    switch (randomBelow(4)) {
+      case 0: Paint_ListRectangle(list, x0, y0, x1, y1, c, dot, DRAW_FILL_FULL); break;
+      case 1: Paint_ListCircle(list, x0, y0, randomBelow(90), c, dot, DRAW_FILL_EMPTY); break;
+      case 2: Paint_ListLine(list, x0, y0, x1, y1, c, dot, LINE_STYLE_SOLID); break;
+      default: Paint_ListClearWindows(list, x0, y0, x1, y1, c); break;
+    }
+  }
+}
+
+static void setupPaint(PAINT& paint, UBYTE* buffer, int rotate, int mirror, UWORD scale) {
+  Paint_NewImage(paint, buffer, 800, 480, rotate, 1);
+  Paint_SetScale(paint, scale);
+  Paint_SetMirroring(paint, mirror);
+}
+
+/**
+ * The scene drawn into the full image, the result everything else must match
+ */
+static void drawReference(int rotate, int mirror, UWORD scale, const UBYTE* picture) {
+  PAINT paint;
+  setupPaint(paint, reference, rotate, mirror, scale);
+  if (picture) {
+    memcpy(reference, picture, IMAGE_BYTES);
+  }
+  Paint_DrawList(paint, &scene);
+}
+
+/**
+ * Band sink: the bands in order make up the image
+ */
+struct BandCollector {
+  UBYTE* out;
+  UDOUBLE offset;
+  UWORD rowBytes;
+  unsigned bands;
+};
+
+static void collectBand(const UBYTE* band, UWORD rows, void* user) {
+  BandCollector* c = (BandCollector*)user;
+  const UDOUBLE len = (UDOUBLE)rows * c->rowBytes;
+  if (c->offset + len <= IMAGE_BYTES) {
+    memcpy(c->out + c->offset, band, len);
+  }
+  c->offset += len;
+  c->bands++;
+}
+
+static const int kAllOrientations = 16;
+static const UWORD kBandHeights[] = {1, 7, 40, 480};
+
+/**
+ * Paint_DrawListBanded, for every band height, against the full image
+ */
+static bool checkBanded(int rotate, int mirror, UWORD scale) {
+  bool ok = true;
+  for (UWORD bandRows : kBandHeights) {
+    PAINT paint;
+    setupPaint(paint, bandB, rotate, mirror, scale);
+    BandCollector c = {image, 0, paint.WidthByte, 0};
+    Paint_DrawListBanded(paint, &scene, bandRows, collectBand, &c);
+    ok &= c.offset == (UDOUBLE)paint.WidthByte * 480 && memcmp(image, reference, c.offset) == 0;
+  }
+  return ok;
+}
+
+/**
+ * Paint_DrawListBandedDual: odd bands drawn on a second thread into their
+ * own cache, handed to the sink in order from this one
+ */
+static bool checkBandedDual(int rotate, int mirror, UWORD scale) {
+  bool ok = true;
+  for (UWORD bandRows : kBandHeights) {
+    PAINT even, odd;
+    memset(bandA, GUARD_FILL, sizeof(bandA));
+    setupPaint(even, bandB, rotate, mirror, scale);
+    setupPaint(odd, bandA + GUARD_BYTES, rotate, mirror, scale);
+    BandCollector c = {image, 0, even.WidthByte, 0};
+    Paint_DrawListBandedDual(even, odd, &scene, bandRows, collectBand, &c);
+    ok &= c.offset == (UDOUBLE)even.WidthByte * 480 && memcmp(image, reference, c.offset) == 0;
+    const UDOUBLE len = (UDOUBLE)odd.WidthByte * bandRows;
+    for (UDOUBLE i = 0; i < GUARD_BYTES; i++) {
+      ok &= bandA[i] == GUARD_FILL && bandA[GUARD_BYTES + len + i] == GUARD_FILL;
+    }
+  }
+  return ok;
+}
+
+/**
+ * Paint_SetBand: a band anywhere in the image holds exactly those rows of
+ * the full image, and nothing is written outside the band cache
+ */
+static bool checkSetBand(int rotate, int mirror, UWORD scale) {
+  bool ok = true;
+  for (int k = 0; k < 6; k++) {
+    const UWORD top = randomBelow(480);
+    const UWORD rows = 1 + randomBelow(500 - top);  // may run past the image
+    PAINT paint;
+    memset(bandA, GUARD_FILL, sizeof(bandA));
+    setupPaint(paint, bandA + GUARD_BYTES, rotate, mirror, scale);
+    Paint_SetBand(paint, top, rows);
+    Paint_DrawList(paint, &scene);
+
+    const UDOUBLE len = (UDOUBLE)paint.WidthByte * paint.BandHeight;
+    ok &= paint.BandHeight == ((rows < 480 - top) ? rows : 480 - top);
+    ok &= memcmp(bandA + GUARD_BYTES, reference + (UDOUBLE)top * paint.WidthByte, len) == 0;
+    for (UDOUBLE i = 0; i < GUARD_BYTES; i++) {
+      ok &= bandA[i] == GUARD_FILL && bandA[GUARD_BYTES + len + i] == GUARD_FILL;
+    }
+  }
+  return ok;
+}
+
+/**
+ * Paint_DrawListOnto over a picture, in chunks of rows as the stream pumps
+ * hand them over (1 row per decoded row, 2 per 1 KB DisplayStream buffer),
+ * against the full picture drawn over with Paint_DrawList
+ */
+static bool checkOnto(int rotate, int mirror, UWORD scale, const UBYTE* picture) {
+  static const UWORD kChunks[] = {1, 2, 40};
+  bool ok = true;
+  for (UWORD chunk : kChunks) {
+    PAINT paint;
+    setupPaint(paint, image, rotate, mirror, scale);
+    const UWORD rowBytes = paint.WidthByte;
+    for (UWORD y = 0; y < 480; y += chunk) {
+      const UWORD count = (chunk < 480 - y) ? chunk : 480 - y;
+      memcpy(bandB, picture + (UDOUBLE)y * rowBytes, (UDOUBLE)count * rowBytes);
+      Paint_DrawListOnto(paint, &scene, bandB, y, count);
+      memcpy(image + (UDOUBLE)y * rowBytes, bandB, (UDOUBLE)count * rowBytes);
+    }
+    ok &= memcmp(image, reference, (UDOUBLE)rowBytes * 480) == 0;
+  }
+  return ok;
+}
+
+static uint64_t digestOf(uint64_t h, const UBYTE* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ data[i]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+static bool report(const char* name, bool ok, uint64_t h, uint64_t expected) {
+  ok &= h == expected;
+  printf("  %-30s %016llx %s\n", name, (unsigned long long)h, ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+/**
+ * Every rotation, mirror and scale; the digest is over the references, so
+ * it also changes if the scene itself draws differently. Rotating by 180
+ * degrees draws what mirroring both ways does, so the references are
+ * chained into one digest rather than combined pairwise.
+ */
+static bool checkDisplayList(const char* line, const char* cn) {
+  recordScene(&scene, true, line, cn);
+  bool banded = true, dual = true, band = true;
+  uint64_t h = 0xcbf29ce484222325ULL;
+  lcgState = 4242;
+  for (int o = 0; o < kAllOrientations; o++) {
+    for (UWORD s : kScales) {
+      drawReference((o / 4) * 90, o % 4, s, NULL);
+      h = digestOf(h, reference, IMAGE_BYTES);
+      banded &= checkBanded((o / 4) * 90, o % 4, s);
+      dual &= checkBandedDual((o / 4) * 90, o % 4, s);
+      band &= checkSetBand((o / 4) * 90, o % 4, s);
+    }
+  }
+  bool ok = report("DrawListBanded = DrawList", banded, h, EXPECT_LIST);
+  ok &= report("BandedDual = DrawList", dual, h, EXPECT_LIST);
+  ok &= report("SetBand = DrawList rows", band, h, EXPECT_LIST);
+  ok &= !scene.Overflow;
+
+  // Overlay: the same scene without its clear, over a noisy picture
+  static UBYTE picture[IMAGE_BYTES];
+  lcgState = 99;
+  for (size_t i = 0; i < IMAGE_BYTES; i++) {
+    picture[i] = (UBYTE)randomBelow(256);
+  }
+  recordScene(&scene, false, line, cn);
+  bool onto = true;
+  h = 0xcbf29ce484222325ULL;
+  for (int o = 0; o < kAllOrientations; o++) {
+    for (UWORD s : kScales) {
+      drawReference((o / 4) * 90, o % 4, s, picture);
+      h = digestOf(h, reference, IMAGE_BYTES);
+      onto &= checkOnto((o / 4) * 90, o % 4, s, picture);
+    }
+  }
+  ok &= report("DrawListOnto = DrawList", onto, h, EXPECT_OVERLAY);
+  recordScene(&scene, true, line, cn);
+  return ok;
+}
+
+static void drawBanded(PAINT& paint, UWORD bandRows) {
+  BandCollector c = {image, 0, paint.WidthByte, 0};
+  Paint_DrawListBanded(paint, &scene, bandRows, collectBand, &c);
+}
+
+static void drawBandedDual(PAINT& even, PAINT& odd, UWORD bandRows) {
+  BandCollector c = {image, 0, even.WidthByte, 0};
+  Paint_DrawListBandedDual(even, odd, &scene, bandRows, collectBand, &c);
+}
+
+static void benchDisplayList() {
+  PAINT paint;
+  setupPaint(paint, image, 0, MIRROR_NONE, 7);
+  BENCH("DrawList full image", 20, Paint_DrawList(paint, &scene));
+  setupPaint(paint, bandB, 0, MIRROR_NONE, 7);
+  BENCH("DrawListBanded 40 rows", 20, drawBanded(paint, 40));
+  PAINT odd;
+  setupPaint(odd, bandA + GUARD_BYTES, 0, MIRROR_NONE, 7);
+  BENCH("DrawListBandedDual 40 rows", 20, drawBandedDual(paint, odd, 40));
+}
+
+#define SPRITE_W   37    // odd, so rows end in half a byte
+#define SPRITE_H   23
+#define SPRITE_KEY 4     // not a panel color
+
+static UBYTE spriteData[(SPRITE_W + 1) / 2 * SPRITE_H];
+static UBYTE preparedData[(SPRITE_W + 1) / 2 * SPRITE_H];
+static UBYTE preparedOther[(SPRITE_W + 1) / 2 * SPRITE_H];
+
+static UBYTE spritePixel(const PAINT_SPRITE* sprite, UWORD x, UWORD y) {
+  const UBYTE b = sprite->Data[(UDOUBLE)y * ((sprite->Width + 1) / 2) + x / 2];
+  return (x & 1) ? (b & 0x0F) : (b >> 4);
+}
+
+/**
+ * What Paint_DrawSprite must do, one pixel at a time; sprite stored upright
+ */
+static void drawSpritePerPixel(PAINT& paint, const PAINT_SPRITE* sprite, UWORD x0, UWORD y0) {
+  for (UWORD y = 0; y < sprite->Height; y++) {
+    for (UWORD x = 0; x < sprite->Width; x++) {
+      const UBYTE c = spritePixel(sprite, x, y);
+      if (c != sprite->Key && x0 + x < paint.Width && y0 + y < paint.Height) {
+        Paint_SetPixel(paint, x0 + x, y0 + y, c);
+      }
+    }
+  }
+}
+
+// Odd and even X, and clipped at the right and bottom edges
+static const UWORD kSpriteAt[][2] = {{0, 0}, {1, 3}, {100, 41}, {333, 250}, {790, 470}, {470, 790}};
+
+/**
+ * Paint_DrawSprite with the sprite stored upright, stored for this
+ * orientation (row blits) and stored for another one, opaque and keyed,
+ * against per-pixel drawing of the same pixels
+ */
+static bool checkSprites(uint64_t* h) {
+  lcgState = 31337;
+  for (size_t i = 0; i < sizeof(spriteData); i++) {
+    spriteData[i] = (UBYTE)((randomBelow(7) << 4) | randomBelow(7));   // colors 0..6, so 4 is the key
+  }
+  bool ok = true;
+  for (int o = 0; o < kAllOrientations; o++) {
+    for (UWORD s : kScales) {
+      for (int keyed = 0; keyed < 2; keyed++) {
+        const PAINT_SPRITE upright = {spriteData, SPRITE_W, SPRITE_H,
+                                      (UBYTE)(keyed ? SPRITE_KEY : PAINT_SPRITE_OPAQUE), MIRROR_NONE, ROTATE_0};
+        PAINT paint;
+        setupPaint(paint, reference, (o / 4) * 90, o % 4, s);
+        Paint_Clear(paint, 1);
+        for (const UWORD* at : kSpriteAt) {
+          drawSpritePerPixel(paint, &upright, at[0], at[1]);
+        }
+        const UDOUBLE bytes = (UDOUBLE)paint.WidthByte * 480;
+        *h = digestOf(*h, reference, bytes);
+
+        PAINT other;
+        setupPaint(other, image, ((o / 4 + 1) % 4) * 90, (o + 1) % 4, s);
+        PAINT_SPRITE prepared, preparedElsewhere;
+        Paint_PrepareSprite(paint, &upright, preparedData, &prepared);
+        Paint_PrepareSprite(other, &prepared, preparedOther, &preparedElsewhere);
+
+        const PAINT_SPRITE* const sprites[] = {&upright, &prepared, &preparedElsewhere};
+        for (const PAINT_SPRITE* sprite : sprites) {
+          setupPaint(paint, image, (o / 4) * 90, o % 4, s);
+          Paint_Clear(paint, 1);
+          for (const UWORD* at : kSpriteAt) {
+            Paint_DrawSprite(paint, sprite, at[0], at[1]);
+          }
+          ok &= memcmp(image, reference, bytes) == 0;
+        }
+
+        // Recorded, drawn in 7-row bands
+        PAINT_CMD cmds[8];
+        PAINT_LIST list;
+        Paint_ListInit(&list, cmds, 8);
+        Paint_ListClear(&list, 1);
+        for (const UWORD* at : kSpriteAt) {
+          Paint_ListSprite(&list, &prepared, at[0], at[1]);
+        }
+        setupPaint(paint, bandB, (o / 4) * 90, o % 4, s);
+        BandCollector c = {image, 0, paint.WidthByte, 0};
+        Paint_DrawListBanded(paint, &list, 7, collectBand, &c);
+        ok &= c.offset == bytes && memcmp(image, reference, bytes) == 0;
+      }
+    }
+  }
+  return ok;
+}
+
+#define ICON_W 64
+#define ICON_H 64
+#define ICONS  60
+
+static UBYTE iconData[ICON_W / 2 * ICON_H];
+
+static void drawIconsPerPixel(PAINT& paint, const PAINT_SPRITE* icon) {
+  for (int i = 0; i < ICONS; i++) {
+    drawSpritePerPixel(paint, icon, (i % 12) * ICON_W, (i / 12) * (ICON_H + 16));
+  }
+}
+
+static void drawIconsImage(PAINT& paint) {
+  // Paint_DrawImage counts in 1bpp pixels: 4 per 4bpp pixel
+  for (int i = 0; i < ICONS; i++) {
+    Paint_DrawImage(paint, iconData, (i % 12) * ICON_W * 4, (i / 12) * (ICON_H + 16), ICON_W * 4, ICON_H);
+  }
+}
+
+static void drawIconsSprite(PAINT& paint, const PAINT_SPRITE* icon) {
+  for (int i = 0; i < ICONS; i++) {
+    Paint_DrawSprite(paint, icon, (i % 12) * ICON_W, (i / 12) * (ICON_H + 16));
+  }
+}
+
+/**
+ * 60 64x64 icons. Paint_DrawImage is a plain byte copy: opaque, upright
+ * and on even columns only, the bound for the row blits.
+ */
+static bool benchSprites() {
+  for (size_t i = 0; i < sizeof(iconData); i++) {
+    iconData[i] = (UBYTE)((randomBelow(7) << 4) | randomBelow(7));
+  }
+  const PAINT_SPRITE opaque = {iconData, ICON_W, ICON_H, PAINT_SPRITE_OPAQUE, MIRROR_NONE, ROTATE_0};
+  const PAINT_SPRITE keyed = {iconData, ICON_W, ICON_H, SPRITE_KEY, MIRROR_NONE, ROTATE_0};
+  PAINT paint;
+  setupPaint(paint, image, 0, MIRROR_NONE, 7);
+  BENCH("60 icons, Paint_SetPixel", 20, drawIconsPerPixel(paint, &opaque));
+  BENCH("60 icons, Paint_DrawImage", 20, drawIconsImage(paint));
+  BENCH("60 icons, DrawSprite opaque", 20, drawIconsSprite(paint, &opaque));
+  BENCH("60 icons, DrawSprite keyed", 20, drawIconsSprite(paint, &keyed));
+
+  // Same bytes as Paint_DrawImage where both apply
+  Paint_Clear(paint, 1);
+  drawIconsImage(paint);
+  memcpy(reference, image, IMAGE_BYTES);
+  Paint_Clear(paint, 1);
+  drawIconsSprite(paint, &opaque);
+  const bool ok = memcmp(image, reference, IMAGE_BYTES) == 0;
+
+  setupPaint(paint, image, ROTATE_90, MIRROR_NONE, 7);
+  BENCH("60 icons rotated, SetPixel", 20, drawIconsPerPixel(paint, &keyed));
+  BENCH("60 icons rotated, upright", 20, drawIconsSprite(paint, &keyed));
+  static UBYTE rotated[sizeof(iconData)];
+  PAINT_SPRITE prepared;
+  Paint_PrepareSprite(paint, &keyed, rotated, &prepared);
+  BENCH("60 icons rotated, prepared", 20, drawIconsSprite(paint, &prepared));
+  printf("  %-30s %s\n", "DrawSprite = DrawImage", ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+int main() {
+  char line[48];
+  for (int i = 0; i < 46; i++) {
+    line[i] = ' ' + (i * 7) % 90;
+  }
+  line[46] = '\0';
+  char cn[128] = "";
+  for (int i = 0; i < 20; i++) {
+    strcat(cn, (i % 2) ? "\xe4\xbd\xa0\xe5\xa5\xbd" : "ab");  // "ni hao" in UTF-8
+  }
+
+  printf("GUI_Paint, 800x480 packed 4bpp:\n");
+  benchPrimitives(line);
+
+  printf("Output against the original GUI_Paint:\n");
+  bool ok = check("primitives", drawPrimitives(), EXPECT_PRIMITIVES);
+  ok &= check("random shapes", drawRandom(), EXPECT_RANDOM);
+  ok &= check("text", drawText(line, cn), EXPECT_TEXT);
+
+  printf("Display list against Paint_DrawList into the full image:\n");
+  ok &= checkDisplayList(line, cn);
+  benchDisplayList();
+
+  printf("Sprites against the same pixels drawn one at a time:\n");
+  uint64_t h = 0xcbf29ce484222325ULL;
+  const bool sprites = checkSprites(&h);
+  ok &= report("DrawSprite = SetPixel", sprites, h, EXPECT_SPRITES);
+  ok &= benchSprites();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/**
+ * Host check for EpdPanel on a shared bus (make bench).
+ *
+ * Two EpdPanel instances run against simulated controllers instead of
+ * spidev: each one sees the bytes sent while its CS is low, goes busy on
+ * POWER_ON, DISPLAY_REFRESH and POWER_OFF, and is reset when its RST line
+ * is pulsed. Time is simulated too (SPI at 4 MHz, a 12 s refresh), so the
+ * numbers are what the sequence would take on the bus, not host times.
+ *
+ * EPD_DisplayStreamPair must deliver each panel exactly its own frame,
+ * stream all of B's frame while A refreshes, and finish in about one
+ * refresh instead of two. A shared RST line is shown to reset A in the
+ * middle of its refresh when B is initialized then, which is why EpdPins
+ * asks for one RST per panel.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../esp32/src/e-Paper/EPD_Panel.h"
+
+#define WIDTH        800
+#define HEIGHT       480
+#define FRAME_BYTES  (WIDTH / 2 * HEIGHT)
+#define SPI_HZ       4000000
+#define REFRESH_MS   12000
+#define POWER_MS     20
+
+#define PIN_DC       25
+#define PIN_CS_A     8
+#define PIN_RST_A    17
+#define PIN_BUSY_A   24
+#define PIN_CS_B     7
+#define PIN_RST_B    27
+#define PIN_BUSY_B   23
+
+static uint64_t simUs = 0;
+static UBYTE dcLevel = 0;
+
+/**
+ * One controller as seen from the bus
+ */
+struct SimPanel {
+  UBYTE cs, rst, busy;
+  bool selected;
+  UBYTE command;
+  uint64_t busyUntilUs;
+  bool refreshing;        // DISPLAY_REFRESH running
+  UDOUBLE frameBytes;     // DTM data since the last DTM command
+  UDOUBLE frameMismatches;
+  UDOUBLE bytesWhileOtherRefreshing;
+  unsigned resetsWhileRefreshing;
+  unsigned refreshes;
+  const UBYTE* expected;
+};
+
+static SimPanel panels[2];
+
+static bool isBusy(const SimPanel& p) {
+  return simUs < p.busyUntilUs;
+}
+
+static void settle() {
+  for (SimPanel& p : panels) {
+    if (p.refreshing && !isBusy(p)) {
+      p.refreshing = false;
+    }
+  }
+}
+
+static void goBusy(SimPanel& p, UDOUBLE ms) {
+  p.busyUntilUs = simUs + (uint64_t)ms * 1000;
+}
+
+static void receive(const UBYTE* data, UDOUBLE len) {
+  simUs += (uint64_t)len * 8 * 1000000 / SPI_HZ;
+  settle();
+  for (int i = 0; i < 2; i++) {
+    SimPanel& p = panels[i];
+    if (!p.selected) {
+      continue;
+    }
+    if (dcLevel == 0) {
+      p.command = data[len - 1];
+      if (p.command == 0x10) {
+        p.frameBytes = 0;
+      } else if (p.command == 0x04 || p.command == 0x02) {
+        goBusy(p, POWER_MS);
+      } else if (p.command == 0x12) {
+        goBusy(p, REFRESH_MS);
+        p.refreshing = true;
+        p.refreshes++;
+      }
+      continue;
+    }
+    if (p.command != 0x10) {
+      continue;
+    }
+    for (UDOUBLE j = 0; j < len; j++) {
+      if (p.frameBytes + j >= FRAME_BYTES || data[j] != p.expected[p.frameBytes + j]) {
+        p.frameMismatches++;
+      }
+    }
+    p.frameBytes += len;
+    if (panels[1 - i].refreshing) {
+      p.bytesWhileOtherRefreshing += len;
+    }
+  }
+}
+
+// DEV_Config for the simulation, in place of DEV_Config_Linux.cpp
+void DEV_Digital_Write(UWORD Pin, UBYTE Value) {
+  if (Pin == PIN_DC) {
+    dcLevel = Value;
+  }
+  for (SimPanel& p : panels) {
+    if (Pin == p.cs) {
+      p.selected = (Value == 0);
+    }
+    if (Pin == p.rst && Value == 0) {
+      settle();
+      if (p.refreshing) {
+        p.resetsWhileRefreshing++;
+      }
+      p.refreshing = false;
+      goBusy(p, 1);
+    }
+  }
+}
+
+UBYTE DEV_Digital_Read(UWORD Pin) {
+  settle();
+  for (SimPanel& p : panels) {
+    if (Pin == p.busy) {
+      return isBusy(p) ? 0 : 1;   // LOW: busy
+    }
+  }
+  return 1;
+}
+
+void DEV_Delay_ms(UDOUBLE xms) {
+  simUs += (uint64_t)xms * 1000;
+  settle();
+}
+
+void pinMode(uint8_t, uint8_t) {
+}
+
+struct SimBus {
+  static void Write(UBYTE Data) { receive(&Data, 1); }
+  static void Write(UBYTE* pData, UDOUBLE Len) { receive(pData, Len); }
+};
+
+typedef EpdPanel<WIDTH, HEIGHT, EpdPins<PIN_CS_A, PIN_DC, PIN_RST_A, PIN_BUSY_A>, SimBus> PanelA;
+typedef EpdPanel<WIDTH, HEIGHT, EpdPins<PIN_CS_B, PIN_DC, PIN_RST_B, PIN_BUSY_B>, SimBus> PanelB;
+typedef EpdPanel<WIDTH, HEIGHT, EpdPins<PIN_CS_B, PIN_DC, PIN_RST_A, PIN_BUSY_B>, SimBus> PanelBSharedRst;
+
+/**
+ * A byte array as the network stream the panels read from
+ */
+class MemoryStream : public Stream {
+public:
+  MemoryStream(const UBYTE* data, size_t len) : data(data), len(len), pos(0) {}
+  size_t readBytes(char* buffer, size_t length) override {
+    const size_t n = (length < len - pos) ? length : len - pos;
+    memcpy(buffer, data + pos, n);
+    pos += n;
+    return n;
+  }
+
+private:
+  const UBYTE* data;
+  size_t len;
+  size_t pos;
+};
+
+static UBYTE frameA[FRAME_BYTES];
+static UBYTE frameB[FRAME_BYTES];
+
+static void resetSimulation(UBYTE rstB) {
+  memset(panels, 0, sizeof(panels));
+  panels[0] = {PIN_CS_A, PIN_RST_A, PIN_BUSY_A};
+  panels[1] = {PIN_CS_B, rstB, PIN_BUSY_B};
+  panels[0].expected = frameA;
+  panels[1].expected = frameB;
+  simUs = 0;
+}
+
+static bool framesOk() {
+  return panels[0].frameBytes == FRAME_BYTES && panels[0].frameMismatches == 0 &&
+         panels[1].frameBytes == FRAME_BYTES && panels[1].frameMismatches == 0 &&
+         panels[0].refreshes == 1 && panels[1].refreshes == 1;
+}
+
+int main() {
+  for (UDOUBLE i = 0; i < FRAME_BYTES; i++) {
+    frameA[i] = (UBYTE)(i * 7);
+    frameB[i] = (UBYTE)(i * 13 + 5);
+  }
+  bool ok = true;
+
+  printf("Two EpdPanels on one bus (simulated, SPI %u MHz, %u ms refresh):\n",
+         SPI_HZ / 1000000, REFRESH_MS);
+
+  // One after the other
+  resetSimulation(PIN_RST_B);
+  PanelA a;
+  PanelB b;
+  a.Init();
+  b.Init();
+  uint64_t t0 = simUs;
+  MemoryStream sa1(frameA, FRAME_BYTES), sb1(frameB, FRAME_BYTES);
+  a.DisplayStream(sa1, FRAME_BYTES);
+  b.DisplayStream(sb1, FRAME_BYTES);
+  const double sequentialMs = (simUs - t0) / 1000.0;
+  ok &= framesOk();
+  printf("  %-34s %9.1f ms\n", "DisplayStream A, then B", sequentialMs);
+
+  // EPD_DisplayStreamPair
+  resetSimulation(PIN_RST_B);
+  a.Init();
+  b.Init();
+  t0 = simUs;
+  MemoryStream sa2(frameA, FRAME_BYTES), sb2(frameB, FRAME_BYTES);
+  const bool paired = EPD_DisplayStreamPair(a, sa2, FRAME_BYTES, b, sb2, FRAME_BYTES);
+  const double pairMs = (simUs - t0) / 1000.0;
+  const bool overlapped = panels[1].bytesWhileOtherRefreshing == FRAME_BYTES;
+  const bool pairOk = paired && framesOk() && overlapped && panels[0].resetsWhileRefreshing == 0 &&
+                      pairMs < sequentialMs - REFRESH_MS / 2;
+  ok &= pairOk;
+  printf("  %-34s %9.1f ms, B streamed during A's refresh: %u of %u bytes %s\n",
+         "EPD_DisplayStreamPair", pairMs, panels[1].bytesWhileOtherRefreshing, FRAME_BYTES,
+         pairOk ? "ok" : "FAILED");
+
+  // B initialized on A's RST line while A refreshes
+  resetSimulation(PIN_RST_A);
+  PanelBSharedRst shared;
+  a.Init();
+  MemoryStream sa3(frameA, FRAME_BYTES);
+  a.DisplayStream(sa3, FRAME_BYTES, false);
+  shared.Init();
+  a.WaitRefresh();
+  const bool caught = panels[0].resetsWhileRefreshing == 1;
+  ok &= caught;
+  printf("  %-34s A reset mid-refresh %u time(s) %s\n", "shared RST, B.Init() during A",
+         panels[0].resetsWhileRefreshing, caught ? "(as expected)" : "NOT SEEN");
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#include <Arduino.h>
+#include <sched.h>
+#include <time.h>
+
+StderrPrint Serial;
+
+// Both count from the first call to either
+static struct timespec elapsed(void) {
+  static struct timespec start;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  if (start.tv_sec == 0 && start.tv_nsec == 0) {
+    start = now;
+  }
+  struct timespec d;
+  d.tv_sec = now.tv_sec - start.tv_sec;
+  d.tv_nsec = now.tv_nsec - start.tv_nsec;
+  if (d.tv_nsec < 0) {
+    d.tv_sec--;
+    d.tv_nsec += 1000000000L;
+  }
+  return d;
+}
+
+unsigned long millis(void) {
+  const struct timespec d = elapsed();
+  return (unsigned long)(d.tv_sec * 1000 + d.tv_nsec / 1000000);
+}
+
+unsigned long micros(void) {
+  const struct timespec d = elapsed();
+  return (unsigned long)(d.tv_sec * 1000000 + d.tv_nsec / 1000);
+}
+
+void delay(unsigned long ms) {
+  if (ms == 0) {
+    // A yield, as on the ESP32; nanosleep would still cost a timer slack
+    sched_yield();
+    return;
+  }
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (long)(ms % 1000) * 1000000;
+  nanosleep(&ts, NULL);
+}
@@ -0,0 +1,51 @@
+#ifndef _PI_ARDUINO_H_
+#define _PI_ARDUINO_H_
+
+/**
+ * The part of the Arduino core the shared driver sources use (Log, the
+ * e-Paper panels), on top of Linux. Pin functions go to DEV_Config_Linux.cpp.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// No RTC memory to keep across deep sleep on Linux; plain statics
+#define RTC_DATA_ATTR
+
+#define LOW          0
+#define HIGH         1
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void pinMode(uint8_t pin, uint8_t mode);
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+  size_t write(uint8_t c) { return write(&c, 1); }
+};
+
+class Stream : public Print {
+public:
+  virtual size_t readBytes(char* buffer, size_t length) = 0;
+  size_t write(const uint8_t*, size_t) override { return 0; }
+};
+
+// Serial is stderr, so log lines stay out of piped output
+class StderrPrint : public Print {
+public:
+  size_t write(const uint8_t* buffer, size_t size) override {
+    return fwrite(buffer, 1, size, stderr);
+  }
+};
+extern StderrPrint Serial;
+
+#endif
@@ -0,0 +1 @@
+// Nothing from Wire is used on Linux; Debug.h includes it.
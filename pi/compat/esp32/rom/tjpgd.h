@@ -0,0 +1,43 @@
+#ifndef _PI_TJPGD_H_
+#define _PI_TJPGD_H_
+
+/**
+ * The ESP32 ROM's TJpgDec interface, implemented on libjpeg (tjpgd.cpp) so
+ * JpegDecoder.cpp runs on Linux. Output arrives the way TJpgDec delivers
+ * it: one MCU block at a time, left to right, MCU row by MCU row.
+ */
+
+typedef unsigned int UINT;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+
+typedef enum {
+  JDR_OK = 0,  // succeeded
+  JDR_INTR,    // interrupted by the output function
+  JDR_INP,     // input stream error
+  JDR_MEM1,    // not enough work area
+  JDR_MEM2,    // not enough input buffer
+  JDR_PAR,     // parameter error
+  JDR_FMT1,    // data format error
+  JDR_FMT2,    // right format but not supported
+  JDR_FMT3     // not supported JPEG standard
+} JRESULT;
+
+typedef struct {
+  WORD left, right, top, bottom;
+} JRECT;
+
+typedef struct JDEC JDEC;
+struct JDEC {
+  UINT width, height;  // image size in pixels
+  BYTE msx, msy;       // MCU size in 8x8 blocks
+  void* device;        // user pointer passed to jd_prepare
+  UINT (*infunc)(JDEC*, BYTE*, UINT);
+  void* pool;          // libjpeg state, in the caller's work area
+  UINT sz_pool;
+};
+
+JRESULT jd_prepare(JDEC* jd, UINT (*infunc)(JDEC*, BYTE*, UINT), void* pool, UINT sz_pool, void* dev);
+JRESULT jd_decomp(JDEC* jd, UINT (*outfunc)(JDEC*, void*, JRECT*), BYTE scale);
+
+#endif
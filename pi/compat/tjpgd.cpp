@@ -0,0 +1,151 @@
+#include <esp32/rom/tjpgd.h>
+#include <new>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jpeglib.h>
+
+// Input is pulled through the caller's function in pieces of this size,
+// like the ROM decoder's 512 byte input buffer
+#define TJPGD_INPUT_SIZE 512
+
+struct TjpgdState {
+  struct jpeg_decompress_struct cinfo;
+  struct jpeg_error_mgr err;
+  struct jpeg_source_mgr src;
+  jmp_buf fail;
+  JDEC* jd;
+  JOCTET input[TJPGD_INPUT_SIZE];
+};
+
+static void onError(j_common_ptr cinfo) {
+  TjpgdState* s = (TjpgdState*)cinfo->client_data;
+  longjmp(s->fail, 1);
+}
+
+static void initSource(j_decompress_ptr) {
+}
+
+static boolean fillInput(j_decompress_ptr cinfo) {
+  TjpgdState* s = (TjpgdState*)cinfo->client_data;
+  const UINT n = s->jd->infunc(s->jd, s->input, sizeof(s->input));
+  if (n == 0) {
+    // Ended early: hand libjpeg an EOI so it stops with a warning
+    s->input[0] = 0xFF;
+    s->input[1] = JPEG_EOI;
+    s->src.bytes_in_buffer = 2;
+  } else {
+    s->src.bytes_in_buffer = n;
+  }
+  s->src.next_input_byte = s->input;
+  return TRUE;
+}
+
+static void skipInput(j_decompress_ptr cinfo, long count) {
+  TjpgdState* s = (TjpgdState*)cinfo->client_data;
+  if (count <= 0) {
+    return;
+  }
+  if ((size_t)count <= s->src.bytes_in_buffer) {
+    s->src.next_input_byte += count;
+    s->src.bytes_in_buffer -= count;
+    return;
+  }
+  count -= (long)s->src.bytes_in_buffer;
+  s->src.bytes_in_buffer = 0;
+  s->jd->infunc(s->jd, NULL, (UINT)count);  // NULL: skip, as TJpgDec does
+}
+
+static void termSource(j_decompress_ptr) {
+}
+
+JRESULT jd_prepare(JDEC* jd, UINT (*infunc)(JDEC*, BYTE*, UINT), void* pool, UINT sz_pool, void* dev) {
+  if (sz_pool < sizeof(TjpgdState)) {
+    return JDR_MEM1;
+  }
+  memset(jd, 0, sizeof(*jd));
+  jd->infunc = infunc;
+  jd->device = dev;
+  jd->pool = pool;
+  jd->sz_pool = sz_pool;
+
+  TjpgdState* s = new (pool) TjpgdState;
+  s->jd = jd;
+  s->cinfo.err = jpeg_std_error(&s->err);
+  s->err.error_exit = onError;
+  if (setjmp(s->fail)) {
+    jpeg_destroy_decompress(&s->cinfo);
+    return JDR_FMT1;
+  }
+  jpeg_create_decompress(&s->cinfo);
+  s->cinfo.client_data = s;
+  s->src.init_source = initSource;
+  s->src.fill_input_buffer = fillInput;
+  s->src.skip_input_data = skipInput;
+  s->src.resync_to_restart = jpeg_resync_to_restart;
+  s->src.term_source = termSource;
+  s->src.bytes_in_buffer = 0;
+  s->cinfo.src = &s->src;
+
+  jpeg_read_header(&s->cinfo, TRUE);
+  if (s->cinfo.progressive_mode) {
+    jpeg_destroy_decompress(&s->cinfo);
+    return JDR_FMT3;  // TJpgDec only does baseline
+  }
+  jd->width = s->cinfo.image_width;
+  jd->height = s->cinfo.image_height;
+  jd->msx = s->cinfo.max_h_samp_factor;
+  jd->msy = s->cinfo.max_v_samp_factor;
+  return JDR_OK;
+}
+
+JRESULT jd_decomp(JDEC* jd, UINT (*outfunc)(JDEC*, void*, JRECT*), BYTE scale) {
+  TjpgdState* s = (TjpgdState*)jd->pool;
+  if (scale != 0) {
+    jpeg_destroy_decompress(&s->cinfo);
+    return JDR_PAR;  // the firmware never scales
+  }
+
+  const UINT mcuW = jd->msx * 8;
+  const UINT mcuH = jd->msy * 8;
+  const UINT rowBytes = jd->width * 3;
+  JSAMPLE* band = (JSAMPLE*)malloc((size_t)rowBytes * mcuH);
+  JSAMPLE* block = (JSAMPLE*)malloc((size_t)mcuW * mcuH * 3);
+  JRESULT res = JDR_OK;
+  if (!band || !block) {
+    res = JDR_MEM1;
+  } else if (setjmp(s->fail)) {
+    res = JDR_FMT1;
+  } else {
+    s->cinfo.out_color_space = JCS_RGB;
+    s->cinfo.dct_method = JDCT_ISLOW;
+    jpeg_start_decompress(&s->cinfo);
+    for (UINT top = 0; top < jd->height && res == JDR_OK; top += mcuH) {
+      const UINT rows = (jd->height - top < mcuH) ? jd->height - top : mcuH;
+      for (UINT y = 0; y < rows;) {
+        JSAMPROW line = band + (size_t)y * rowBytes;
+        y += jpeg_read_scanlines(&s->cinfo, &line, 1);
+      }
+      // One MCU at a time, each block's rows packed together
+      for (UINT left = 0; left < jd->width; left += mcuW) {
+        const UINT cols = (jd->width - left < mcuW) ? jd->width - left : mcuW;
+        for (UINT y = 0; y < rows; y++) {
+          memcpy(block + (size_t)y * cols * 3, band + (size_t)y * rowBytes + left * 3, cols * 3);
+        }
+        JRECT rect = {(WORD)left, (WORD)(left + cols - 1), (WORD)top, (WORD)(top + rows - 1)};
+        if (!outfunc(jd, block, &rect)) {
+          res = JDR_INTR;
+          break;
+        }
+      }
+    }
+    if (res == JDR_OK) {
+      jpeg_finish_decompress(&s->cinfo);
+    }
+  }
+  jpeg_destroy_decompress(&s->cinfo);
+  free(block);
+  free(band);
+  return res;
+}
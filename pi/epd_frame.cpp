@@ -0,0 +1,183 @@
+/**
+ * Raspberry Pi client for the 7.3" Spectra 6 HAT, native replacement for
+ * python/epd_bmp.py.
+ *
+ * Fetches the packed 4bpp frame from the server's /esp32/frame endpoint and
+ * writes it to the panel as it arrives, with the same EPD_7in3e driver as
+ * the ESP32 firmware on top of DEV_Config_Linux.cpp. Nothing is converted
+ * on the Pi: the server already sends the panel's native format.
+ *
+ * Usage: epd_frame [server-url]
+ *   server-url defaults to $EPD_SERVER_URL, then http://localhost:3000
+ */
+
+#include <curl/curl.h>
+#include <stdlib.h>
+#include <strings.h>
+#include "../esp32/src/Config/Debug.h"
+#include "../esp32/src/Config/DEV_Config.h"
+#include "../esp32/src/e-Paper/EPD_7in3e.h"
+
+#define FRAME_BYTES ((UDOUBLE)(EPD_7IN3E_WIDTH / 2) * EPD_7IN3E_HEIGHT)
+
+// Bytes collected from the socket before they go to the panel in one write;
+// DEV_SPI_Write_nByte splits them into spidev-sized messages.
+#define SPI_STAGING_BYTES 65536
+
+struct FrameTransfer {
+  CURL* curl;
+  bool started;       // header checked, panel initialized and DTM sent
+  bool fastRefresh;
+  char format[32];
+  UDOUBLE received;
+  UDOUBLE staged;
+  UBYTE staging[SPI_STAGING_BYTES];
+};
+
+static FrameTransfer transfer;
+
+static void flushStaging(FrameTransfer* t) {
+  if (t->staged > 0) {
+    EPD_7IN3E_WriteFrame(t->staging, t->staged);
+    t->staged = 0;
+  }
+}
+
+/**
+ * Pick up the headers displayFrameBody() in the firmware looks at
+ */
+static size_t onHeader(char* buffer, size_t size, size_t count, void* user) {
+  FrameTransfer* t = (FrameTransfer*)user;
+  const size_t len = size * count;
+  char line[128];
+  const size_t n = len < sizeof(line) - 1 ? len : sizeof(line) - 1;
+  memcpy(line, buffer, n);
+  line[n] = '\0';
+  line[strcspn(line, "\r\n")] = '\0';
+
+  char* value = strchr(line, ':');
+  if (!value) {
+    return len;
+  }
+  *value++ = '\0';
+  value += strspn(value, " \t");
+  if (strcasecmp(line, "X-Image-Format") == 0) {
+    snprintf(t->format, sizeof(t->format), "%s", value);
+  } else if (strcasecmp(line, "X-Refresh-Mode") == 0) {
+    t->fastRefresh = strcasecmp(value, "fast") == 0;
+  }
+  return len;
+}
+
+/**
+ * Check the response once the body starts, then stage bytes for the panel
+ */
+static size_t onBody(char* data, size_t size, size_t count, void* user) {
+  FrameTransfer* t = (FrameTransfer*)user;
+  const size_t len = size * count;
+
+  if (!t->started) {
+    long code = 0;
+    curl_off_t length = -1;
+    curl_easy_getinfo(t->curl, CURLINFO_RESPONSE_CODE, &code);
+    curl_easy_getinfo(t->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+    if (code != 200) {
+      LOG_E("HTTP request failed with code: %ld", code);
+      return 0;
+    }
+    if (t->format[0] && strcasecmp(t->format, "packed4bpp") != 0) {
+      LOG_E("Unsupported frame format: %s", t->format);
+      return 0;
+    }
+    if (length >= 0 && (UDOUBLE)length != FRAME_BYTES) {
+      LOG_E("Unexpected frame size: got %ld, expected %u", (long)length, FRAME_BYTES);
+      return 0;
+    }
+    // Initialized only now that the waveform is known
+    LOG_I("Initializing e-Paper display...");
+    if (t->fastRefresh) {
+      EPD_7IN3E_Init_Fast();
+    } else {
+      EPD_7IN3E_Init();
+    }
+    LOG_I("Streaming frame to e-Paper (%s refresh)...", t->fastRefresh ? "fast" : "normal");
+    EPD_7IN3E_BeginFrame();
+    t->started = true;
+  }
+
+  if (t->received + len > FRAME_BYTES) {
+    LOG_E("Frame longer than %u bytes", FRAME_BYTES);
+    return 0;
+  }
+  t->received += len;
+
+  size_t used = 0;
+  while (used < len) {
+    size_t n = SPI_STAGING_BYTES - t->staged;
+    if (n > len - used) {
+      n = len - used;
+    }
+    memcpy(t->staging + t->staged, data + used, n);
+    t->staged += n;
+    used += n;
+    if (t->staged == SPI_STAGING_BYTES) {
+      flushStaging(t);
+    }
+  }
+  return len;
+}
+
+int main(int argc, char** argv) {
+  const char* server = argc > 1 ? argv[1] : getenv("EPD_SERVER_URL");
+  if (!server || !*server) {
+    server = "http://localhost:3000";
+  }
+  char url[512];
+  snprintf(url, sizeof(url), "%s/esp32/frame", server);
+
+  Log_Begin();
+  if (DEV_Module_Init() != 0) {
+    LOG_E("Failed to initialize display module");
+    return 1;
+  }
+
+  curl_global_init(CURL_GLOBAL_DEFAULT);
+  transfer.curl = curl_easy_init();
+  curl_easy_setopt(transfer.curl, CURLOPT_URL, url);
+  curl_easy_setopt(transfer.curl, CURLOPT_HEADERFUNCTION, onHeader);
+  curl_easy_setopt(transfer.curl, CURLOPT_HEADERDATA, &transfer);
+  curl_easy_setopt(transfer.curl, CURLOPT_WRITEFUNCTION, onBody);
+  curl_easy_setopt(transfer.curl, CURLOPT_WRITEDATA, &transfer);
+  curl_easy_setopt(transfer.curl, CURLOPT_BUFFERSIZE, (long)SPI_STAGING_BYTES);
+  curl_easy_setopt(transfer.curl, CURLOPT_CONNECTTIMEOUT, 10L);
+  curl_easy_setopt(transfer.curl, CURLOPT_TIMEOUT, 60L);
+  curl_easy_setopt(transfer.curl, CURLOPT_USERAGENT, "epd_frame");
+
+  LOG_I("Requesting frame from %s", url);
+  const unsigned long start = millis();
+  const CURLcode res = curl_easy_perform(transfer.curl);
+  curl_easy_cleanup(transfer.curl);
+  curl_global_cleanup();
+
+  bool ok = false;
+  if (transfer.started && (res != CURLE_OK || transfer.received != FRAME_BYTES)) {
+    EPD_7IN3E_AbortFrame();
+  }
+  if (res != CURLE_OK) {
+    LOG_E("Download failed: %s", curl_easy_strerror(res));
+  } else if (transfer.received != FRAME_BYTES) {
+    LOG_E("Frame ended after %u of %u bytes", transfer.received, FRAME_BYTES);
+  } else {
+    flushStaging(&transfer);
+    LOG_I("Frame received in %lu ms, refreshing...", millis() - start);
+    EPD_7IN3E_EndFrame();
+    LOG_I("Frame refresh took %u ms", EPD_7IN3E_GetLastRefreshMs());
+    ok = true;
+  }
+
+  if (transfer.started) {
+    EPD_7IN3E_Sleep();
+  }
+  DEV_Module_Exit();
+  return ok ? 0 : 1;
+}
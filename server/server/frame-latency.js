@@ -0,0 +1,147 @@
+/**
+ * Compare frame fetch latency over HTTP (GET /esp32/frame) and the binary
+ * TCP protocol (FRAME_TCP_PORT) against a running server, the way the ESP32
+ * fetches: a new connection per frame, no keep-alive.
+ *
+ *   node frame-latency.js [host] [runs] [format]
+ *
+ * Reports the median time to the response header and to the last byte for
+ * each path, and for a TCP request that repeats the digest of the frame it
+ * just got (the "unchanged" answer, no payload; run the server with
+ * ESP32_IMAGE_HOLD_SECONDS so the repeat gets the same image). Each request
+ * builds a frame, so the build time is part of every number; compare the
+ * paths with each other, not with the device's airtime.
+ */
+
+import http from 'http';
+import net from 'net';
+
+const HOST = process.argv[2] || 'localhost';
+const RUNS = parseInt(process.argv[3], 10) || 10;
+const FORMAT = process.argv[4] || 'packed4bpp';
+const HTTP_PORT = parseInt(process.env.PORT, 10) || 3000;
+const FRAME_TCP_PORT = parseInt(process.env.FRAME_TCP_PORT ?? '3001', 10);
+
+// Keep in sync with server.js and esp32/src/Config/FrameProtocol.h
+const FRAME_FORMATS = ['packed4bpp', 'jpeg', 'png', 'base6x3'];
+const FRAME_PROTO_MAGIC = Buffer.from('EPF1');
+const FRAME_PROTO_REQUEST_SIZE = 32;
+const FRAME_PROTO_RESPONSE_SIZE = 24;
+
+function httpFetch() {
+  return new Promise((resolve, reject) => {
+    const start = process.hrtime.bigint();
+    const req = http.get({
+      host: HOST,
+      port: HTTP_PORT,
+      path: `/esp32/frame?format=${FORMAT}`,
+      agent: false
+    }, (res) => {
+      const headerMs = Number(process.hrtime.bigint() - start) / 1e6;
+      let bytes = 0;
+      res.on('data', (chunk) => { bytes += chunk.length; });
+      res.on('end', () => {
+        if (res.statusCode !== 200) {
+          reject(new Error(`HTTP ${res.statusCode}`));
+          return;
+        }
+        resolve({ headerMs, totalMs: Number(process.hrtime.bigint() - start) / 1e6, bytes });
+      });
+    });
+    req.on('error', reject);
+  });
+}
+
+function tcpFetch(lastDigest) {
+  return new Promise((resolve, reject) => {
+    const request = Buffer.alloc(FRAME_PROTO_REQUEST_SIZE);
+    FRAME_PROTO_MAGIC.copy(request, 0);
+    request.writeUInt8(2, 4);                                   // version
+    request.writeUInt8(0, 5);                                   // 7.3" panel
+    Buffer.from('bench0', 'latin1').copy(request, 6);           // device id
+    request.writeUInt16LE(1 << FRAME_FORMATS.indexOf(FORMAT), 12);
+    request.writeUInt8(FRAME_FORMATS.indexOf(FORMAT), 14);
+    request.writeInt8(-128, 15);                                // temperature unknown
+    if (lastDigest) {
+      lastDigest.copy(request, 16);
+    }
+
+    const start = process.hrtime.bigint();
+    let response = Buffer.alloc(0);
+    let headerMs = 0;
+    const socket = net.connect(FRAME_TCP_PORT, HOST, () => {
+      socket.setNoDelay(true);
+      socket.write(request);
+    });
+    socket.on('data', (chunk) => {
+      if (response.length < FRAME_PROTO_RESPONSE_SIZE && response.length + chunk.length >= FRAME_PROTO_RESPONSE_SIZE) {
+        headerMs = Number(process.hrtime.bigint() - start) / 1e6;
+      }
+      response = Buffer.concat([response, chunk]);
+    });
+    socket.on('end', () => {
+      if (response.length < FRAME_PROTO_RESPONSE_SIZE || !response.subarray(0, 4).equals(FRAME_PROTO_MAGIC)) {
+        reject(new Error('bad TCP response'));
+        return;
+      }
+      const status = response.readUInt8(4);
+      const length = response.readUInt32LE(8);
+      const payloadStart = FRAME_PROTO_RESPONSE_SIZE + response.readUInt8(7);  // after the caption
+      if (status === 2 || response.length !== payloadStart + length) {
+        reject(new Error(`TCP status ${status}, ${response.length - payloadStart} of ${length} bytes`));
+        return;
+      }
+      resolve({
+        headerMs,
+        totalMs: Number(process.hrtime.bigint() - start) / 1e6,
+        bytes: length,
+        unchanged: status === 1,
+        digest: response.subarray(12, 20)
+      });
+    });
+    socket.on('error', reject);
+  });
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function report(name, results) {
+  const header = median(results.map((r) => r.headerMs)).toFixed(1);
+  const total = median(results.map((r) => r.totalMs)).toFixed(1);
+  console.log(`${name.padEnd(22)} header ${header.padStart(8)} ms   total ${total.padStart(8)} ms   ${results[0].bytes} bytes`);
+}
+
+async function main() {
+  if (!FRAME_FORMATS.includes(FORMAT)) {
+    throw new Error(`format must be one of ${FRAME_FORMATS.join(', ')}`);
+  }
+  const httpResults = [];
+  const tcpResults = [];
+  const unchangedResults = [];
+  for (let i = 0; i < RUNS; i++) {
+    httpResults.push(await httpFetch());
+    const frame = await tcpFetch(null);
+    tcpResults.push(frame);
+    const again = await tcpFetch(frame.digest);
+    if (again.unchanged) {
+      unchangedResults.push(again);
+    }
+  }
+
+  console.log(`${RUNS} runs against ${HOST}, format ${FORMAT} (medians):`);
+  report('HTTP /esp32/frame', httpResults);
+  report('TCP frame', tcpResults);
+  if (unchangedResults.length > 0) {
+    report('TCP unchanged', unchangedResults);
+  } else {
+    console.log('TCP unchanged          never hit: the server picked another image each time (ESP32_IMAGE_HOLD_SECONDS=0?)');
+  }
+}
+
+main().catch((error) => {
+  console.error(`frame-latency: ${error.message}`);
+  process.exit(1);
+});
@@ -7,6 +7,9 @@ import { dirname, join, extname } from 'path';
 import exifReader from 'exif-reader';
 import multer from 'multer';
 import crypto from 'crypto';
+import zlib from 'zlib';
+import net from 'net';
+import https from 'https';
 
 const __filename = fileURLToPath(import.meta.url);
 const __dirname = dirname(__filename);
@@ -47,6 +50,53 @@ const upload = multer({
 
 const DEVICE_TYPE = process.env.DEVICE_TYPE || 'spectra6';
 
+// Default waveform for ESP32 frames: 'normal' (best color) or 'fast' (shorter refresh).
+const REFRESH_MODES = ['normal', 'fast'];
+const ESP32_REFRESH_MODE = REFRESH_MODES.includes(process.env.ESP32_REFRESH_MODE)
+  ? process.env.ESP32_REFRESH_MODE
+  : 'normal';
+
+// Spectra 6 panels the ESP32 frame endpoint can encode for (?panel=...).
+// Both use the same packed 4bpp layout; the 13.3" firmware splits each row
+// between its two controllers while streaming.
+const PANELS = {
+  '7in3e': { width: 800, height: 480, format: 'epd7in3e_packed4bpp' },
+  '13in3e': { width: 1200, height: 1600, format: 'epd13in3e_packed4bpp' }
+};
+
+// Transports for ESP32 frames (?format=...). 'jpeg' sends the resized photo
+// undithered; the firmware decodes and dithers it itself. 'png' is the dithered
+// frame as a 4-bit indexed PNG, inflated on the device. 'base6x3' packs three
+// dithered pixels per byte (2/3 of the packed size) with no decoder state.
+// The index of each is its format code in the binary TCP protocol.
+const FRAME_FORMATS = ['packed4bpp', 'jpeg', 'png', 'base6x3'];
+const ESP32_JPEG_QUALITY = Math.min(Math.max(parseFloat(process.env.ESP32_JPEG_QUALITY) || 0.85, 0.1), 1);
+
+// Caption the ESP32 draws over the photo itself (X-Overlay-Text), so frames
+// stay the same for every device: 'date', 'datetime', or literal text.
+const ESP32_OVERLAY = process.env.ESP32_OVERLAY || '';
+
+// Binary frame protocol over raw TCP (esp32/src/Config/FrameProtocol.h),
+// disabled with FRAME_TCP_PORT=0. Panel codes index TCP_PANELS.
+const FRAME_TCP_PORT = parseInt(process.env.FRAME_TCP_PORT ?? '3001', 10) || 0;
+const ESP32_NEXT_WAKE_SECONDS = parseInt(process.env.ESP32_NEXT_WAKE_SECONDS, 10) || 0;
+// Keep a device on the same image for this many seconds, so its frame (and
+// digest) repeats and the binary protocol can answer "unchanged"; 0 picks a
+// new random image on every request.
+const ESP32_IMAGE_HOLD_SECONDS = parseInt(process.env.ESP32_IMAGE_HOLD_SECONDS, 10) || 0;
+const TCP_PANELS = ['7in3e', '13in3e'];
+const FRAME_PROTO_MAGIC = Buffer.from('EPF1');
+const FRAME_PROTO_REQUEST_SIZE = 32;
+const FRAME_PROTO_RESPONSE_SIZE = 24;
+const FRAME_PROTO_STATUS = { frame: 0, unchanged: 1, error: 2 };
+const FRAME_PROTO_CAPTION_MAX = 64;
+
+// Optional HTTPS listener for the same app, enabled by TLS_CERT and TLS_KEY
+// (PEM file paths). A self-signed ECDSA certificate is enough for the ESP32.
+const HTTPS_PORT = parseInt(process.env.HTTPS_PORT, 10) || 3443;
+const TLS_CERT = process.env.TLS_CERT;
+const TLS_KEY = process.env.TLS_KEY;
+
 /**
  * Get all image files from the images directory
  */
@@ -68,6 +118,25 @@ function getRandomImage() {
   return images[Math.floor(Math.random() * images.length)];
 }
 
+/**
+ * Get the image a device shows in the current ESP32_IMAGE_HOLD_SECONDS
+ * period: a hash of the device id and the period number picks it, so every
+ * request in the period gets the same one. Adding or removing images can
+ * change the pick within a period.
+ */
+function getDeviceImage(deviceId) {
+  if (ESP32_IMAGE_HOLD_SECONDS <= 0) {
+    return getRandomImage();
+  }
+  const images = getImageFiles().sort();
+  if (images.length === 0) {
+    throw new Error('No images available');
+  }
+  const period = Math.floor(Date.now() / 1000 / ESP32_IMAGE_HOLD_SECONDS);
+  const hash = crypto.createHash('sha1').update(`${deviceId}:${period}`).digest();
+  return images[hash.readUInt32LE(0) % images.length];
+}
+
 function configureContext(ctx) {
   if (!ctx) {
     return;
@@ -256,6 +325,69 @@ async function resizeAndCropImage(imagePath, targetWidth, targetHeight, opts = {
   return canvas;
 }
 
+/**
+ * Pick the refresh waveform for an ESP32 frame.
+ * A `?refresh=fast|normal` query overrides the ESP32_REFRESH_MODE default, so e.g. a
+ * dashboard scheduler can ask for fast refreshes while nightly photos stay on normal.
+ */
+function resolveRefreshMode(req) {
+  const requested = String(req.query.refresh || '').toLowerCase();
+  return REFRESH_MODES.includes(requested) ? requested : ESP32_REFRESH_MODE;
+}
+
+/**
+ * Caption text for the ESP32 overlay from ESP32_OVERLAY, in the server's local time.
+ * The firmware fonts are printable ASCII only, so anything else is dropped.
+ */
+function resolveOverlayText(now = new Date()) {
+  let text = ESP32_OVERLAY;
+  if (text === 'date' || text === 'datetime') {
+    const options = { weekday: 'long', day: 'numeric', month: 'long' };
+    if (text === 'datetime') {
+      Object.assign(options, { hour: '2-digit', minute: '2-digit', hour12: false });
+    }
+    text = now.toLocaleString('en-GB', options);
+  }
+  return text.replace(/[^\x20-\x7e]/g, '').trim();
+}
+
+/**
+ * Pick the panel geometry for an ESP32 frame from `?panel=`, defaulting to the 7.3".
+ */
+function resolvePanel(req) {
+  const requested = String(req.query.panel || '').toLowerCase();
+  return PANELS[requested] ? requested : '7in3e';
+}
+
+/**
+ * Pick the frame transport from `?format=`, defaulting to raw packed 4bpp.
+ */
+function resolveFrameFormat(req) {
+  const requested = String(req.query.format || '').toLowerCase();
+  return FRAME_FORMATS.includes(requested) ? requested : 'packed4bpp';
+}
+
+/**
+ * Log what the ESP32 reports with its frame request: the panel temperature
+ * read at init, the refresh timing of its previous frame and, with several
+ * servers configured, whether this one was its first choice.
+ */
+function logDeviceStats(req) {
+  const rank = parseInt(req.get('X-Server-Rank'), 10);
+  if (rank > 0) {
+    console.log(`ESP32 ${req.ip} reached this server as failover choice ${rank + 1}`);
+  }
+  const temp = req.get('X-Panel-Temp');
+  if (temp) {
+    console.log(`ESP32 ${req.ip} panel temperature: ${temp} C`);
+  }
+  const ms = req.get('X-Last-Refresh-Ms');
+  if (ms) {
+    const mode = req.get('X-Last-Refresh-Mode') || 'unknown';
+    console.log(`ESP32 ${req.ip} previous refresh: ${ms} ms (${mode})`);
+  }
+}
+
 /**
  * Encode canvas pixels into a 24-bit BMP Buffer (BGR, bottom-up rows)
  */
@@ -390,6 +522,148 @@ function encode7In3ePacked4bpp(canvas) {
   return out;
 }
 
+const BASE6_DIGIT = [0, 1, 2, 3, 1, 4, 5]; // panel color code -> digit (4 is unused, white)
+
+/**
+ * Encode a packed 4bpp 7in3e frame in the base-6 tri-pixel transport:
+ * three pixels per byte as d0*36 + d1*6 + d2 (d0 = leftmost), digits
+ * 0..5 = black, white, yellow, red, blue, green. Pixels run row-major across
+ * row ends, so the frame shrinks to width*height/3 bytes (128000 at 800x480).
+ */
+function encodeBase6x3(packed, width, height) {
+  const pixels = width * height;
+  const out = Buffer.alloc(Math.ceil(pixels / 3));
+  let acc = 0;
+  let n = 0;
+  let o = 0;
+  for (let i = 0; i < pixels; i++) {
+    const byte = packed[i >> 1];
+    const code = (i & 1) ? (byte & 0x0f) : (byte >> 4);
+    acc = acc * 6 + (BASE6_DIGIT[code] ?? 1);
+    if (++n === 3) {
+      out[o++] = acc;
+      acc = 0;
+      n = 0;
+    }
+  }
+  if (n > 0) {
+    out[o] = acc * (n === 1 ? 36 : 6);
+  }
+  return out;
+}
+
+const CRC32_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) {
+      c = (c & 1) ? (0xedb88320 ^ (c >>> 1)) : (c >>> 1);
+    }
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+function crc32(buf) {
+  let c = 0xffffffff;
+  for (let i = 0; i < buf.length; i++) {
+    c = CRC32_TABLE[(c ^ buf[i]) & 0xff] ^ (c >>> 8);
+  }
+  return (c ^ 0xffffffff) >>> 0;
+}
+
+function pngChunk(type, data) {
+  const header = Buffer.alloc(8);
+  header.writeUInt32BE(data.length, 0);
+  header.write(type, 4, 'ascii');
+  const crc = Buffer.alloc(4);
+  crc.writeUInt32BE(crc32(Buffer.concat([header.subarray(4), data])), 0);
+  return Buffer.concat([header, data, crc]);
+}
+
+/**
+ * Apply PNG filter `type` (bpp = 1) to a row into `out`.
+ */
+function pngFilterRow(type, row, prev, out) {
+  for (let i = 0; i < row.length; i++) {
+    const a = i > 0 ? row[i - 1] : 0;
+    const b = prev[i];
+    const c = i > 0 ? prev[i - 1] : 0;
+    let pred = 0;
+    if (type === 1) pred = a;
+    else if (type === 2) pred = b;
+    else if (type === 3) pred = (a + b) >> 1;
+    else if (type === 4) {
+      const p = a + b - c;
+      const pa = Math.abs(p - a);
+      const pb = Math.abs(p - b);
+      const pc = Math.abs(p - c);
+      pred = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+    }
+    out[i] = (row[i] - pred) & 0xff;
+  }
+}
+
+/**
+ * Encode a packed 4bpp 7in3e frame as a 4-bit indexed PNG.
+ * PNG 4-bit rows use the same nibble order (high nibble = left pixel), and the
+ * palette index is the panel color code, so the frame bytes are the pixel data.
+ * Each row gets the filter with the smallest sum of signed bytes (libpng heuristic).
+ */
+function encodeIndexedPng(packed, width, height) {
+  const bytesPerRow = width / 2;
+  const raw = Buffer.alloc((bytesPerRow + 1) * height);
+  const candidate = Buffer.alloc(bytesPerRow);
+  let prev = Buffer.alloc(bytesPerRow);
+
+  for (let y = 0; y < height; y++) {
+    const row = packed.subarray(y * bytesPerRow, (y + 1) * bytesPerRow);
+    const dst = (bytesPerRow + 1) * y;
+    let bestType = 0;
+    let bestSum = Infinity;
+    for (let type = 0; type <= 4; type++) {
+      pngFilterRow(type, row, prev, candidate);
+      let sum = 0;
+      for (let i = 0; i < bytesPerRow; i++) {
+        sum += candidate[i] < 128 ? candidate[i] : 256 - candidate[i];
+      }
+      if (sum < bestSum) {
+        bestSum = sum;
+        bestType = type;
+      }
+    }
+    raw[dst] = bestType;
+    pngFilterRow(bestType, row, prev, raw.subarray(dst + 1, dst + 1 + bytesPerRow));
+    prev = row;
+  }
+
+  const ihdr = Buffer.alloc(13);
+  ihdr.writeUInt32BE(width, 0);
+  ihdr.writeUInt32BE(height, 4);
+  ihdr[8] = 4; // bit depth
+  ihdr[9] = 3; // indexed color
+  // compression, filter and interlace methods stay 0
+
+  // Index = panel color code; 4 is unused by the panel and left white.
+  const plte = Buffer.from([
+    0x00, 0x00, 0x00, // 0 black
+    0xff, 0xff, 0xff, // 1 white
+    0xff, 0xff, 0x00, // 2 yellow
+    0xff, 0x00, 0x00, // 3 red
+    0xff, 0xff, 0xff, // 4 (unused)
+    0x00, 0x00, 0xff, // 5 blue
+    0x00, 0xff, 0x00  // 6 green
+  ]);
+
+  return Buffer.concat([
+    Buffer.from([0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a]),
+    pngChunk('IHDR', ihdr),
+    pngChunk('PLTE', plte),
+    pngChunk('IDAT', zlib.deflateSync(raw, { level: 9 })),
+    pngChunk('IEND', Buffer.alloc(0))
+  ]);
+}
+
 app.get('/bmp', async (req, res) => {
   try {
     const imagePath = getRandomImage();
@@ -482,48 +756,95 @@ app.get('/esp32/image', async (req, res) => {
 });
 
 /**
- * ESP32 packed framebuffer endpoint (recommended for ESP32-WROOM-32 without PSRAM)
- * Returns the display-native packed 4bpp bytes for Waveshare 7.3" (F) 800x480.
+ * Build one ESP32 frame from a random image.
+ * Returns the payload and what the device needs to know about it:
+ * `format` is the X-Image-Format value ('epd7in3e_packed4bpp', 'jpeg', ...).
  */
-app.get('/esp32/frame', async (req, res) => {
-  try {
-    const imagePath = getRandomImage();
-    console.log(`Processing packed frame for ESP32: ${imagePath} for device: ${DEVICE_TYPE}`);
+async function buildEsp32Frame(panelId, format, imagePath = getRandomImage()) {
+  const panel = PANELS[panelId];
+  console.log(`Processing ${format} frame for ESP32: ${imagePath} for device: ${DEVICE_TYPE} (panel: ${panelId})`);
+
+  const ESP32_TARGET_WIDTH = panel.width;
+  const ESP32_TARGET_HEIGHT = panel.height;
+
+  const preparedCanvas = await resizeAndCropImage(
+    imagePath,
+    ESP32_TARGET_WIDTH,
+    ESP32_TARGET_HEIGHT,
+    { enableAspectAutoRotate: true, aspectAutoRotateOrientation: 8 }
+  );
+  console.log(`Image prepared for ESP32 frame: ${preparedCanvas.width}x${preparedCanvas.height}`);
 
-    const ESP32_TARGET_WIDTH = 800;
-    const ESP32_TARGET_HEIGHT = 480;
+  if (format === 'jpeg') {
+    // Baseline JPEG only: the ESP32 ROM decoder has no progressive support.
+    const jpeg = preparedCanvas.toBuffer('image/jpeg', { quality: ESP32_JPEG_QUALITY, progressive: false });
+    console.log(`ESP32 JPEG frame: ${jpeg.length} bytes (packed frame: ${(ESP32_TARGET_WIDTH / 2) * ESP32_TARGET_HEIGHT})`);
+    return { body: jpeg, format: 'jpeg', contentType: 'image/jpeg', width: preparedCanvas.width, height: preparedCanvas.height };
+  }
 
-    const preparedCanvas = await resizeAndCropImage(
-      imagePath,
-      ESP32_TARGET_WIDTH,
-      ESP32_TARGET_HEIGHT,
-      { enableAspectAutoRotate: true, aspectAutoRotateOrientation: 8 }
-    );
-    console.log(`Image prepared for ESP32 frame: ${preparedCanvas.width}x${preparedCanvas.height}`);
+  const canvas = await processImage(preparedCanvas, DEVICE_TYPE, { ditherOptions: { serpentine: true } });
+  console.log(`Processed canvas dimensions for ESP32 frame: ${canvas.width}x${canvas.height}`);
 
-    const canvas = await processImage(preparedCanvas, DEVICE_TYPE, { ditherOptions: { serpentine: true } });
-    console.log(`Processed canvas dimensions for ESP32 frame: ${canvas.width}x${canvas.height}`);
+  if (canvas.width !== ESP32_TARGET_WIDTH || canvas.height !== ESP32_TARGET_HEIGHT) {
+    throw new Error(`Unexpected canvas size for ESP32 frame: ${canvas.width}x${canvas.height}`);
+  }
 
-    if (canvas.width !== ESP32_TARGET_WIDTH || canvas.height !== ESP32_TARGET_HEIGHT) {
-      throw new Error(`Unexpected canvas size for ESP32 frame: ${canvas.width}x${canvas.height}`);
-    }
+  const buffer = encode7In3ePacked4bpp(canvas);
+  const frame = { width: canvas.width, height: canvas.height };
+
+  if (format === 'base6x3') {
+    const base6 = encodeBase6x3(buffer, ESP32_TARGET_WIDTH, ESP32_TARGET_HEIGHT);
+    return { ...frame, body: base6, format: 'base6x3', contentType: 'application/octet-stream' };
+  }
 
-    const buffer = encode7In3ePacked4bpp(canvas);
-    const bytesPerRow = ESP32_TARGET_WIDTH / 2;
+  if (format === 'png') {
+    const png = encodeIndexedPng(buffer, ESP32_TARGET_WIDTH, ESP32_TARGET_HEIGHT);
+    console.log(`ESP32 PNG frame: ${png.length} bytes (packed frame: ${buffer.length})`);
+    return { ...frame, body: png, format: 'png', contentType: 'image/png' };
+  }
 
-    res.set({
-      'Content-Type': 'application/octet-stream',
-      'Content-Length': buffer.length,
+  return { ...frame, body: buffer, format: panel.format, contentType: 'application/octet-stream' };
+}
+
+/**
+ * ESP32 packed framebuffer endpoint (recommended for ESP32-WROOM-32 without PSRAM)
+ * Returns the display-native packed 4bpp bytes for Waveshare 7.3" (F) 800x480,
+ * or for the 13.3" (E) 1200x1600 with `?panel=13in3e`. `?format=jpeg` returns the
+ * resized photo as a baseline JPEG instead, for the firmware to dither itself, and
+ * `?format=png` the dithered frame as a 4-bit indexed PNG, `?format=base6x3` as
+ * three pixels per byte.
+ */
+app.get('/esp32/frame', async (req, res) => {
+  try {
+    logDeviceStats(req);
+    const refreshMode = resolveRefreshMode(req);
+    const panelId = resolvePanel(req);
+    const frame = await buildEsp32Frame(panelId, resolveFrameFormat(req));
+    console.log(`ESP32 frame refresh mode: ${refreshMode}`);
+
+    const headers = {
+      'Content-Type': frame.contentType,
+      'Content-Length': frame.body.length,
       'Cache-Control': 'no-cache, no-store, must-revalidate',
-      'X-Image-Width': canvas.width,
-      'X-Image-Height': canvas.height,
-      'X-Image-Format': 'epd7in3e_packed4bpp',
-      'X-Bytes-Per-Row': bytesPerRow,
-      'X-Byte-Order': 'row-major-top-down',
-      'X-Nibble-Order': 'hi=left,lo=right'
-    });
+      'X-Image-Width': frame.width,
+      'X-Image-Height': frame.height,
+      'X-Image-Format': frame.format,
+      'X-Refresh-Mode': refreshMode
+    };
+    const overlayText = resolveOverlayText();
+    if (overlayText) {
+      headers['X-Overlay-Text'] = overlayText;
+    }
+    if (frame.format === PANELS[panelId].format) {
+      Object.assign(headers, {
+        'X-Bytes-Per-Row': frame.width / 2,
+        'X-Byte-Order': 'row-major-top-down',
+        'X-Nibble-Order': 'hi=left,lo=right'
+      });
+    }
 
-    res.send(buffer);
+    res.set(headers);
+    res.send(frame.body);
   } catch (error) {
     console.error('Error processing packed frame for ESP32:', error);
     res.status(500).json({
@@ -1136,7 +1457,7 @@ app.get('/', (req, res) => {
       '/bmp': 'GET - Returns random optimized image for e-paper display as BMP',
       '/png': 'GET - Returns random optimized image for e-paper display as PNG',
       '/esp32/image': 'GET - Returns random optimized image for ESP32 as BMP',
-      '/esp32/frame': 'GET - Returns random optimized image for ESP32 as packed 4bpp',
+      '/esp32/frame': 'GET - Returns random optimized image for ESP32 as packed 4bpp (?refresh=fast|normal, ?panel=7in3e|13in3e, ?format=packed4bpp|jpeg|png|base6x3)',
       '/upload': 'GET - Upload page to manage images',
       '/upload': 'POST - Upload new image file',
       '/api/images': 'GET - List all images',
@@ -1147,11 +1468,252 @@ app.get('/', (req, res) => {
     config: {
       imagesDirectory: IMAGES_DIR,
       imageCount: imageCount,
-      deviceType: DEVICE_TYPE
+      deviceType: DEVICE_TYPE,
+      esp32RefreshMode: ESP32_REFRESH_MODE
     }
   });
 });
 
+// Latest telemetry upload per ESP32, for GET /esp32/telemetry. Uploads need
+// no token unless ESP32_TELEMETRY_TOKEN is set, so past
+// ESP32_TELEMETRY_MAX_DEVICES the device heard from least recently is dropped.
+const esp32Telemetry = new Map();
+const ESP32_TELEMETRY_MAX_DEVICES = parseInt(process.env.ESP32_TELEMETRY_MAX_DEVICES, 10) || 64;
+// Optional shared secret: when set, uploads and reads both need
+// "Authorization: Bearer <token>" (TELEMETRY_TOKEN in Telemetry.h). Without
+// it the logs can only be read from this host.
+const ESP32_TELEMETRY_TOKEN = process.env.ESP32_TELEMETRY_TOKEN || '';
+// The log is at most the 2 KB RTC ring (Log.h), JSON-escaped, and the memory
+// probe at most 16 phases (MemProbe.h); both fit with room to spare.
+const ESP32_TELEMETRY_BODY_LIMIT = '16kb';
+const ESP32_MEMPROBE_MAX_PHASES = 16;
+// Device ids are the factory MAC in hex (Telemetry.cpp)
+const ESP32_DEVICE_ID = /^[0-9a-f]{12}$/;
+
+/**
+ * Check a telemetry upload and keep only the fields Telemetry.cpp sends.
+ * @param {object} body - parsed JSON body
+ * @returns {object|null} the upload, or null if a field is missing or malformed
+ */
+function parseTelemetry(body) {
+  if (!body || typeof body !== 'object') return null;
+  const { device, wake, uptimeMs, droppedBytes = 0, log = '', memory } = body;
+  const isCount = (value) => Number.isSafeInteger(value) && value >= 0;
+  if (typeof device !== 'string' || !ESP32_DEVICE_ID.test(device)) return null;
+  if (!isCount(wake) || !isCount(uptimeMs) || !isCount(droppedBytes) || typeof log !== 'string') return null;
+  if (memory !== undefined && (typeof memory !== 'object' || memory === null ||
+      !Array.isArray(memory.phases) || memory.phases.length > ESP32_MEMPROBE_MAX_PHASES)) {
+    return null;
+  }
+  return { device, wake, uptimeMs, droppedBytes, log, memory };
+}
+
+/**
+ * Print the heap and stack watermarks a telemetry upload carries, one line
+ * per wake phase, plus the lowest values the device has seen over all wakes.
+ * @param {string} device
+ * @param {object} memory - `memory` field of the upload (see MemProbe.h)
+ */
+function logMemoryProbe(device, memory) {
+  if (!memory || !Array.isArray(memory.phases)) return;
+  const tasks = Array.isArray(memory.tasks) ? memory.tasks : [];
+  const stacks = (stack = []) => tasks.map((name, i) => `${name} ${stack[i] ?? -1}`).join(', ');
+  for (const p of memory.phases) {
+    console.log(`  [${device}] mem ${String(p.phase).padEnd(10)} @${p.ms} ms: free ${p.free}, largest ${p.largest}, min free ${p.minFree}, stack left ${stacks(p.stack)}`);
+  }
+  const low = memory.lowest;
+  if (low) {
+    console.log(`  [${device}] mem lowest: free ${low.free} (${low.freePhase}), largest ${low.largest} (${low.largestPhase}), stack left ${stacks(low.stack)}`);
+  }
+}
+
+/**
+ * Whether a telemetry request may go on: with ESP32_TELEMETRY_TOKEN set it
+ * must carry the token, otherwise uploads are open and reads (GET) must come
+ * over loopback.
+ */
+function telemetryAllowed(req, read) {
+  if (ESP32_TELEMETRY_TOKEN) {
+    const expected = Buffer.from(`Bearer ${ESP32_TELEMETRY_TOKEN}`);
+    const given = Buffer.from(req.get('authorization') || '');
+    return given.length === expected.length && crypto.timingSafeEqual(given, expected);
+  }
+  const address = req.socket.remoteAddress;
+  return !read || address === '127.0.0.1' || address === '::1' || address === '::ffff:127.0.0.1';
+}
+
+/**
+ * ESP32 telemetry: the log lines the firmware buffered in RTC memory since
+ * its last upload and its memory watermarks for this wake. They are printed
+ * here prefixed with the device id.
+ */
+app.post('/esp32/telemetry', express.json({ limit: ESP32_TELEMETRY_BODY_LIMIT }), (req, res) => {
+  if (!telemetryAllowed(req, false)) {
+    console.warn(`ESP32 telemetry from ${req.ip}: missing or wrong token`);
+    res.status(401).end();
+    return;
+  }
+  const upload = parseTelemetry(req.body);
+  if (!upload) {
+    console.warn(`ESP32 telemetry from ${req.ip}: malformed upload ignored`);
+    res.status(400).end();
+    return;
+  }
+  const { device, wake, uptimeMs, droppedBytes, log, memory } = upload;
+  const lines = log.split('\n').filter(Boolean);
+  console.log(`ESP32 ${device} telemetry: wake ${wake}, ${lines.length} log lines, up ${uptimeMs} ms${droppedBytes ? `, ${droppedBytes} bytes lost` : ''}`);
+  for (const line of lines) {
+    console.log(`  [${device}] ${line}`);
+  }
+  logMemoryProbe(device, memory);
+  // Re-insert so Map order stays least recently heard from first
+  esp32Telemetry.delete(device);
+  esp32Telemetry.set(device, { ...upload, receivedAt: new Date().toISOString() });
+  if (esp32Telemetry.size > ESP32_TELEMETRY_MAX_DEVICES) {
+    esp32Telemetry.delete(esp32Telemetry.keys().next().value);
+  }
+  res.status(204).end();
+});
+
+app.get('/esp32/telemetry', (req, res) => {
+  if (!telemetryAllowed(req, true)) {
+    res.status(ESP32_TELEMETRY_TOKEN ? 401 : 403).end();
+    return;
+  }
+  res.json(Object.fromEntries(esp32Telemetry));
+});
+
+/**
+ * Encode the fixed binary response header and the caption that precede the payload.
+ */
+function encodeFrameResponse(status, { formatCode = 0, fast = false, length = 0, digest = null, caption = null } = {}) {
+  const header = Buffer.alloc(FRAME_PROTO_RESPONSE_SIZE);
+  FRAME_PROTO_MAGIC.copy(header, 0);
+  header.writeUInt8(status, 4);
+  header.writeUInt8(formatCode, 5);
+  header.writeUInt8(fast ? 1 : 0, 6);
+  header.writeUInt8(caption ? caption.length : 0, 7);
+  header.writeUInt32LE(length, 8);
+  if (digest) {
+    digest.copy(header, 12, 0, 8);
+  }
+  header.writeUInt32LE(ESP32_NEXT_WAKE_SECONDS, 20);
+  return caption ? Buffer.concat([header, caption]) : header;
+}
+
+/**
+ * Serve one binary frame request: parse the fixed request, build the frame
+ * like /esp32/frame does and answer "unchanged" without a payload when its
+ * digest matches the one the device reports for the frame on its panel.
+ * That needs ESP32_IMAGE_HOLD_SECONDS: otherwise each request gets a random
+ * image and only repeats by chance.
+ */
+async function handleFrameRequest(socket, request) {
+  const start = Date.now();
+  const version = request.readUInt8(4);
+  if (!request.subarray(0, 4).equals(FRAME_PROTO_MAGIC) || version < 1 || version > 2) {
+    console.warn(`ESP32 TCP ${socket.remoteAddress}: bad request header`);
+    socket.end(encodeFrameResponse(FRAME_PROTO_STATUS.error));
+    return;
+  }
+
+  const panelId = TCP_PANELS[request.readUInt8(5)] || '7in3e';
+  const deviceId = request.subarray(6, 12).toString('hex');
+  const capabilities = request.readUInt16LE(12);
+  const preferred = FRAME_FORMATS[request.readUInt8(14)];
+  const temp = request.readInt8(15);
+  const lastDigest = request.subarray(16, 24);
+  const lastRefreshMs = request.readUInt32LE(24);
+  const rank = request.readUInt8(29);
+
+  if (temp !== -128) {
+    console.log(`ESP32 ${deviceId} panel temperature: ${temp} C`);
+  }
+  if (rank > 0) {
+    console.log(`ESP32 ${deviceId} reached this server as failover choice ${rank + 1}`);
+  }
+  if (lastRefreshMs > 0) {
+    console.log(`ESP32 ${deviceId} previous refresh: ${lastRefreshMs} ms (${request.readUInt8(28) ? 'fast' : 'normal'})`);
+  }
+
+  // Fall back to packed frames for anything the device cannot decode
+  const format = preferred && (capabilities & (1 << FRAME_FORMATS.indexOf(preferred))) ? preferred : 'packed4bpp';
+  const frame = await buildEsp32Frame(panelId, format, getDeviceImage(deviceId));
+  // Version 2 carries the X-Overlay-Text caption; it is part of the picture,
+  // so it goes into the digest too.
+  const caption = version >= 2
+    ? Buffer.from(resolveOverlayText().slice(0, FRAME_PROTO_CAPTION_MAX), 'latin1')
+    : Buffer.alloc(0);
+  const digest = crypto.createHash('sha1').update(frame.body).update(caption).digest();
+  const buildMs = Date.now() - start;
+
+  if (digest.subarray(0, 8).equals(lastDigest)) {
+    socket.end(encodeFrameResponse(FRAME_PROTO_STATUS.unchanged, { digest }));
+    console.log(`ESP32 ${deviceId} TCP frame unchanged (build ${buildMs} ms)`);
+    return;
+  }
+
+  const header = encodeFrameResponse(FRAME_PROTO_STATUS.frame, {
+    formatCode: FRAME_FORMATS.indexOf(format),
+    fast: ESP32_REFRESH_MODE === 'fast',
+    length: frame.body.length,
+    digest,
+    caption
+  });
+  socket.write(header);
+  socket.end(frame.body, () => {
+    console.log(`ESP32 ${deviceId} TCP ${format} frame: ${frame.body.length} bytes, build ${buildMs} ms, sent after ${Date.now() - start} ms`);
+  });
+}
+
+if (FRAME_TCP_PORT > 0) {
+  net.createServer((socket) => {
+    let request = Buffer.alloc(0);
+    socket.setNoDelay(true);
+    socket.setTimeout(30000, () => socket.destroy());
+    socket.on('error', (error) => console.warn(`ESP32 TCP ${socket.remoteAddress}: ${error.message}`));
+    socket.on('data', (chunk) => {
+      if (request.length >= FRAME_PROTO_REQUEST_SIZE) {
+        return;
+      }
+      request = Buffer.concat([request, chunk]);
+      if (request.length >= FRAME_PROTO_REQUEST_SIZE) {
+        handleFrameRequest(socket, request.subarray(0, FRAME_PROTO_REQUEST_SIZE)).catch((error) => {
+          console.error('Error processing TCP frame for ESP32:', error);
+          socket.end(encodeFrameResponse(FRAME_PROTO_STATUS.error));
+        });
+      }
+    });
+  }).listen(FRAME_TCP_PORT, () => {
+    console.log(`ESP32 binary frame protocol on TCP port ${FRAME_TCP_PORT}`);
+  });
+}
+
+if (TLS_CERT && TLS_KEY) {
+  const httpsServer = https.createServer({
+    cert: readFileSync(TLS_CERT),
+    key: readFileSync(TLS_KEY)
+  }, app);
+
+  // Handshake time and whether the client resumed a session (by ticket or
+  // ID), to compare against the full handshakes in the ESP32 log.
+  httpsServer.on('connection', (socket) => {
+    socket.tcpConnectedAt = Date.now();
+  });
+  httpsServer.on('secureConnection', (tlsSocket) => {
+    const started = tlsSocket._parent?.tcpConnectedAt ?? tlsSocket.tcpConnectedAt;
+    const ms = started ? Date.now() - started : -1;
+    console.log(`TLS ${tlsSocket.remoteAddress}: ${tlsSocket.isSessionReused() ? 'resumed' : 'full'} handshake in ${ms} ms (${tlsSocket.getProtocol()})`);
+  });
+  httpsServer.on('tlsClientError', (error, tlsSocket) => {
+    console.warn(`TLS ${tlsSocket.remoteAddress}: ${error.message}`);
+  });
+
+  httpsServer.listen(HTTPS_PORT, () => {
+    console.log(`HTTPS on port ${HTTPS_PORT}`);
+  });
+}
+
 app.listen(PORT, () => {
   const imageCount = getImageFiles().length;
   console.log(`E-Paper Optimizer Server running on port ${PORT}`);
@@ -1163,6 +1725,7 @@ app.listen(PORT, () => {
   console.log(`  GET http://localhost:${PORT}/png - Get random optimized PNG image`);
   console.log(`  GET http://localhost:${PORT}/esp32/image - Get random optimized ESP32 BMP`);
   console.log(`  GET http://localhost:${PORT}/esp32/frame - Get random optimized ESP32 frame`);
+  console.log(`  GET http://localhost:${PORT}/esp32/telemetry - Latest ESP32 logs per device`);
   console.log(`  GET http://localhost:${PORT}/upload - Manage images`);
   console.log(`  GET http://localhost:${PORT}/health - Health check`);
 });
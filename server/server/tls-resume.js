@@ -0,0 +1,118 @@
+/**
+ * Compare a full TLS handshake with a resumed one against the server's HTTPS
+ * listener (TLS_CERT/TLS_KEY), the way the ESP32 reconnects on each wake: a
+ * new connection with no session, then one offering the session it got.
+ *
+ *   node tls-resume.js [host] [runs] [TLSv1.2|TLSv1.3]
+ *
+ * Reports the median TCP connect time and the median time from TCP connect
+ * to the end of the handshake, which the server logs too ("full"/"resumed
+ * handshake in ... ms"). The certificate is not checked: this measures the
+ * handshake, it does not authenticate the server. TLSv1.2 (the default) is
+ * what the ESP32's mbedTLS client negotiates.
+ */
+
+import net from 'net';
+import tls from 'tls';
+
+const HOST = process.argv[2] || 'localhost';
+const RUNS = parseInt(process.argv[3], 10) || 10;
+const VERSION = process.argv[4] || 'TLSv1.2';
+const HTTPS_PORT = parseInt(process.env.HTTPS_PORT, 10) || 3443;
+
+// TLS 1.3 tickets arrive after the handshake; wait this long for one
+const SESSION_WAIT_MS = 1000;
+
+function handshake(session) {
+  return new Promise((resolve, reject) => {
+    const start = process.hrtime.bigint();
+    let connectedAt = 0n;
+    let result = null;
+    let ticket = null;
+    let timer = null;
+
+    const finish = () => {
+      clearTimeout(timer);
+      socket.end();
+      resolve({ ...result, session: ticket });
+    };
+
+    const socket = tls.connect({
+      host: HOST,
+      port: HTTPS_PORT,
+      servername: net.isIP(HOST) ? undefined : HOST,
+      session,
+      minVersion: VERSION,
+      maxVersion: VERSION,
+      rejectUnauthorized: false
+    }, () => {
+      const now = process.hrtime.bigint();
+      result = {
+        tcpMs: Number(connectedAt - start) / 1e6,
+        handshakeMs: Number(now - connectedAt) / 1e6,
+        resumed: socket.isSessionReused(),
+        protocol: socket.getProtocol()
+      };
+      if (ticket) {
+        finish();
+      } else {
+        timer = setTimeout(finish, SESSION_WAIT_MS);
+      }
+    });
+    socket.once('connect', () => { connectedAt = process.hrtime.bigint(); });
+    socket.on('session', (s) => {
+      ticket = s;
+      if (result) {
+        finish();
+      }
+    });
+    socket.on('error', reject);
+  });
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function report(name, results) {
+  const tcp = median(results.map((r) => r.tcpMs)).toFixed(1);
+  const hs = median(results.map((r) => r.handshakeMs)).toFixed(1);
+  console.log(`${name.padEnd(18)} tcp ${tcp.padStart(7)} ms   handshake ${hs.padStart(7)} ms   (${results.length} runs)`);
+}
+
+async function main() {
+  if (VERSION !== 'TLSv1.2' && VERSION !== 'TLSv1.3') {
+    throw new Error('version must be TLSv1.2 or TLSv1.3');
+  }
+  const full = [];
+  const resumed = [];
+  let notResumed = 0;
+  for (let i = 0; i < RUNS; i++) {
+    const first = await handshake(undefined);
+    full.push(first);
+    if (!first.session) {
+      throw new Error('the server sent no session to resume');
+    }
+    const again = await handshake(first.session);
+    if (again.resumed) {
+      resumed.push(again);
+    } else {
+      notResumed++;
+    }
+  }
+
+  console.log(`${RUNS} runs against ${HOST}:${HTTPS_PORT}, ${full[0].protocol} (medians):`);
+  report('full handshake', full);
+  if (resumed.length > 0) {
+    report('resumed handshake', resumed);
+  }
+  if (notResumed > 0) {
+    console.log(`resumed handshake  refused ${notResumed} of ${RUNS} times: the server did a full handshake instead`);
+  }
+}
+
+main().catch((error) => {
+  console.error(`tls-resume: ${error.message}`);
+  process.exit(1);
+});